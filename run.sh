@@ -6,6 +6,7 @@ BUILD_TYPE="Debug"
 
 # Parse command line arguments
 REBUILD=0
+APP_ARGS=()
 for arg in "$@"; do
   case $arg in
     --rebuild)
@@ -21,7 +22,8 @@ for arg in "$@"; do
       shift
       ;;
     *)
-      # Unknown option
+      # Unknown options are forwarded to the engine (e.g. --headless)
+      APP_ARGS+=("$arg")
       ;;
   esac
 done
@@ -49,7 +51,7 @@ cd "$BUILD_DIR/bin"
 # Check if the binary exists
 if [ -f "PrismMain" ]; then
   echo "[INFO] Running Prism Engine ($BUILD_TYPE)..."
-  ./PrismMain
+  ./PrismMain "${APP_ARGS[@]}"
 else
   echo "[ERROR] PrismMain executable not found in $BUILD_DIR/bin. Please check build errors."
   exit 1
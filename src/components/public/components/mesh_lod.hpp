@@ -0,0 +1,10 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Prism::Components {
+    // Level of detail the mesh was last drawn with, selection keeps it until the projected error leaves the hysteresis band.
+    struct MeshLod {
+        uint32_t level = 0;
+    };
+} // namespace Prism::Components
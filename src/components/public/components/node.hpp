@@ -0,0 +1,13 @@
+#pragma once
+
+#include <entt/entt.hpp>
+
+#include <string>
+
+namespace Prism::Components {
+    // Entity of a scene hierarchy, e.g. a node of an imported model.
+    struct Node {
+        std::string name;
+        entt::entity parent = entt::null;
+    };
+} // namespace Prism::Components
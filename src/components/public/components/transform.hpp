@@ -3,7 +3,14 @@
 #include <glm/glm.hpp>
 
 namespace Prism::Components {
+    // Relative to the parent of Components::Node, or to the world for entities without one. Transforms edited in place have to be
+    // announced with registry.patch<Components::Transform>(entity), so TransformSystem propagates them.
     struct Transform {
         glm::mat4 transform = glm::mat4(1.0f);
     };
-}; // namespace Prism::Components
\ No newline at end of file
+
+    // Written by TransformSystem, read by everything that draws or queries the scene.
+    struct WorldTransform {
+        glm::mat4 transform = glm::mat4(1.0f);
+    };
+}; // namespace Prism::Components
@@ -1,7 +1,7 @@
 #include "context/context.hpp"
 
+#include "loaders/async_mesh_loader.hpp"
 #include "loaders/imgui_loader.hpp"
-#include "loaders/mesh_loader.hpp"
 #include "loaders/vulkan_loader.hpp"
 #include "loaders/window_loader.hpp"
 
@@ -17,24 +17,156 @@
 
 #include "resources/context_resources.hpp"
 #include "resources/scene.hpp"
+#include "resources/vulkan/vk_staging_buffer_resource.hpp"
 
+#include "utils/profiler.hpp"
 
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
 #include <format>
 #include <iostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 namespace Prism::Context {
     namespace {
         struct FPSCounter {
             size_t frames = 0;
-            double lastTime = glfwGetTime();
+            double lastTime = 0.0;
+        };
+
+        // Fixed simulation step in headless mode, so every run animates the scene the same way.
+        constexpr float HEADLESS_DELTA_TIME = 1.0f / 60.0f;
+
+        struct FrameTimeStats {
+            struct GpuZoneTotals {
+                double gpuTimeMs = 0.0;
+                uint64_t vertexShaderInvocations = 0;
+                size_t frameCount = 0;
+                size_t pipelineStatisticsFrameCount = 0;
+            };
+
+            std::vector<double> frameTimesMs;
+
+            // From the start of a frame on the CPU until its completion on the GPU is noticed, which happens once per frame -
+            // an upper bound, precise to about a frame time.
+            std::vector<double> frameLatenciesMs;
+            std::deque<std::pair<uint64_t, std::chrono::steady_clock::time_point>> pendingFrames;
+
+            // Keyed by zone name, in order of first appearance.
+            std::vector<std::pair<std::string, GpuZoneTotals>> gpuZones;
+
+            VkDeviceSize uploadedBytes = 0;
+            VkDeviceSize maxFrameUploadedBytes = 0;
+            double stallTimeMs = 0.0;
+            double maxFrameStallTimeMs = 0.0;
+
+            void Record(std::chrono::steady_clock::duration frameTime) {
+                frameTimesMs.push_back(std::chrono::duration<double, std::milli>(frameTime).count());
+            }
+
+            void RecordSubmitted(uint64_t frameNumber, std::chrono::steady_clock::time_point frameStart) {
+                pendingFrames.emplace_back(frameNumber, frameStart);
+            }
+
+            void RecordCompleted(uint64_t completedFrameNumber) {
+                auto now = std::chrono::steady_clock::now();
+                while (!pendingFrames.empty() && pendingFrames.front().first <= completedFrameNumber) {
+                    frameLatenciesMs.push_back(std::chrono::duration<double, std::milli>(now - pendingFrames.front().second).count());
+                    pendingFrames.pop_front();
+                }
+            }
+
+            void RecordGpu(const std::vector<Resources::GpuProfilerResource::ZoneResult> &zoneResults) {
+                for (const auto &zoneResult : zoneResults) {
+                    auto zone = std::find_if(gpuZones.begin(), gpuZones.end(), [&](const auto &entry) { return entry.first == zoneResult.name; });
+                    if (zone == gpuZones.end()) {
+                        zone = gpuZones.insert(gpuZones.end(), {zoneResult.name, {}});
+                    }
+
+                    auto &totals = zone->second;
+                    totals.gpuTimeMs += zoneResult.gpuTimeMs;
+                    totals.frameCount++;
+                    if (zoneResult.hasPipelineStatistics) {
+                        totals.vertexShaderInvocations += zoneResult.pipelineStatistics.vertexShaderInvocations;
+                        totals.pipelineStatisticsFrameCount++;
+                    }
+                }
+            }
+
+            void RecordStaging(const Resources::VkStagingBufferResource::FrameStats &stagingStats) {
+                uploadedBytes += stagingStats.uploadedBytes;
+                maxFrameUploadedBytes = std::max(maxFrameUploadedBytes, stagingStats.uploadedBytes);
+                stallTimeMs += stagingStats.stallTimeMs;
+                maxFrameStallTimeMs = std::max(maxFrameStallTimeMs, stagingStats.stallTimeMs);
+            }
+
+            void PrintSummary(const ContextSettings &settings) const {
+                if (frameTimesMs.empty()) {
+                    std::cout << "[HEADLESS] No frames were rendered." << std::endl;
+                    return;
+                }
+
+                auto sorted = frameTimesMs;
+                std::sort(sorted.begin(), sorted.end());
+
+                auto percentile = [](const std::vector<double> &values, double p) {
+                    auto index = static_cast<size_t>(p * static_cast<double>(values.size() - 1));
+                    return values[index];
+                };
+
+                double totalMs = 0.0;
+                for (auto frameTimeMs : sorted) {
+                    totalMs += frameTimeMs;
+                }
+                double averageMs = totalMs / static_cast<double>(sorted.size());
+
+                std::cout << "[HEADLESS] Timing summary" << std::endl;
+                std::cout << std::format("[HEADLESS] resolution: {}x{}", settings.headlessWidth, settings.headlessHeight) << std::endl;
+                std::cout << std::format("[HEADLESS] frames in flight: {}", settings.framesInFlight) << std::endl;
+                std::cout << std::format("[HEADLESS] frames: {}", sorted.size()) << std::endl;
+                std::cout << std::format("[HEADLESS] total: {:.3f} ms", totalMs) << std::endl;
+                std::cout << std::format("[HEADLESS] average: {:.3f} ms ({:.1f} FPS)", averageMs, 1000.0 / averageMs) << std::endl;
+                std::cout << std::format("[HEADLESS] min: {:.3f} ms, max: {:.3f} ms", sorted.front(), sorted.back()) << std::endl;
+                std::cout << std::format("[HEADLESS] p50: {:.3f} ms, p95: {:.3f} ms, p99: {:.3f} ms", percentile(sorted, 0.50), percentile(sorted, 0.95),
+                                         percentile(sorted, 0.99))
+                          << std::endl;
+
+                if (!frameLatenciesMs.empty()) {
+                    auto sortedLatencies = frameLatenciesMs;
+                    std::sort(sortedLatencies.begin(), sortedLatencies.end());
+                    std::cout << std::format("[HEADLESS] latency p50: {:.3f} ms, p95: {:.3f} ms, p99: {:.3f} ms", percentile(sortedLatencies, 0.50),
+                                             percentile(sortedLatencies, 0.95), percentile(sortedLatencies, 0.99))
+                              << std::endl;
+                }
+
+                constexpr double BYTES_PER_MIB = 1024.0 * 1024.0;
+                std::cout << std::format("[HEADLESS] staging: {:.3f} MiB uploaded, max {:.3f} MiB per frame, stalled {:.3f} ms, max {:.3f} ms per frame",
+                                         static_cast<double>(uploadedBytes) / BYTES_PER_MIB, static_cast<double>(maxFrameUploadedBytes) / BYTES_PER_MIB,
+                                         stallTimeMs, maxFrameStallTimeMs)
+                          << std::endl;
+
+                for (const auto &[name, totals] : gpuZones) {
+                    std::string line = std::format("[HEADLESS] GPU {}: {:.3f} ms", name, totals.gpuTimeMs / static_cast<double>(totals.frameCount));
+                    if (totals.pipelineStatisticsFrameCount > 0) {
+                        line += std::format(", {} vertex shader invocations",
+                                            totals.vertexShaderInvocations / static_cast<uint64_t>(totals.pipelineStatisticsFrameCount));
+                    }
+                    std::cout << line << std::endl;
+                }
+            }
         };
 
-        Resources::ContextResources createContextResources() {
+        Resources::ContextResources createContextResources(const ContextSettings &settings) {
             Loaders::WindowLoader windowLoader;
-            auto windowResource = windowLoader();
+            auto windowResource = settings.headless ? windowLoader(true, settings.headlessWidth, settings.headlessHeight) : windowLoader();
 
             Loaders::VulkanLoader vulkanLoader;
-            auto vulkanResource = vulkanLoader(windowResource);
+            auto vulkanResource = vulkanLoader(windowResource, settings.framesInFlight);
 
             if (!vulkanResource) {
                 throw std::runtime_error("Couldn't load Vulkan!");
@@ -51,7 +183,7 @@ namespace Prism::Context {
         }
     } // namespace
 
-    Context::Context() : m_contextResources{createContextResources()} {
+    Context::Context(ContextSettings settings) : m_settings{settings}, m_contextResources{createContextResources(settings)} {
         m_windowCloseEventConnection = m_contextResources.GetDispatcher().sink<Events::WindowCloseEvent>().connect<&Context::onWindowClose>(this);
     }
 
@@ -62,26 +194,29 @@ namespace Prism::Context {
 
         Systems::WindowResizeSystem windowResizeSystem{m_contextResources};
 
-        Managers::SceneDrawSystemsManager sceneDrawSystemsManager{m_contextResources};
+        Managers::SceneDrawSystemsManager sceneDrawSystemsManager{m_contextResources, m_settings.perVertexNormalMatrix};
 
         Managers::SceneUpdateSystemsManager sceneUpdateSystemsManager{m_contextResources};
 
         Resources::Scene scene{};
 
-        Loaders::MeshLoader meshLoader{};
+        auto &vulkanResource = m_contextResources.GetVulkanResource();
+        Resources::VkStagingBufferResource stagingBuffer{vulkanResource.GetVmaAllocator(), vulkanResource.GetDevice(),
+                                                         vulkanResource.GetFrameTimelineSemaphore()};
 
-        Resources::VkStagingBufferResource stagingBuffer{m_contextResources.GetVulkanResource().GetVmaAllocator()};
+        auto &geometryPool = m_contextResources.GetGeometryPoolResource();
 
-        auto backpackModelOpt = meshLoader(m_contextResources.GetVulkanResource(), stagingBuffer, "backpack.obj");
-        if (!backpackModelOpt) {
-            std::cerr << "Couldn't load backpack model!" << std::endl;
-        } else {
-            auto &backpackModel = *backpackModelOpt;
-            auto backpackId = std::hash<const char *>{}("MeshResources/Backpack");
-            scene.AddNewMesh(backpackId, "Backpack", std::move(backpackModel));
+        Loaders::AsyncMeshLoader meshLoader{Loaders::MeshLoader::Settings{
+            .optimize = m_settings.optimizeMeshes, .vertexFormat = m_settings.meshVertexFormat, .useCache = m_settings.useMeshCache}};
+        meshLoader.Initialize(scene, geometryPool, stagingBuffer);
 
-            std::cout << "Loaded backpack model!" << std::endl;
-        }
+        meshLoader.Load(scene, "Backpack", "backpack.obj", [](Resources::Scene &, entt::entity entity) {
+            if (entity == entt::null) {
+                std::cerr << "Couldn't load backpack model!" << std::endl;
+            } else {
+                std::cout << "Loaded backpack model!" << std::endl;
+            }
+        });
 
         // auto cubeModelOpt = meshLoader("cube.obj");
         // if (!cubeModelOpt) {
@@ -100,18 +235,42 @@ namespace Prism::Context {
 
         sceneDrawSystemsManager.Initialize();
 
+        PRISM_PROFILE_THREAD_NAME("Main");
+        if (!m_settings.cpuTraceOutputPath.empty()) {
+            Utils::Profiler::BeginCapture();
+        }
+
         float deltaTime = 0.0f;
-        float lastFrameTime = 0.0f;
+        float lastFrameTime = m_settings.headless ? 0.0f : glfwGetTime();
+
+        FPSCounter fpsCounter{.lastTime = lastFrameTime};
+
+        FrameTimeStats headlessFrameStats{};
+        headlessFrameStats.frameTimesMs.reserve(m_settings.headlessFrameCount);
+
+        // Benchmarks measure the loaded scene, not the placeholders. Models larger than the staging budget still show up a few frames in.
+        if (m_settings.headless) {
+            while (meshLoader.GetPendingCount() > 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                meshLoader.Update(scene, geometryPool, stagingBuffer);
+            }
+        }
 
-        FPSCounter fpsCounter{};
+        // Vertex shader invocations show up in the headless summary, next to GPU times of every zone.
+        if (m_settings.headless) {
+            m_contextResources.GetGpuProfilerResource().SetPipelineStatisticsEnabled(true);
+        }
 
         // Scope for cleanup
         {
             auto &windowResource = m_contextResources.GetWindowResource();
-            auto &vulkanResource = m_contextResources.GetVulkanResource();
 
             while (m_isRunning) {
-                float currentTime = glfwGetTime();
+                PRISM_PROFILE_SCOPE("Frame");
+
+                auto frameStart = std::chrono::steady_clock::now();
+
+                float currentTime = m_settings.headless ? lastFrameTime + HEADLESS_DELTA_TIME : glfwGetTime();
                 deltaTime = currentTime - lastFrameTime;
                 lastFrameTime = currentTime;
 
@@ -121,10 +280,29 @@ namespace Prism::Context {
 
                 windowResizeSystem.Update(deltaTime);
 
+                // Models are added before update systems, so transforms of their nodes are computed the same frame.
+                meshLoader.Update(scene, geometryPool, stagingBuffer);
+
+                // Transient uniforms of this frame can be allocated by both update & draw systems.
+                m_contextResources.GetUniformRingResource().BeginFrame();
+
                 sceneUpdateSystemsManager.Update(deltaTime, scene);
 
                 sceneDrawSystemsManager.Update(deltaTime, scene, stagingBuffer);
 
+                if (m_settings.headless) {
+                    headlessFrameStats.RecordSubmitted(vulkanResource.GetFrameNumber(), frameStart);
+                    headlessFrameStats.RecordCompleted(vulkanResource.GetCompletedFrameNumber());
+                    headlessFrameStats.Record(std::chrono::steady_clock::now() - frameStart);
+                    headlessFrameStats.RecordGpu(m_contextResources.GetGpuProfilerResource().GetLastResults());
+                    headlessFrameStats.RecordStaging(stagingBuffer.GetLastFrameStats());
+
+                    if (headlessFrameStats.frameTimesMs.size() >= m_settings.headlessFrameCount) {
+                        m_isRunning = false;
+                    }
+                    continue;
+                }
+
                 // Display FPS counter every second
                 fpsCounter.frames++;
                 if (currentTime - fpsCounter.lastTime >= 1.0) {
@@ -137,6 +315,23 @@ namespace Prism::Context {
 
             vkDeviceWaitIdle(m_contextResources.GetVulkanResource().GetDevice());
         }
+
+        if (m_settings.headless) {
+            headlessFrameStats.PrintSummary(m_settings);
+        }
+
+        if (!m_settings.cpuTraceOutputPath.empty()) {
+            Utils::Profiler::EndCapture();
+            if (Utils::Profiler::WriteChromeTrace(m_settings.cpuTraceOutputPath)) {
+                std::cout << "CPU trace written to " << m_settings.cpuTraceOutputPath << std::endl;
+                // Trace still opens, but is missing the zones past the buffer of a thread.
+                if (auto droppedEventCount = Utils::Profiler::GetDroppedEventCount(); droppedEventCount > 0) {
+                    std::cerr << std::format("CPU trace is missing {} zones, per thread buffers were full", droppedEventCount) << std::endl;
+                }
+            } else {
+                std::cerr << "Couldn't write CPU trace to " << m_settings.cpuTraceOutputPath << std::endl;
+            }
+        }
     }
 
     void Context::onWindowClose(Events::WindowCloseEvent &event) { m_isRunning = false; }
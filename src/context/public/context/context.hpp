@@ -6,11 +6,41 @@
 
 #include <entt/entt.hpp>
 
+#include <string>
+
 #include "events/app_events.hpp"
 
 namespace Prism::Context {
+    struct ContextSettings {
+        // Headless mode renders into offscreen render targets only - no GLFW window, no surface and no swapchain.
+        bool headless = false;
+
+        // Used only in headless mode, engine exits after rendering that many frames.
+        uint32_t headlessFrameCount = 1000;
+        uint32_t headlessWidth = 1280;
+        uint32_t headlessHeight = 720;
+
+        // Frames the CPU can record ahead of the GPU, 1 to 4. More frames keep the GPU busier at the cost of input latency.
+        uint32_t framesInFlight = Resources::VulkanResource::DEFAULT_FRAMES_IN_FLIGHT;
+
+        // When not empty, CPU profiler captures the whole run and writes Chrome trace into this file on exit.
+        std::string cpuTraceOutputPath;
+
+        // Loaded meshes are reordered for vertex cache, overdraw and vertex fetch. Disable to compare against the source order.
+        bool optimizeMeshes = true;
+
+        // Processed meshes are cached next to the models, so later runs skip assimp. Disable to always import from the source.
+        bool useMeshCache = true;
+
+        // Layout loaded meshes are stored in, see MeshResource::VertexFormat.
+        Resources::MeshResource::VertexFormat meshVertexFormat = Resources::MeshResource::VertexFormat::Float;
+
+        // Normal matrices are inverted per vertex in basic.vert instead of once per instance on the CPU, only to compare GPU times.
+        bool perVertexNormalMatrix = false;
+    };
+
     struct Context {
-        Context();
+        Context(ContextSettings settings = {});
         ~Context() = default;
 
         Context(Context &&other) = delete;
@@ -24,6 +54,8 @@ namespace Prism::Context {
       private:
         void onWindowClose(Events::WindowCloseEvent &event);
 
+        ContextSettings m_settings;
+
         Resources::ContextResources m_contextResources;
 
         bool m_isRunning = true;
@@ -31,4 +63,4 @@ namespace Prism::Context {
 
         entt::registry m_registry;
     };
-}; // namespace Prism::Context
\ No newline at end of file
+}; // namespace Prism::Context
@@ -0,0 +1,206 @@
+#include "loaders/async_mesh_loader.hpp"
+
+#include "components/mesh.hpp"
+#include "components/node.hpp"
+#include "components/transform.hpp"
+
+#include "utils/profiler.hpp"
+
+#include <algorithm>
+#include <array>
+#include <format>
+#include <iostream>
+#include <stdexcept>
+
+namespace Prism::Loaders {
+    namespace {
+        const Resources::MeshResource::ID PLACEHOLDER_MESH_ID = std::hash<std::string>{}("MeshResources/Placeholder");
+
+        constexpr float PLACEHOLDER_HALF_EXTENT = 0.5f;
+
+        // Leaves a core for the thread recording frames.
+        uint32_t getWorkerCount() {
+            return std::clamp(std::thread::hardware_concurrency(), 2u, AsyncMeshLoader::MAX_WORKER_COUNT + 1) - 1;
+        }
+
+        // Box with flat shaded faces, drawn in place of models that are still loading.
+        std::unique_ptr<Resources::MeshResource> createPlaceholderMesh(Resources::GeometryPoolResource &geometryPool,
+                                                                       Resources::VkStagingBufferResource &stagingBuffer) {
+            constexpr std::array<glm::vec3, 6> FACE_NORMALS = {glm::vec3(1, 0, 0), glm::vec3(-1, 0, 0), glm::vec3(0, 1, 0),
+                                                               glm::vec3(0, -1, 0), glm::vec3(0, 0, 1),  glm::vec3(0, 0, -1)};
+
+            std::vector<Resources::MeshResource::Vertex> vertices;
+            std::vector<Resources::MeshResource::Index> indices;
+
+            for (const auto &normal : FACE_NORMALS) {
+                // Two axes spanning the face, in counter-clockwise order seen from outside.
+                glm::vec3 tangent = glm::vec3(normal.y != 0.0f ? 1.0f : 0.0f, normal.y != 0.0f ? 0.0f : 1.0f, 0.0f);
+                glm::vec3 bitangent = glm::cross(normal, tangent);
+
+                const auto firstVertex = static_cast<uint32_t>(vertices.size());
+                for (auto [u, v] : {std::pair(-1.0f, -1.0f), std::pair(1.0f, -1.0f), std::pair(1.0f, 1.0f), std::pair(-1.0f, 1.0f)}) {
+                    glm::vec3 position = (normal + tangent * u + bitangent * v) * PLACEHOLDER_HALF_EXTENT;
+                    vertices.push_back({.position = position, .normal = normal, .textureUV = glm::vec2(u, v) * 0.5f + 0.5f});
+                }
+
+                for (uint32_t index : {0u, 1u, 2u, 0u, 2u, 3u}) {
+                    indices.push_back({firstVertex + index});
+                }
+            }
+
+            auto geometryRange = geometryPool.Allocate(stagingBuffer, vertices, indices);
+            if (!geometryRange) {
+                throw std::runtime_error("Geometry pool is out of space, couldn't create placeholder mesh!");
+            }
+
+            Resources::MeshResource::BoundingBox boundingBox{.min = glm::vec3(-PLACEHOLDER_HALF_EXTENT), .max = glm::vec3(PLACEHOLDER_HALF_EXTENT)};
+            Resources::MeshResource::BoundingSphere boundingSphere{.center = glm::vec3(0.0f), .radius = glm::length(boundingBox.max)};
+
+            Resources::MeshResource::Submesh submesh{};
+            submesh.vertexCount = static_cast<uint32_t>(vertices.size());
+            submesh.lods = {{.firstIndex = 0, .indexCount = static_cast<uint32_t>(indices.size()), .error = 0.0f}};
+            submesh.boundingBox = boundingBox;
+            submesh.boundingSphere = boundingSphere;
+
+            return std::make_unique<Resources::MeshResource>(geometryPool, *geometryRange, std::vector{std::move(submesh)}, boundingBox, boundingSphere,
+                                                             Resources::MeshResource::VertexDequantization{});
+        }
+    } // namespace
+
+    AsyncMeshLoader::AsyncMeshLoader(MeshLoader::Settings settings) : m_meshLoader(settings) {
+        const uint32_t workerCount = getWorkerCount();
+        m_workers.reserve(workerCount);
+        for (uint32_t i = 0; i < workerCount; i++) {
+            m_workers.emplace_back(&AsyncMeshLoader::workerLoop, this);
+        }
+    }
+
+    AsyncMeshLoader::~AsyncMeshLoader() {
+        {
+            std::lock_guard lock(m_jobsMutex);
+            m_stopping = true;
+            m_jobs.clear();
+        }
+        m_jobsCondition.notify_all();
+
+        for (auto &worker : m_workers) {
+            worker.join();
+        }
+    }
+
+    void AsyncMeshLoader::Initialize(Resources::Scene &scene, Resources::GeometryPoolResource &geometryPool,
+                                     Resources::VkStagingBufferResource &stagingBuffer) {
+        if (!scene.GetMesh(PLACEHOLDER_MESH_ID)) {
+            scene.AddMeshResource(PLACEHOLDER_MESH_ID, createPlaceholderMesh(geometryPool, stagingBuffer));
+        }
+    }
+
+    entt::entity AsyncMeshLoader::Load(Resources::Scene &scene, const std::string &name, const std::string &path, Callback callback,
+                                       std::optional<Resources::MeshResource::VertexFormat> vertexFormat) {
+        auto &registry = scene.GetRegistry();
+
+        auto entity = registry.create();
+        registry.emplace<Components::Node>(entity, name);
+        registry.emplace<Components::Transform>(entity);
+        registry.emplace<Components::WorldTransform>(entity);
+        registry.emplace<Components::Mesh>(entity, PLACEHOLDER_MESH_ID, "Placeholder");
+
+        const uint64_t jobId = m_nextJobId++;
+        m_pendingLoads.emplace(jobId, PendingLoad{.name = name, .path = path, .entity = entity, .callback = std::move(callback)});
+
+        {
+            std::lock_guard lock(m_jobsMutex);
+            m_jobs.push_back({jobId, path, vertexFormat});
+        }
+        m_jobsCondition.notify_one();
+
+        return entity;
+    }
+
+    void AsyncMeshLoader::Update(Resources::Scene &scene, Resources::GeometryPoolResource &geometryPool,
+                                 Resources::VkStagingBufferResource &stagingBuffer) {
+        PRISM_PROFILE_SCOPE("AsyncMeshLoader::Update");
+
+        if (m_processedJobs.IsEmpty() && m_stagingLoads.empty()) {
+            return;
+        }
+
+        auto &registry = scene.GetRegistry();
+
+        for (auto &processedJob : m_processedJobs.PopAll()) {
+            auto pendingIt = m_pendingLoads.find(processedJob.id);
+            auto pendingLoad = std::move(pendingIt->second);
+            m_pendingLoads.erase(pendingIt);
+
+            // Placeholder was deleted in the meantime, nobody is waiting for the model anymore.
+            if (!registry.valid(pendingLoad.entity)) {
+                continue;
+            }
+
+            std::optional<Resources::ModelResource> model;
+            if (processedJob.model) {
+                model = m_meshLoader.Upload(*processedJob.model, geometryPool, stagingBuffer, pendingLoad.path);
+            }
+
+            if (!model) {
+                std::cerr << std::format("Couldn't load {} from {}", pendingLoad.name, pendingLoad.path) << std::endl;
+                registry.destroy(pendingLoad.entity);
+
+                if (pendingLoad.callback) {
+                    pendingLoad.callback(scene, entt::null);
+                }
+                continue;
+            }
+
+            m_stagingLoads.push_back({.load = std::move(pendingLoad), .model = std::move(*model), .lastCopyId = stagingBuffer.GetLastCopyId()});
+        }
+
+        // Drawing the model before all of its geometry is copied would read whatever the ranges held before.
+        while (!m_stagingLoads.empty() && stagingBuffer.IsStaged(m_stagingLoads.front().lastCopyId)) {
+            auto stagingLoad = std::move(m_stagingLoads.front());
+            m_stagingLoads.pop_front();
+
+            // Geometry of a model nobody waits for anymore is released with it.
+            if (registry.valid(stagingLoad.load.entity)) {
+                addModel(scene, stagingLoad.load, std::move(stagingLoad.model));
+            }
+        }
+    }
+
+    void AsyncMeshLoader::addModel(Resources::Scene &scene, PendingLoad &pendingLoad, Resources::ModelResource &&model) {
+        scene.GetRegistry().remove<Components::Mesh>(pendingLoad.entity);
+        scene.AddModel(pendingLoad.name, std::move(model), pendingLoad.entity);
+
+        if (pendingLoad.callback) {
+            pendingLoad.callback(scene, pendingLoad.entity);
+        }
+    }
+
+    void AsyncMeshLoader::workerLoop() {
+        PRISM_PROFILE_THREAD_NAME("MeshLoader");
+
+        while (true) {
+            Job job;
+            {
+                std::unique_lock lock(m_jobsMutex);
+                m_jobsCondition.wait(lock, [this]() { return m_stopping || !m_jobs.empty(); });
+                if (m_stopping) {
+                    return;
+                }
+
+                job = std::move(m_jobs.front());
+                m_jobs.pop_front();
+            }
+
+            // Failures come back as well, so the placeholder is removed on the main thread.
+            ProcessedJob processedJob{.id = job.id};
+            try {
+                processedJob.model = m_meshLoader.Process(job.path, job.vertexFormat);
+            } catch (const std::exception &exception) {
+                std::cerr << std::format("Couldn't process {}: {}", job.path, exception.what()) << std::endl;
+            }
+
+            m_processedJobs.Push(std::move(processedJob));
+        }
+    }
+} // namespace Prism::Loaders
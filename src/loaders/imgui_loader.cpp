@@ -73,11 +73,22 @@ namespace Prism::Loaders {
         IMGUI_CHECKVERSION();
         ImGui::CreateContext();
         ImGuiIO &io = ImGui::GetIO();
-        io.ConfigFlags = ImGuiConfigFlags_DockingEnable | ImGuiConfigFlags_ViewportsEnable;
+        const bool hasPlatformBackend = !windowResource.IsHeadless();
+
+        io.ConfigFlags = ImGuiConfigFlags_DockingEnable;
+        if (hasPlatformBackend) {
+            io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable;
+        }
 
         ImGui::StyleColorsDark();
 
-        ImGui_ImplGlfw_InitForVulkan(windowResource.GetWindow(), true);
+        if (hasPlatformBackend) {
+            ImGui_ImplGlfw_InitForVulkan(windowResource.GetWindow(), true);
+        } else {
+            // Without platform backend display size has to be provided manually.
+            auto [width, height] = windowResource.GetWindowExtent();
+            io.DisplaySize = ImVec2(static_cast<float>(width), static_cast<float>(height));
+        }
 
         auto descriptorPool = createImGuiDescriptorPool(vulkanResource);
         auto renderPass = createImGuiRenderPass(vulkanResource);
@@ -95,6 +106,6 @@ namespace Prism::Loaders {
 
         ImGui_ImplVulkan_Init(&initInfo);
 
-        return Resources::ImGuiResource(vulkanResource.GetDevice(), descriptorPool, renderPass);
+        return Resources::ImGuiResource(vulkanResource.GetDevice(), descriptorPool, renderPass, hasPlatformBackend);
     }
 }; // namespace Prism::Loaders
\ No newline at end of file
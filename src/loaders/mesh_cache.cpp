@@ -0,0 +1,359 @@
+#include "loaders/mesh_cache.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <thread>
+#include <type_traits>
+
+namespace Prism::Loaders {
+    namespace {
+        using MeshResource = Resources::MeshResource;
+
+        // "PMSH" when read as bytes on a little endian machine.
+        constexpr uint32_t MAGIC = 0x48534d50;
+
+        // Vertex & index arrays start at this alignment, the mapping itself is page aligned.
+        constexpr size_t ARRAY_ALIGNMENT = 16;
+
+        constexpr uint64_t FNV_PRIME = 0x100000001b3ull;
+
+        struct FileHeader {
+            uint32_t magic = MAGIC;
+            uint32_t version = MeshCache::VERSION;
+            uint64_t key = 0;
+            uint32_t nodeCount = 0;
+            uint32_t meshCount = 0;
+        };
+
+        // Followed by nameLength characters of the name.
+        struct NodeHeader {
+            glm::mat4 transform = glm::mat4(1.0f);
+            uint32_t parent = 0;
+            uint32_t mesh = 0;
+            uint32_t nameLength = 0;
+        };
+
+        // Followed by submeshCount submeshes, then by the vertex & index arrays.
+        struct MeshHeader {
+            MeshResource::VertexFormat vertexFormat = MeshResource::VertexFormat::Float;
+            uint32_t vertexCount = 0;
+            uint32_t indexCount = 0;
+            uint32_t submeshCount = 0;
+            MeshResource::BoundingBox boundingBox = {};
+            MeshResource::BoundingSphere boundingSphere = {};
+            MeshResource::VertexDequantization vertexDequantization = {};
+        };
+
+        // Followed by lodCount levels.
+        struct SubmeshHeader {
+            uint32_t vertexOffset = 0;
+            uint32_t vertexCount = 0;
+            uint32_t materialIndex = 0;
+            uint32_t lodCount = 0;
+            MeshResource::BoundingBox boundingBox = {};
+            MeshResource::BoundingSphere boundingSphere = {};
+        };
+
+        static_assert(std::is_trivially_copyable_v<NodeHeader> && std::is_trivially_copyable_v<MeshHeader> &&
+                      std::is_trivially_copyable_v<SubmeshHeader> && std::is_trivially_copyable_v<MeshResource::Lod> &&
+                      std::is_trivially_copyable_v<MeshResource::Index>);
+
+        // Bounds checked cursor over the mapped file, every read fails once the file turns out to be too short.
+        struct Reader {
+            std::span<const std::byte> data;
+            size_t offset = 0;
+
+            template <typename T> bool Read(T &value) {
+                if (sizeof(T) > data.size() - offset) {
+                    return false;
+                }
+
+                std::memcpy(&value, data.data() + offset, sizeof(T));
+                offset += sizeof(T);
+                return true;
+            }
+
+            std::optional<std::span<const std::byte>> ReadBytes(size_t size) {
+                if (size > data.size() - offset) {
+                    return std::nullopt;
+                }
+
+                auto bytes = data.subspan(offset, size);
+                offset += size;
+                return bytes;
+            }
+
+            // Checked before sizing containers by counts read from the file.
+            bool Fits(size_t count, size_t elementSize) const { return count <= (data.size() - offset) / elementSize; }
+
+            bool Align(size_t alignment) {
+                size_t aligned = (offset + alignment - 1) / alignment * alignment;
+                if (aligned > data.size()) {
+                    return false;
+                }
+
+                offset = aligned;
+                return true;
+            }
+        };
+
+        struct Writer {
+            std::ofstream &stream;
+            size_t offset = 0;
+
+            template <typename T> void Write(const T &value) { WriteBytes(&value, sizeof(T)); }
+
+            void WriteBytes(const void *bytes, size_t size) {
+                stream.write(static_cast<const char *>(bytes), static_cast<std::streamsize>(size));
+                offset += size;
+            }
+
+            void Align(size_t alignment) {
+                static constexpr char PADDING[ARRAY_ALIGNMENT] = {};
+                WriteBytes(PADDING, (alignment - offset % alignment) % alignment);
+            }
+        };
+
+        bool readMesh(Reader &reader, MeshCache::Mesh &mesh) {
+            MeshHeader header{};
+            if (!reader.Read(header)) {
+                return false;
+            }
+
+            if (header.vertexFormat != MeshResource::VertexFormat::Float && header.vertexFormat != MeshResource::VertexFormat::Quantized) {
+                return false;
+            }
+
+            mesh.vertexFormat = header.vertexFormat;
+            mesh.vertexCount = header.vertexCount;
+            mesh.boundingBox = header.boundingBox;
+            mesh.boundingSphere = header.boundingSphere;
+            mesh.vertexDequantization = header.vertexDequantization;
+
+            if (!reader.Fits(header.submeshCount, sizeof(SubmeshHeader))) {
+                return false;
+            }
+
+            mesh.submeshes.resize(header.submeshCount);
+            for (auto &submesh : mesh.submeshes) {
+                SubmeshHeader submeshHeader{};
+                if (!reader.Read(submeshHeader)) {
+                    return false;
+                }
+
+                submesh.vertexOffset = submeshHeader.vertexOffset;
+                submesh.vertexCount = submeshHeader.vertexCount;
+                submesh.materialIndex = submeshHeader.materialIndex;
+                submesh.boundingBox = submeshHeader.boundingBox;
+                submesh.boundingSphere = submeshHeader.boundingSphere;
+
+                if (!reader.Fits(submeshHeader.lodCount, sizeof(MeshResource::Lod))) {
+                    return false;
+                }
+
+                // Ranges are drawn as they are, so they have to lie within arrays of the mesh. Sums are 64 bit so they can't wrap around.
+                if (static_cast<uint64_t>(submesh.vertexOffset) + submesh.vertexCount > header.vertexCount) {
+                    return false;
+                }
+
+                submesh.lods.resize(submeshHeader.lodCount);
+                for (auto &lod : submesh.lods) {
+                    if (!reader.Read(lod) || static_cast<uint64_t>(lod.firstIndex) + lod.indexCount > header.indexCount) {
+                        return false;
+                    }
+                }
+            }
+
+            if (!reader.Align(ARRAY_ALIGNMENT)) {
+                return false;
+            }
+            auto vertices = reader.ReadBytes(static_cast<size_t>(header.vertexCount) * MeshResource::GetVertexStride(header.vertexFormat));
+            if (!vertices) {
+                return false;
+            }
+            mesh.vertices = *vertices;
+
+            if (!reader.Align(ARRAY_ALIGNMENT)) {
+                return false;
+            }
+            auto indices = reader.ReadBytes(static_cast<size_t>(header.indexCount) * sizeof(MeshResource::Index));
+            if (!indices) {
+                return false;
+            }
+            mesh.indices = {reinterpret_cast<const MeshResource::Index *>(indices->data()), header.indexCount};
+
+            // Indices start at the first vertex of their submesh, one past its vertices would make the GPU fetch outside of the mesh.
+            for (const auto &submesh : mesh.submeshes) {
+                for (const auto &lod : submesh.lods) {
+                    auto lodIndices = mesh.indices.subspan(lod.firstIndex, lod.indexCount);
+                    if (std::ranges::any_of(lodIndices, [&](const MeshResource::Index &index) { return index.idx >= submesh.vertexCount; })) {
+                        return false;
+                    }
+                }
+            }
+
+            return true;
+        }
+
+        void writeMesh(Writer &writer, const MeshCache::Mesh &mesh) {
+            MeshHeader header{};
+            header.vertexFormat = mesh.vertexFormat;
+            header.vertexCount = mesh.vertexCount;
+            header.indexCount = static_cast<uint32_t>(mesh.indices.size());
+            header.submeshCount = static_cast<uint32_t>(mesh.submeshes.size());
+            header.boundingBox = mesh.boundingBox;
+            header.boundingSphere = mesh.boundingSphere;
+            header.vertexDequantization = mesh.vertexDequantization;
+            writer.Write(header);
+
+            for (const auto &submesh : mesh.submeshes) {
+                SubmeshHeader submeshHeader{};
+                submeshHeader.vertexOffset = submesh.vertexOffset;
+                submeshHeader.vertexCount = submesh.vertexCount;
+                submeshHeader.materialIndex = submesh.materialIndex;
+                submeshHeader.lodCount = static_cast<uint32_t>(submesh.lods.size());
+                submeshHeader.boundingBox = submesh.boundingBox;
+                submeshHeader.boundingSphere = submesh.boundingSphere;
+                writer.Write(submeshHeader);
+
+                for (const auto &lod : submesh.lods) {
+                    writer.Write(lod);
+                }
+            }
+
+            writer.Align(ARRAY_ALIGNMENT);
+            writer.WriteBytes(mesh.vertices.data(), mesh.vertices.size());
+
+            writer.Align(ARRAY_ALIGNMENT);
+            writer.WriteBytes(mesh.indices.data(), mesh.indices.size_bytes());
+        }
+    } // namespace
+
+    uint64_t MeshCache::Hash(std::span<const std::byte> data, uint64_t seed) {
+        uint64_t hash = seed;
+        for (auto byte : data) {
+            hash ^= static_cast<uint64_t>(byte);
+            hash *= FNV_PRIME;
+        }
+        return hash;
+    }
+
+    std::optional<MeshCache> MeshCache::Open(const std::string &path, uint64_t key) {
+        auto file = Utils::MappedFile::Open(path);
+        if (!file) {
+            return std::nullopt;
+        }
+
+        Reader reader{.data = file->GetData()};
+
+        FileHeader header{};
+        if (!reader.Read(header) || header.magic != MAGIC || header.version != VERSION || header.key != key) {
+            return std::nullopt;
+        }
+
+        if (!reader.Fits(header.nodeCount, sizeof(NodeHeader)) || !reader.Fits(header.meshCount, sizeof(MeshHeader))) {
+            return std::nullopt;
+        }
+
+        MeshCache cache{};
+
+        cache.model.nodes.resize(header.nodeCount);
+        for (auto &node : cache.model.nodes) {
+            NodeHeader nodeHeader{};
+            if (!reader.Read(nodeHeader)) {
+                return std::nullopt;
+            }
+
+            auto name = reader.ReadBytes(nodeHeader.nameLength);
+            if (!name) {
+                return std::nullopt;
+            }
+
+            node.name.assign(reinterpret_cast<const char *>(name->data()), name->size());
+            node.transform = nodeHeader.transform;
+            node.parent = nodeHeader.parent;
+            node.mesh = nodeHeader.mesh;
+        }
+
+        cache.model.meshes.resize(header.meshCount);
+        for (auto &mesh : cache.model.meshes) {
+            if (!readMesh(reader, mesh)) {
+                return std::nullopt;
+            }
+        }
+
+        // Scene::AddModel relies on parents preceding their children.
+        for (size_t i = 0; i < cache.model.nodes.size(); i++) {
+            const auto &node = cache.model.nodes[i];
+            if ((node.parent != Resources::ModelResource::NO_PARENT && node.parent >= i) ||
+                (node.mesh != Resources::ModelResource::NO_MESH && node.mesh >= header.meshCount)) {
+                return std::nullopt;
+            }
+        }
+
+        cache.file = std::move(*file);
+        return cache;
+    }
+
+    bool MeshCache::Write(const std::string &path, uint64_t key, const Model &model) {
+        std::error_code error;
+
+        std::filesystem::path cachePath(path);
+        std::filesystem::create_directories(cachePath.parent_path(), error);
+
+        // Unique per thread, the same model can be loaded on several threads at once.
+        auto temporaryPath = cachePath;
+        temporaryPath += std::format(".{}.tmp", std::hash<std::thread::id>{}(std::this_thread::get_id()));
+
+        {
+            std::ofstream stream(temporaryPath, std::ios::binary | std::ios::trunc);
+            if (!stream) {
+                std::cerr << "Couldn't create mesh cache " << temporaryPath.string() << std::endl;
+                return false;
+            }
+
+            Writer writer{.stream = stream};
+
+            FileHeader header{};
+            header.key = key;
+            header.nodeCount = static_cast<uint32_t>(model.nodes.size());
+            header.meshCount = static_cast<uint32_t>(model.meshes.size());
+            writer.Write(header);
+
+            for (const auto &node : model.nodes) {
+                NodeHeader nodeHeader{};
+                nodeHeader.transform = node.transform;
+                nodeHeader.parent = node.parent;
+                nodeHeader.mesh = node.mesh;
+                nodeHeader.nameLength = static_cast<uint32_t>(node.name.size());
+                writer.Write(nodeHeader);
+                writer.WriteBytes(node.name.data(), node.name.size());
+            }
+
+            for (const auto &mesh : model.meshes) {
+                writeMesh(writer, mesh);
+            }
+
+            if (!stream.flush()) {
+                std::cerr << "Couldn't write mesh cache " << temporaryPath.string() << std::endl;
+                stream.close();
+                std::filesystem::remove(temporaryPath, error);
+                return false;
+            }
+        }
+
+        std::filesystem::rename(temporaryPath, cachePath, error);
+        if (error) {
+            std::cerr << "Couldn't write mesh cache " << path << ": " << error.message() << std::endl;
+            std::filesystem::remove(temporaryPath, error);
+            return false;
+        }
+
+        return true;
+    }
+} // namespace Prism::Loaders
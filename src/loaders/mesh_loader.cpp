@@ -1,10 +1,25 @@
 #include "loaders/mesh_loader.hpp"
 
+#include "utils/mapped_file.hpp"
+#include "utils/mesh_optimization.hpp"
+#include "utils/mesh_simplification.hpp"
+#include "utils/profiler.hpp"
+#include "utils/vertex_quantization.hpp"
+
 #include <assimp/Importer.hpp>
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
 
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <format>
 #include <iostream>
+#include <limits>
+#include <map>
+#include <span>
 
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
@@ -15,15 +30,26 @@ namespace Prism::Loaders {
 
         constexpr std::string_view MODELS_DIR = "models/";
 
+        // Processed models, next to the sources so they are dropped together with the build directory.
+        constexpr std::string_view MODELS_CACHE_DIR = "models/cache/";
+        constexpr std::string_view MODELS_CACHE_EXTENSION = ".prismmesh";
+
         constexpr unsigned int MODELS_LOADING_FLAGS = aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_OptimizeMeshes | aiProcess_JoinIdenticalVertices |
                                                       aiProcess_GenSmoothNormals | aiProcess_CalcTangentSpace;
 
+        constexpr size_t MAX_LOD_COUNT = 5;
+        // Level is dropped when simplification can't get below this fraction of the previous level's indices.
+        constexpr float MIN_LOD_REDUCTION = 0.8f;
+        // Too small to be worth another draw.
+        constexpr size_t MIN_LOD_INDEX_COUNT = 3 * 64;
+
         using Vertex = Resources::MeshResource::Vertex;
         using Index = Resources::MeshResource::Index;
 
         struct MeshDescriptor {
             std::vector<Vertex> vertices;
             std::vector<Index> indices;
+            uint32_t materialIndex = 0;
         };
 
         glm::mat4 aiMatrix4x4ToGlm(const aiMatrix4x4 &aiMat) {
@@ -31,45 +57,301 @@ namespace Prism::Loaders {
                              aiMat.b4, aiMat.c4, aiMat.d4);
         }
 
-        void processNode(const aiNode *node, const aiScene *scene, glm::mat4 parentTransform, std::vector<Vertex> &vertices, std::vector<Index> &indices,
-                         size_t &vertexOffset) {
+        // Every assimp mesh of a node becomes a submesh, in local space of the node - its transform is applied per entity.
+        std::vector<MeshDescriptor> loadNodeMeshes(const aiScene *scene, const std::vector<unsigned int> &meshIndices) {
+            std::vector<MeshDescriptor> descriptors;
+            descriptors.reserve(meshIndices.size());
 
-            glm::mat4 nodeTransform = aiMatrix4x4ToGlm(node->mTransformation);
-            glm::mat4 globalTransform = parentTransform * nodeTransform;
+            for (auto meshIndex : meshIndices) {
+                const aiMesh *mesh = scene->mMeshes[meshIndex];
+                if (mesh->mNumVertices == 0 || mesh->mNumFaces == 0) {
+                    continue;
+                }
 
-            for (unsigned int i = 0; i < node->mNumMeshes; ++i) {
-                aiMesh *mesh = scene->mMeshes[node->mMeshes[i]];
+                MeshDescriptor descriptor{.materialIndex = mesh->mMaterialIndex};
 
                 for (unsigned int v = 0; v < mesh->mNumVertices; ++v) {
                     const aiVector3D &pos = mesh->mVertices[v];
 
-                    glm::vec4 transformedPos = globalTransform * glm::vec4(pos.x, pos.y, pos.z, 1.0f);
-
                     Vertex vert;
-                    vert.position = {transformedPos.x, transformedPos.y, transformedPos.z};
+                    vert.position = {pos.x, pos.y, pos.z};
                     vert.normal = {mesh->mNormals[v].x, mesh->mNormals[v].y, mesh->mNormals[v].z};
 
-                    vertices.push_back(std::move(vert));
+                    descriptor.vertices.push_back(std::move(vert));
                 }
 
                 for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
                     const aiFace &face = mesh->mFaces[f];
                     for (unsigned int idx = 0; idx < face.mNumIndices; ++idx) {
                         Index index;
-                        index.idx = face.mIndices[idx] + vertexOffset;
-                        indices.push_back(std::move(index));
+                        index.idx = face.mIndices[idx];
+                        descriptor.indices.push_back(std::move(index));
                     }
                 }
 
-                vertexOffset += mesh->mNumVertices;
+                descriptors.push_back(std::move(descriptor));
+            }
+
+            return descriptors;
+        }
+
+        Resources::MeshResource::BoundingBox computeBoundingBox(const std::vector<Vertex> &vertices) {
+            Resources::MeshResource::BoundingBox boundingBox{};
+            if (vertices.empty()) {
+                return boundingBox;
+            }
+
+            boundingBox.min = glm::vec3(std::numeric_limits<float>::max());
+            boundingBox.max = glm::vec3(std::numeric_limits<float>::lowest());
+            for (const auto &vertex : vertices) {
+                boundingBox.min = glm::min(boundingBox.min, vertex.position);
+                boundingBox.max = glm::max(boundingBox.max, vertex.position);
+            }
+
+            return boundingBox;
+        }
+
+        // Sphere around the center of the bounding box - not minimal, but cheap and good enough for culling.
+        Resources::MeshResource::BoundingSphere computeBoundingSphere(const std::vector<Vertex> &vertices,
+                                                                      const Resources::MeshResource::BoundingBox &boundingBox) {
+            Resources::MeshResource::BoundingSphere boundingSphere{};
+            boundingSphere.center = (boundingBox.min + boundingBox.max) * 0.5f;
+
+            float radiusSquared = 0.0f;
+            for (const auto &vertex : vertices) {
+                glm::vec3 offset = vertex.position - boundingSphere.center;
+                radiusSquared = std::max(radiusSquared, glm::dot(offset, offset));
+            }
+            boundingSphere.radius = std::sqrt(radiusSquared);
+
+            return boundingSphere;
+        }
+
+        // Appends simplified index lists, each targeting half of the previous one, after full detail indices.
+        std::vector<Resources::MeshResource::Lod> generateLods(const std::vector<Vertex> &vertices, std::vector<Index> &indices) {
+            std::vector<Resources::MeshResource::Lod> lods;
+            lods.push_back({.firstIndex = 0, .indexCount = static_cast<uint32_t>(indices.size()), .error = 0.0f});
+
+            std::vector<glm::vec3> positions;
+            positions.reserve(vertices.size());
+            for (const auto &vertex : vertices) {
+                positions.push_back(vertex.position);
+            }
+
+            std::vector<uint32_t> lodIndices;
+            lodIndices.reserve(indices.size());
+            for (const auto &index : indices) {
+                lodIndices.push_back(index.idx);
+            }
+
+            float error = 0.0f;
+            while (lods.size() < MAX_LOD_COUNT && lodIndices.size() / 2 >= MIN_LOD_INDEX_COUNT) {
+                float lodError = 0.0f;
+                auto simplifiedIndices = Utils::Simplification::SimplifyIndices(positions, lodIndices, lodIndices.size() / 6 * 3, &lodError);
+                if (simplifiedIndices.size() > lodIndices.size() * MIN_LOD_REDUCTION) {
+                    break;
+                }
+
+                // Levels are simplified from the previous one, so their errors add up.
+                error += lodError;
+                lods.push_back(
+                    {.firstIndex = static_cast<uint32_t>(indices.size()), .indexCount = static_cast<uint32_t>(simplifiedIndices.size()), .error = error});
+
+                for (auto index : simplifiedIndices) {
+                    indices.push_back({index});
+                }
+                lodIndices = std::move(simplifiedIndices);
+            }
+
+            return lods;
+        }
+
+        // Optimizes every LOD on its own, vertices are then renumbered by first use across all of them - full detail first.
+        void optimizeMesh(MeshDescriptor &descriptor, const std::vector<Resources::MeshResource::Lod> &lods, const std::string &path) {
+            namespace MeshOptimization = Utils::MeshOptimization;
+
+            std::vector<glm::vec3> positions;
+            positions.reserve(descriptor.vertices.size());
+            for (const auto &vertex : descriptor.vertices) {
+                positions.push_back(vertex.position);
+            }
+
+            std::vector<uint32_t> indices;
+            indices.reserve(descriptor.indices.size());
+            for (const auto &index : descriptor.indices) {
+                indices.push_back(index.idx);
+            }
+
+            auto getLodIndices = [&](const Resources::MeshResource::Lod &lod) {
+                return std::vector<uint32_t>(indices.begin() + lod.firstIndex, indices.begin() + lod.firstIndex + lod.indexCount);
+            };
+
+            auto statisticsBefore = MeshOptimization::AnalyzeVertexCache(getLodIndices(lods[0]), positions.size());
+
+            for (const auto &lod : lods) {
+                auto lodIndices = MeshOptimization::OptimizeVertexCache(getLodIndices(lod), positions.size());
+                lodIndices = MeshOptimization::OptimizeOverdraw(positions, lodIndices);
+                std::copy(lodIndices.begin(), lodIndices.end(), indices.begin() + lod.firstIndex);
+            }
+
+            auto statisticsAfter = MeshOptimization::AnalyzeVertexCache(getLodIndices(lods[0]), positions.size());
+
+            auto remap = MeshOptimization::OptimizeVertexFetch(indices, descriptor.vertices.size());
+
+            std::vector<Vertex> vertices(descriptor.vertices.size());
+            size_t usedVertexCount = 0;
+            for (size_t vertex = 0; vertex < remap.size(); vertex++) {
+                if (remap[vertex] != MeshOptimization::UNUSED_VERTEX) {
+                    vertices[remap[vertex]] = descriptor.vertices[vertex];
+                    usedVertexCount++;
+                }
             }
+            vertices.resize(usedVertexCount);
 
-            for (unsigned int c = 0; c < node->mNumChildren; ++c) {
-                processNode(node->mChildren[c], scene, globalTransform, vertices, indices, vertexOffset);
+            descriptor.vertices = std::move(vertices);
+            for (size_t i = 0; i < indices.size(); i++) {
+                descriptor.indices[i].idx = indices[i];
             }
+
+            std::cout << std::format("[MESH] {}: ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}, {} unused vertices dropped", path, statisticsBefore.acmr,
+                                     statisticsAfter.acmr, statisticsBefore.atvr, statisticsAfter.atvr, remap.size() - usedVertexCount)
+                      << std::endl;
         }
 
-        std::optional<MeshDescriptor> loadModel(Assimp::Importer &importer, const std::string &path) {
+        struct QuantizedVertices {
+            std::vector<Resources::MeshResource::QuantizedVertex> vertices;
+            Resources::MeshResource::VertexDequantization dequantization;
+        };
+
+        // Positions are stored relative to the bounding box, so their precision scales with the size of the mesh.
+        QuantizedVertices quantizeVertices(const std::vector<Vertex> &vertices, const Resources::MeshResource::BoundingBox &boundingBox,
+                                           const std::string &path) {
+            namespace Quantization = Utils::Quantization;
+
+            QuantizedVertices quantized{};
+            quantized.vertices.reserve(vertices.size());
+
+            const glm::vec3 extent = boundingBox.max - boundingBox.min;
+            quantized.dequantization.scale = extent;
+            quantized.dequantization.offset = boundingBox.min;
+
+            float maxPositionError = 0.0f;
+            float maxNormalError = 0.0f;
+            float maxTextureUVError = 0.0f;
+
+            for (const auto &vertex : vertices) {
+                Resources::MeshResource::QuantizedVertex quantizedVertex{};
+
+                for (int axis = 0; axis < 3; axis++) {
+                    float normalized = extent[axis] > 0.0f ? (vertex.position[axis] - boundingBox.min[axis]) / extent[axis] : 0.0f;
+                    quantizedVertex.position[axis] = Quantization::QuantizeUnorm16(normalized);
+                }
+
+                glm::vec2 octahedral = Quantization::EncodeOctahedral(vertex.normal);
+                quantizedVertex.normal[0] = Quantization::QuantizeSnorm16(octahedral.x);
+                quantizedVertex.normal[1] = Quantization::QuantizeSnorm16(octahedral.y);
+
+                quantizedVertex.textureUV[0] = Quantization::QuantizeHalf(vertex.textureUV.x);
+                quantizedVertex.textureUV[1] = Quantization::QuantizeHalf(vertex.textureUV.y);
+
+                // Decoded the same way basic.vert sees it.
+                glm::vec3 position = glm::vec3(Quantization::DequantizeUnorm16(quantizedVertex.position[0]),
+                                               Quantization::DequantizeUnorm16(quantizedVertex.position[1]),
+                                               Quantization::DequantizeUnorm16(quantizedVertex.position[2])) *
+                                         quantized.dequantization.scale +
+                                     quantized.dequantization.offset;
+                maxPositionError = std::max(maxPositionError, glm::length(position - vertex.position));
+
+                if (glm::length(vertex.normal) > 0.0f) {
+                    glm::vec3 normal = Quantization::DecodeOctahedral(
+                        glm::vec2(Quantization::DequantizeSnorm16(quantizedVertex.normal[0]), Quantization::DequantizeSnorm16(quantizedVertex.normal[1])));
+                    float angle = std::acos(std::clamp(glm::dot(glm::normalize(vertex.normal), normal), -1.0f, 1.0f));
+                    maxNormalError = std::max(maxNormalError, glm::degrees(angle));
+                }
+
+                glm::vec2 textureUV(Quantization::DequantizeHalf(quantizedVertex.textureUV[0]), Quantization::DequantizeHalf(quantizedVertex.textureUV[1]));
+                glm::vec2 textureUVError = glm::abs(textureUV - vertex.textureUV);
+                maxTextureUVError = std::max({maxTextureUVError, textureUVError.x, textureUVError.y});
+
+                quantized.vertices.push_back(quantizedVertex);
+            }
+
+            std::cout << std::format("[MESH] {}: quantized vertices {} -> {} bytes, max error - position {:.3g} ({:.4f}% of bounds), normal {:.3f} deg, "
+                                     "UV {:.3g}",
+                                     path, vertices.size() * sizeof(Vertex), quantized.vertices.size() * sizeof(Resources::MeshResource::QuantizedVertex),
+                                     maxPositionError, 100.0f * maxPositionError / std::max(glm::length(extent), std::numeric_limits<float>::min()),
+                                     maxNormalError, maxTextureUVError)
+                      << std::endl;
+
+            return quantized;
+        }
+
+        using MeshGeometry = MeshLoader::ProcessedModel::Geometry;
+
+        // Runs the whole pipeline on geometry of one node - LODs, optimization & bounds of every submesh, then quantization of all of them
+        // as a single geometry range. Expects at least one submesh.
+        MeshCache::Mesh processMesh(std::vector<MeshDescriptor> &descriptors, const MeshLoader::Settings &settings, MeshGeometry &geometry,
+                                    const std::string &name) {
+            auto &vertices = geometry.vertices;
+            auto &indices = geometry.indices;
+
+            MeshCache::Mesh mesh{};
+            mesh.submeshes.reserve(descriptors.size());
+
+            for (size_t i = 0; i < descriptors.size(); i++) {
+                auto &descriptor = descriptors[i];
+
+                auto lods = generateLods(descriptor.vertices, descriptor.indices);
+
+                if (settings.optimize) {
+                    optimizeMesh(descriptor, lods, descriptors.size() > 1 ? std::format("{}[{}]", name, i) : name);
+                }
+
+                Resources::MeshResource::Submesh submesh{};
+                submesh.vertexOffset = static_cast<uint32_t>(vertices.size());
+                submesh.vertexCount = static_cast<uint32_t>(descriptor.vertices.size());
+                submesh.boundingBox = computeBoundingBox(descriptor.vertices);
+                submesh.boundingSphere = computeBoundingSphere(descriptor.vertices, submesh.boundingBox);
+                submesh.materialIndex = descriptor.materialIndex;
+
+                for (auto &lod : lods) {
+                    lod.firstIndex += static_cast<uint32_t>(indices.size());
+                }
+                submesh.lods = std::move(lods);
+
+                vertices.insert(vertices.end(), descriptor.vertices.begin(), descriptor.vertices.end());
+                indices.insert(indices.end(), descriptor.indices.begin(), descriptor.indices.end());
+                mesh.submeshes.push_back(std::move(submesh));
+            }
+
+            mesh.boundingBox = mesh.submeshes.front().boundingBox;
+            for (const auto &submesh : mesh.submeshes) {
+                mesh.boundingBox.min = glm::min(mesh.boundingBox.min, submesh.boundingBox.min);
+                mesh.boundingBox.max = glm::max(mesh.boundingBox.max, submesh.boundingBox.max);
+            }
+            mesh.boundingSphere = computeBoundingSphere(vertices, mesh.boundingBox);
+
+            mesh.vertexFormat = settings.vertexFormat;
+            mesh.vertexCount = static_cast<uint32_t>(vertices.size());
+            mesh.indices = indices;
+
+            if (settings.vertexFormat == Resources::MeshResource::VertexFormat::Quantized) {
+                auto quantized = quantizeVertices(vertices, mesh.boundingBox, name);
+                geometry.quantizedVertices = std::move(quantized.vertices);
+                mesh.vertices = std::as_bytes(std::span(geometry.quantizedVertices));
+                mesh.vertexDequantization = quantized.dequantization;
+                vertices = {};
+            } else {
+                mesh.vertices = std::as_bytes(std::span(vertices));
+            }
+
+            return mesh;
+        }
+
+        // Imports the model with assimp and processes every mesh, arrays of the returned model point into geometries.
+        std::optional<MeshCache::Model> importModel(const std::string &path, const MeshLoader::Settings &settings, std::vector<MeshGeometry> &geometries) {
+            Assimp::Importer importer;
+
             const aiScene *scene = importer.ReadFile(std::string(MODELS_DIR) + path, MODELS_LOADING_FLAGS);
 
             if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
@@ -77,37 +359,147 @@ namespace Prism::Loaders {
                 return std::nullopt;
             }
 
-            std::vector<Vertex> vertices;
-            std::vector<Index> indices;
-            size_t vertexOffset = 0;
+            MeshCache::Model model{};
+
+            // Nodes referencing the same assimp meshes are instances of one mesh resource.
+            std::map<std::vector<unsigned int>, uint32_t> meshesByAssimpMeshes;
+
+            // Breadth first, so parents are always added before their children.
+            std::deque<std::pair<const aiNode *, uint32_t>> pendingNodes = {{scene->mRootNode, Resources::ModelResource::NO_PARENT}};
+            while (!pendingNodes.empty()) {
+                auto [node, parent] = pendingNodes.front();
+                pendingNodes.pop_front();
+
+                const auto nodeIndex = static_cast<uint32_t>(model.nodes.size());
+                model.nodes.push_back({.name = node->mName.C_Str(), .transform = aiMatrix4x4ToGlm(node->mTransformation), .parent = parent});
 
-            processNode(scene->mRootNode, scene, glm::mat4(1.0f), vertices, indices, vertexOffset);
+                if (node->mNumMeshes > 0) {
+                    std::vector<unsigned int> meshIndices(node->mMeshes, node->mMeshes + node->mNumMeshes);
 
-            return MeshDescriptor{.vertices = std::move(vertices), .indices = std::move(indices)};
+                    auto meshIt = meshesByAssimpMeshes.find(meshIndices);
+                    if (meshIt == meshesByAssimpMeshes.end()) {
+                        auto descriptors = loadNodeMeshes(scene, meshIndices);
+
+                        // Nodes whose meshes are all empty stay in the hierarchy without one.
+                        auto meshIndex = Resources::ModelResource::NO_MESH;
+                        if (!descriptors.empty()) {
+                            meshIndex = static_cast<uint32_t>(model.meshes.size());
+                            model.meshes.push_back(
+                                processMesh(descriptors, settings, geometries.emplace_back(), std::format("{}/{}", path, node->mName.C_Str())));
+                        }
+
+                        meshIt = meshesByAssimpMeshes.emplace(std::move(meshIndices), meshIndex).first;
+                    }
+                    model.nodes[nodeIndex].mesh = meshIt->second;
+                }
+
+                for (unsigned int c = 0; c < node->mNumChildren; ++c) {
+                    pendingNodes.emplace_back(node->mChildren[c], nodeIndex);
+                }
+            }
+
+            return model;
+        }
+
+        // Everything that changes the processed geometry besides the source file. Changes to the processing code itself bump MeshCache::VERSION.
+        uint64_t computeCacheKey(std::span<const std::byte> source, const MeshLoader::Settings &settings) {
+            const uint64_t options[] = {
+                MODELS_LOADING_FLAGS,
+                settings.optimize,
+                static_cast<uint64_t>(settings.vertexFormat),
+                MAX_LOD_COUNT,
+                std::bit_cast<uint32_t>(MIN_LOD_REDUCTION),
+                MIN_LOD_INDEX_COUNT,
+                sizeof(Vertex),
+                sizeof(Resources::MeshResource::QuantizedVertex),
+            };
+
+            return MeshCache::Hash(std::as_bytes(std::span(options)), MeshCache::Hash(source));
         }
     } // namespace
 
-    MeshLoader::result_type MeshLoader::operator()(Resources::VulkanResource &vulkanResource, Resources::VkStagingBufferResource &stagingBuffer,
-                                                   const std::string &path) const {
-        Assimp::Importer importer;
+    std::optional<MeshLoader::ProcessedModel> MeshLoader::Process(const std::string &path,
+                                                                  std::optional<Resources::MeshResource::VertexFormat> vertexFormat) const {
+        PRISM_PROFILE_SCOPE("MeshLoader::Process");
+
+        const auto start = std::chrono::steady_clock::now();
+        auto elapsedMs = [&]() { return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count(); };
+
+        Settings loadSettings = settings;
+        if (vertexFormat) {
+            loadSettings.vertexFormat = *vertexFormat;
+        }
+
+        // Formats are cached side by side, so loading a model in both doesn't overwrite one cache with the other every time.
+        const bool quantized = loadSettings.vertexFormat == Resources::MeshResource::VertexFormat::Quantized;
+        const std::string cachePath = std::format("{}{}{}{}", MODELS_CACHE_DIR, path, quantized ? ".quantized" : "", MODELS_CACHE_EXTENSION);
+
+        std::optional<uint64_t> cacheKey;
+        if (loadSettings.useCache) {
+            // Source is only hashed, mapping it reads the file without an extra copy.
+            if (auto source = Utils::MappedFile::Open(std::string(MODELS_DIR) + path)) {
+                cacheKey = computeCacheKey(source->GetData(), loadSettings);
+            }
+        }
+
+        ProcessedModel processedModel{};
+
+        if (cacheKey) {
+            processedModel.cache = MeshCache::Open(cachePath, *cacheKey);
+            if (processedModel.cache) {
+                std::cout << std::format("[MESH] {}: read from cache in {:.1f} ms", path, elapsedMs()) << std::endl;
+                return processedModel;
+            }
+        }
 
-        auto loadedModelDescriptorOpt = loadModel(importer, path);
-        if (!loadedModelDescriptorOpt) {
+        auto importedModel = importModel(path, loadSettings, processedModel.geometries);
+        if (!importedModel) {
             return std::nullopt;
         }
+        processedModel.model = std::move(*importedModel);
 
-        auto &loadedModelDescriptor = *loadedModelDescriptorOpt;
-        Resources::VkBufferResource<Vertex> vertexBuffer(vulkanResource.GetVmaAllocator(), loadedModelDescriptor.vertices.size() * sizeof(Vertex),
-                                                         VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT);
-        Resources::VkBufferResource<Index> indexBuffer(vulkanResource.GetVmaAllocator(), loadedModelDescriptor.indices.size() * sizeof(Index),
-                                                       VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+        std::cout << std::format("[MESH] {}: imported in {:.1f} ms", path, elapsedMs()) << std::endl;
 
-        stagingBuffer.Copy(vertexBuffer.GetBuffer(), loadedModelDescriptor.vertices.data(), vertexBuffer.GetBufferSize());
-        stagingBuffer.Copy(indexBuffer.GetBuffer(), loadedModelDescriptor.indices.data(), indexBuffer.GetBufferSize());
+        if (cacheKey && MeshCache::Write(cachePath, *cacheKey, processedModel.model)) {
+            std::cout << std::format("[MESH] {}: cache written to {}", path, cachePath) << std::endl;
+        }
+
+        return processedModel;
+    }
+
+    MeshLoader::result_type MeshLoader::Upload(const ProcessedModel &processedModel, Resources::GeometryPoolResource &geometryPool,
+                                               Resources::VkStagingBufferResource &stagingBuffer, const std::string &path) const {
+        PRISM_PROFILE_SCOPE("MeshLoader::Upload");
 
-        Resources::MeshResource meshResource{std::move(vertexBuffer), std::move(indexBuffer)};
+        const auto &sourceModel = processedModel.GetModel();
+
+        Resources::ModelResource model{};
+        model.nodes = sourceModel.nodes;
+        model.meshes.reserve(sourceModel.meshes.size());
+
+        // Geometry is copied straight from wherever the model points to, i.e. the mapped cache file, into the staging buffer.
+        for (const auto &mesh : sourceModel.meshes) {
+            auto geometryRange = geometryPool.Allocate(stagingBuffer, mesh.vertexFormat, mesh.vertices.data(), mesh.vertexCount, mesh.indices.data(),
+                                                       static_cast<uint32_t>(mesh.indices.size()));
+            if (!geometryRange) {
+                std::cerr << "Geometry pool is out of space, couldn't load " << path << std::endl;
+                return std::nullopt;
+            }
 
-        return {std::make_unique<Resources::MeshResource>(std::move(meshResource))};
+            model.meshes.push_back(std::make_unique<Resources::MeshResource>(geometryPool, *geometryRange, mesh.submeshes, mesh.boundingBox,
+                                                                             mesh.boundingSphere, mesh.vertexDequantization));
+        }
+
+        return model;
     }
 
+    MeshLoader::result_type MeshLoader::operator()(Resources::GeometryPoolResource &geometryPool, Resources::VkStagingBufferResource &stagingBuffer,
+                                                   const std::string &path) const {
+        auto processedModel = Process(path);
+        if (!processedModel) {
+            return std::nullopt;
+        }
+
+        return Upload(*processedModel, geometryPool, stagingBuffer, path);
+    }
 } // namespace Prism::Loaders
\ No newline at end of file
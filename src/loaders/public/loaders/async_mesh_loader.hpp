@@ -0,0 +1,111 @@
+#pragma once
+
+#include "loaders/mesh_loader.hpp"
+
+#include "resources/geometry_pool_resource.hpp"
+#include "resources/scene.hpp"
+#include "resources/vulkan/vk_staging_buffer_resource.hpp"
+
+#include "utils/mpsc_queue.hpp"
+
+#include <entt/entt.hpp>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace Prism::Loaders {
+    // Loads models in the background. Parsing & processing (MeshLoader::Process) run on a pool of worker threads, processed models come
+    // back through a lock-free queue and are uploaded & added to the scene on the thread recording frames. A placeholder box is drawn in
+    // place of every model until then.
+    class AsyncMeshLoader {
+      public:
+        // Runs on the thread calling Update, with the entity the model was added under - or entt::null when loading failed.
+        using Callback = std::function<void(Resources::Scene &scene, entt::entity entity)>;
+
+        static constexpr uint32_t MAX_WORKER_COUNT = 4;
+
+        explicit AsyncMeshLoader(MeshLoader::Settings settings = {});
+        // Waits for models being processed, models still queued are dropped.
+        ~AsyncMeshLoader();
+
+        AsyncMeshLoader(AsyncMeshLoader &other) = delete;
+        AsyncMeshLoader &operator=(AsyncMeshLoader &other) = delete;
+
+        // Workers refer to this instance.
+        AsyncMeshLoader(AsyncMeshLoader &&other) = delete;
+        AsyncMeshLoader &operator=(AsyncMeshLoader &&other) = delete;
+
+        // Uploads the placeholder mesh into the scene, has to be called before the first Load.
+        void Initialize(Resources::Scene &scene, Resources::GeometryPoolResource &geometryPool, Resources::VkStagingBufferResource &stagingBuffer);
+
+        // Adds an entity with the placeholder mesh and queues the model. Returns the entity, the model is parented to it once loaded, so
+        // the entity can be moved around in the meantime. Vertex format of the loader's settings is used unless one is given.
+        entt::entity Load(Resources::Scene &scene, const std::string &name, const std::string &path, Callback callback = {},
+                          std::optional<Resources::MeshResource::VertexFormat> vertexFormat = std::nullopt);
+
+        // Uploads models processed since the last call, adds them to the scene and runs their callbacks. Called once per frame before
+        // the staging buffer is committed. Models too large for the free staging space are added once all their copies are staged.
+        void Update(Resources::Scene &scene, Resources::GeometryPoolResource &geometryPool, Resources::VkStagingBufferResource &stagingBuffer);
+
+        // Queued or being processed, models waiting for Update included.
+        size_t GetPendingCount() const { return m_pendingLoads.size(); }
+
+        // Uploaded, but waiting for staging space over the next frames.
+        size_t GetStagingCount() const { return m_stagingLoads.size(); }
+
+      private:
+        struct Job {
+            uint64_t id;
+            std::string path;
+            std::optional<Resources::MeshResource::VertexFormat> vertexFormat;
+        };
+
+        struct ProcessedJob {
+            uint64_t id;
+            std::optional<MeshLoader::ProcessedModel> model;
+        };
+
+        // Known only to the thread calling Load & Update.
+        struct PendingLoad {
+            std::string name;
+            std::string path;
+            entt::entity entity;
+            Callback callback;
+        };
+
+        // Uploaded model waiting until the last of its copies is staged.
+        struct StagingLoad {
+            PendingLoad load;
+            Resources::ModelResource model;
+            uint64_t lastCopyId;
+        };
+
+        void addModel(Resources::Scene &scene, PendingLoad &pendingLoad, Resources::ModelResource &&model);
+
+        void workerLoop();
+
+        MeshLoader m_meshLoader;
+
+        std::vector<std::thread> m_workers;
+
+        std::mutex m_jobsMutex;
+        std::condition_variable m_jobsCondition;
+        std::deque<Job> m_jobs;
+        bool m_stopping = false;
+
+        Utils::MpscQueue<ProcessedJob> m_processedJobs;
+
+        uint64_t m_nextJobId = 0;
+        std::unordered_map<uint64_t, PendingLoad> m_pendingLoads;
+        // In upload order, so in order of their copies.
+        std::deque<StagingLoad> m_stagingLoads;
+    };
+} // namespace Prism::Loaders
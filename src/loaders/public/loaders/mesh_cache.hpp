@@ -0,0 +1,74 @@
+#pragma once
+
+#include "resources/mesh_resource.hpp"
+#include "resources/model_resource.hpp"
+
+#include "utils/mapped_file.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace Prism::Loaders {
+    // Versioned binary file with a fully processed model - node hierarchy, submesh tables, bounds and vertex & index arrays exactly as they
+    // are uploaded. The file is memory mapped and arrays are read straight from the mapping, so a hit costs little more than the copy into
+    // the staging buffer.
+    //
+    // Layout is native - a file written on a machine with different endianness or struct layout is just a miss.
+    class MeshCache {
+      public:
+        // Bumped whenever the layout of the file or the processing of meshes changes, files of other versions are misses.
+        static constexpr uint32_t VERSION = 1;
+
+        static constexpr uint64_t HASH_SEED = 0xcbf29ce484222325ull;
+
+        // Geometry of a single mesh resource. Arrays point either into the mapped file or into memory of whoever writes the cache.
+        struct Mesh {
+            Resources::MeshResource::VertexFormat vertexFormat = Resources::MeshResource::VertexFormat::Float;
+            // Vertices in vertexFormat.
+            std::span<const std::byte> vertices = {};
+            uint32_t vertexCount = 0;
+            std::span<const Resources::MeshResource::Index> indices = {};
+
+            std::vector<Resources::MeshResource::Submesh> submeshes = {};
+            Resources::MeshResource::BoundingBox boundingBox = {};
+            Resources::MeshResource::BoundingSphere boundingSphere = {};
+            Resources::MeshResource::VertexDequantization vertexDequantization = {};
+        };
+
+        struct Model {
+            // Same hierarchy as ModelResource::nodes, mesh indices refer to meshes below.
+            std::vector<Resources::ModelResource::Node> nodes = {};
+            std::vector<Mesh> meshes = {};
+        };
+
+        // FNV-1a, chain calls through seed to hash several inputs into one key.
+        static uint64_t Hash(std::span<const std::byte> data, uint64_t seed = HASH_SEED);
+
+        // Returns nullopt on a miss - no file, another version or key, or a file that is cut short.
+        static std::optional<MeshCache> Open(const std::string &path, uint64_t key);
+
+        // File is written under a temporary name and renamed, so an interrupted write never leaves a partial cache behind.
+        static bool Write(const std::string &path, uint64_t key, const Model &model);
+
+        MeshCache() = default;
+        ~MeshCache() = default;
+
+        MeshCache(const MeshCache &) = delete;
+        MeshCache &operator=(const MeshCache &) = delete;
+
+        // Mapping doesn't move with the file, arrays of the model stay valid.
+        MeshCache(MeshCache &&other) = default;
+        MeshCache &operator=(MeshCache &&other) = default;
+
+        // Valid as long as the cache is alive.
+        const Model &GetModel() const { return model; }
+
+      private:
+        Utils::MappedFile file = {};
+        Model model = {};
+    };
+} // namespace Prism::Loaders
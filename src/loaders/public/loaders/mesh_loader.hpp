@@ -1,18 +1,53 @@
 #pragma once
 
+#include "loaders/mesh_cache.hpp"
+
+#include "resources/geometry_pool_resource.hpp"
 #include "resources/mesh_resource.hpp"
+#include "resources/model_resource.hpp"
 #include "resources/vulkan/vk_staging_buffer_resource.hpp"
-#include "resources/vulkan_resource.hpp"
 
 #include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace Prism::Loaders {
     struct MeshLoader {
-        using result_type = std::optional<std::unique_ptr<Resources::MeshResource>>;
+        // Node hierarchy is kept, every node gets its own local transform and the meshes it references.
+        using result_type = std::optional<Resources::ModelResource>;
+
+        struct Settings {
+            // Reorders triangles & vertices of every LOD for vertex cache, overdraw and fetch locality before upload.
+            bool optimize = true;
+
+            // Quantized vertices take half of the memory & fetch bandwidth, precision lost is printed on load.
+            Resources::MeshResource::VertexFormat vertexFormat = Resources::MeshResource::VertexFormat::Float;
+
+            // Processed models are cached in models/cache/ keyed by the source file & settings above, later loads skip assimp and
+            // the whole processing pipeline.
+            bool useCache = true;
+        };
+
+        // CPU side result of loading a model. Nothing in it touches the GPU, so it can be produced on one thread and uploaded on another.
+        struct ProcessedModel {
+            // Arrays of one imported mesh, meshes read from the cache point into the mapped file instead.
+            struct Geometry {
+                std::vector<Resources::MeshResource::Vertex> vertices = {};
+                std::vector<Resources::MeshResource::QuantizedVertex> quantizedVertices = {};
+                std::vector<Resources::MeshResource::Index> indices = {};
+            };
+
+            const MeshCache::Model &GetModel() const { return cache ? cache->GetModel() : model; }
+
+            // Set on a cache hit, model & geometries are used otherwise.
+            std::optional<MeshCache> cache = {};
+            MeshCache::Model model = {};
+            std::vector<Geometry> geometries = {};
+        };
 
         MeshLoader() = default;
+        explicit MeshLoader(Settings settings) : settings(settings) {}
         ~MeshLoader() = default;
 
         MeshLoader(MeshLoader &&other) = default;
@@ -21,6 +56,18 @@ namespace Prism::Loaders {
         MeshLoader(MeshLoader &other) = delete;
         MeshLoader &operator=(MeshLoader &) = delete;
 
-        result_type operator()(Resources::VulkanResource &vulkanResource, Resources::VkStagingBufferResource &stagingBuffer, const std::string &path) const;
+        // Reads the model from the cache, or imports & processes it and writes the cache. Vertex format of the settings is used unless
+        // one is given. Touches no GPU state and is safe to call from several threads at once.
+        std::optional<ProcessedModel> Process(const std::string &path, std::optional<Resources::MeshResource::VertexFormat> vertexFormat = std::nullopt) const;
+
+        // Schedules upload of all meshes, has to be called on the thread recording frames.
+        result_type Upload(const ProcessedModel &processedModel, Resources::GeometryPoolResource &geometryPool,
+                           Resources::VkStagingBufferResource &stagingBuffer, const std::string &path) const;
+
+        // Process & Upload at once.
+        result_type operator()(Resources::GeometryPoolResource &geometryPool, Resources::VkStagingBufferResource &stagingBuffer, const std::string &path) const;
+
+      private:
+        Settings settings = {};
     };
 }; // namespace Prism::Loaders
\ No newline at end of file
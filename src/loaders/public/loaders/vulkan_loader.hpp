@@ -17,6 +17,6 @@ namespace Prism::Loaders {
         VulkanLoader(VulkanLoader &other) = delete;
         VulkanLoader &operator=(VulkanLoader &) = delete;
 
-        result_type operator()(Resources::WindowResource &windowResource);
+        result_type operator()(Resources::WindowResource &windowResource, uint32_t framesInFlight = Resources::VulkanResource::DEFAULT_FRAMES_IN_FLIGHT);
     };
 } // namespace Prism::Loaders
\ No newline at end of file
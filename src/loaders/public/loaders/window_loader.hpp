@@ -20,5 +20,8 @@ namespace Prism::Loaders {
         WindowLoader &operator=(WindowLoader &) = delete;
 
         result_type operator()() const;
+
+        // Headless window resource has no GLFW window behind it, it only carries the fixed render extent.
+        result_type operator()(bool headless, int width, int height) const;
     };
 }; // namespace Prism::Loaders
\ No newline at end of file
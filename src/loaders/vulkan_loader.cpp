@@ -13,24 +13,31 @@
 #include <optional>
 #include <set>
 #include <stdexcept>
+#include <tuple>
 #include <utility>
 
 namespace Prism::Loaders {
     namespace {
-        std::vector<const char *> getRequiredInstanceExtensions() {
-            uint32_t glfwExtensionCount = 0;
-            const char **glfwExtensions;
-            glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+        std::vector<const char *> getRequiredInstanceExtensions(bool headless) {
+            std::vector<const char *> extensions;
 
-            std::vector<const char *> extensions(glfwExtensions, glfwExtensions + glfwExtensionCount);
+            if (!headless) {
+                uint32_t glfwExtensionCount = 0;
+                const char **glfwExtensions;
+                glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+
+                extensions.assign(glfwExtensions, glfwExtensions + glfwExtensionCount);
+                extensions.push_back("VK_KHR_surface");
+            }
 
 #ifdef DEBUG
             extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
 #endif
-            extensions.push_back("VK_KHR_surface");
 
 #ifdef PLATFORM_MAC
-            extensions.push_back("VK_MVK_macos_surface");
+            if (!headless) {
+                extensions.push_back("VK_MVK_macos_surface");
+            }
             extensions.push_back("VK_KHR_portability_enumeration");
             extensions.push_back("VK_KHR_get_physical_device_properties2");
 #endif
@@ -38,9 +45,11 @@ namespace Prism::Loaders {
             return extensions;
         };
 
-        std::vector<const char *> getRequiredDeviceExtensions() {
+        std::vector<const char *> getRequiredDeviceExtensions(bool headless) {
             std::vector<const char *> deviceExtensions;
-            deviceExtensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+            if (!headless) {
+                deviceExtensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+            }
 #ifdef PLATFORM_MAC
             deviceExtensions.push_back("VK_KHR_portability_subset");
 #endif
@@ -57,14 +66,14 @@ namespace Prism::Loaders {
             return validationLayers;
         }
 
-        bool checkPhysicalDeviceExtensionsSupport(VkPhysicalDevice device) {
+        bool checkPhysicalDeviceExtensionsSupport(VkPhysicalDevice device, bool headless) {
             uint32_t extensionCount;
             vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, nullptr);
 
             std::vector<VkExtensionProperties> availableExtensions(extensionCount);
             vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, availableExtensions.data());
 
-            auto deviceExtensions = getRequiredDeviceExtensions();
+            auto deviceExtensions = getRequiredDeviceExtensions(headless);
             std::set<std::string> requiredExtensions(deviceExtensions.begin(), deviceExtensions.end());
 
             for (const auto &extension : availableExtensions) {
@@ -74,7 +83,7 @@ namespace Prism::Loaders {
             return requiredExtensions.empty();
         }
 
-        VkInstance createInstance() {
+        VkInstance createInstance(bool headless) {
             VkResult result;
 
             VkApplicationInfo appInfo{};
@@ -89,7 +98,7 @@ namespace Prism::Loaders {
             createInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
             createInfo.pApplicationInfo = &appInfo;
 
-            auto extensions = getRequiredInstanceExtensions();
+            auto extensions = getRequiredInstanceExtensions(headless);
 
             createInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
             createInfo.ppEnabledExtensionNames = extensions.data();
@@ -127,7 +136,7 @@ namespace Prism::Loaders {
             return surface;
         }
 
-        VkPhysicalDevice pickPhysicalDevice(VkInstance instance) {
+        VkPhysicalDevice pickPhysicalDevice(VkInstance instance, bool headless) {
             uint32_t deviceCount = 0;
             vkEnumeratePhysicalDevices(instance, &deviceCount, nullptr);
 
@@ -140,7 +149,7 @@ namespace Prism::Loaders {
 
 
             for (const auto &device : devices) {
-                if (checkPhysicalDeviceExtensionsSupport(device)) {
+                if (checkPhysicalDeviceExtensionsSupport(device, headless)) {
                     return device;
                 }
             }
@@ -148,11 +157,14 @@ namespace Prism::Loaders {
             throw std::runtime_error("Couldn't find a suitable GPU!");
         };
 
-        VkDevice createLogicalDevice(VkPhysicalDevice physicalDevice, Utils::Vulkan::Common::QueueFamilyIndices indices) {
+        VkDevice createLogicalDevice(VkPhysicalDevice physicalDevice, Utils::Vulkan::Common::QueueFamilyIndices indices, bool headless) {
             VkDevice device;
 
             std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
             std::set<uint32_t> uniqueQueueFamilies = {indices.graphicsFamily.value(), indices.presentFamily.value()};
+            if (indices.transferFamily) {
+                uniqueQueueFamilies.insert(*indices.transferFamily);
+            }
 
             float queuePriority = 1.0f;
             for (uint32_t queueFamily : uniqueQueueFamilies) {
@@ -165,11 +177,41 @@ namespace Prism::Loaders {
                 queueCreateInfos.push_back(queueCreateInfo);
             }
 
+            VkPhysicalDeviceFeatures supportedFeatures;
+            vkGetPhysicalDeviceFeatures(physicalDevice, &supportedFeatures);
+
             VkPhysicalDeviceFeatures deviceFeatures{};
+            // Optional, used by GPU profiler.
+            deviceFeatures.pipelineStatisticsQuery = supportedFeatures.pipelineStatisticsQuery;
+            // Optional, mesh drawing falls back to a direct vkCmdDrawIndexed per draw without them.
+            deviceFeatures.multiDrawIndirect = supportedFeatures.multiDrawIndirect;
+            deviceFeatures.drawIndirectFirstInstance = supportedFeatures.drawIndirectFirstInstance;
+
+            VkPhysicalDeviceVulkan12Features supportedVulkan12Features{};
+            supportedVulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+
+            VkPhysicalDeviceFeatures2 supportedFeatures2{};
+            supportedFeatures2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+            supportedFeatures2.pNext = &supportedVulkan12Features;
+            vkGetPhysicalDeviceFeatures2(physicalDevice, &supportedFeatures2);
+
+            VkPhysicalDeviceVulkan12Features vulkan12Features{};
+            vulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+            // Optional, mesh culling runs on the CPU without it.
+            vulkan12Features.drawIndirectCount = supportedVulkan12Features.drawIndirectCount;
+            // Frames are paced with a single timeline semaphore, core & always supported in Vulkan 1.2.
+            vulkan12Features.timelineSemaphore = VK_TRUE;
+
+            // Render graph records its barriers with vkCmdPipelineBarrier2, core & always supported in Vulkan 1.3.
+            VkPhysicalDeviceSynchronization2Features synchronization2Features{};
+            synchronization2Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES;
+            synchronization2Features.synchronization2 = VK_TRUE;
+            synchronization2Features.pNext = &vulkan12Features;
 
             VkPhysicalDeviceDynamicRenderingFeatures dynamicRenderingFeatures{};
             dynamicRenderingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES;
             dynamicRenderingFeatures.dynamicRendering = VK_TRUE;
+            dynamicRenderingFeatures.pNext = &synchronization2Features;
 
             VkDeviceCreateInfo createInfo{};
             createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
@@ -179,7 +221,7 @@ namespace Prism::Loaders {
 
             createInfo.pEnabledFeatures = &deviceFeatures;
 
-            std::vector<const char *> deviceExtensions = getRequiredDeviceExtensions();
+            std::vector<const char *> deviceExtensions = getRequiredDeviceExtensions(headless);
             createInfo.enabledExtensionCount = static_cast<uint32_t>(deviceExtensions.size());
             createInfo.ppEnabledExtensionNames = deviceExtensions.data();
 
@@ -197,7 +239,7 @@ namespace Prism::Loaders {
             return device;
         }
 
-        std::pair<VkQueue, VkQueue> getQueues(VkDevice device, Utils::Vulkan::Common::QueueFamilyIndices indices) {
+        std::tuple<VkQueue, VkQueue, VkQueue> getQueues(VkDevice device, Utils::Vulkan::Common::QueueFamilyIndices indices) {
 
             VkQueue graphicsQueue;
             vkGetDeviceQueue(device, indices.graphicsFamily.value(), 0, &graphicsQueue);
@@ -205,28 +247,40 @@ namespace Prism::Loaders {
             VkQueue presentationQueue;
             vkGetDeviceQueue(device, indices.presentFamily.value(), 0, &presentationQueue);
 
-            return std::make_pair(graphicsQueue, presentationQueue);
+            VkQueue transferQueue = VK_NULL_HANDLE;
+            if (indices.transferFamily) {
+                vkGetDeviceQueue(device, *indices.transferFamily, 0, &transferQueue);
+            }
+
+            return std::make_tuple(graphicsQueue, presentationQueue, transferQueue);
         }
     }; // namespace
 
-    VulkanLoader::result_type VulkanLoader::operator()(Resources::WindowResource &windowResource) {
+    VulkanLoader::result_type VulkanLoader::operator()(Resources::WindowResource &windowResource, uint32_t framesInFlight) {
         try {
-            auto instance = createInstance();
+            const bool headless = windowResource.IsHeadless();
+
+            auto instance = createInstance(headless);
 #ifdef DEBUG
             auto debugMessenger = std::make_unique<Utils::Vulkan::DebugMessenger>(instance);
 #else
             auto debugMessenger = nullptr;
 #endif
 
-            auto surface = createSurface(instance, windowResource.GetWindow());
+            // Headless mode renders only into offscreen targets, so there is no surface to present to.
+            VkSurfaceKHR surface = headless ? VK_NULL_HANDLE : createSurface(instance, windowResource.GetWindow());
 
-            auto physicalDevice = pickPhysicalDevice(instance);
+            auto physicalDevice = pickPhysicalDevice(instance, headless);
 
             Utils::Vulkan::Common::QueueFamilyIndices indices = Utils::Vulkan::Common::findQueueFamilies(surface, physicalDevice);
 
-            auto device = createLogicalDevice(physicalDevice, indices);
+            auto device = createLogicalDevice(physicalDevice, indices, headless);
 
-            auto [graphicsQueue, presentationQueue] = getQueues(device, indices);
+            auto [graphicsQueue, presentationQueue, transferQueue] = getQueues(device, indices);
+
+            if (indices.transferFamily) {
+                std::cout << "Uploads use dedicated transfer queue family " << *indices.transferFamily << std::endl;
+            }
 
             auto [windowWidth, windowHeight] = windowResource.GetWindowExtent();
             VkExtent2D windowExtent = {.width = static_cast<uint32_t>(windowWidth), .height = static_cast<uint32_t>(windowHeight)};
@@ -243,7 +297,7 @@ namespace Prism::Loaders {
             vmaCreateAllocator(&allocatorInfo, &allocator);
 
             return Resources::VulkanResource(instance, std::move(debugMessenger), surface, physicalDevice, device, allocator, graphicsQueue, presentationQueue,
-                                             windowExtent);
+                                             transferQueue, indices, windowExtent, framesInFlight);
 
         } catch (const std::exception &e) {
             std::cerr << "Couldn't load Vulkan - " << e.what() << std::endl;
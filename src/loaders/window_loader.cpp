@@ -12,14 +12,22 @@ namespace Prism::Loaders {
         const int SCR_HEIGHT = 600;
     } // namespace
 
-    WindowLoader::result_type WindowLoader::operator()() const {
+    WindowLoader::result_type WindowLoader::operator()() const { return (*this)(false, SCR_WIDTH, SCR_HEIGHT); }
+
+    WindowLoader::result_type WindowLoader::operator()(bool headless, int width, int height) const {
+        if (headless) {
+            Resources::WindowResource windowResource{nullptr};
+            windowResource.UpdateWindowExtent(width, height);
+
+            return windowResource;
+        }
 
         if (!glfwInit()) {
             throw std::runtime_error("Failed to initialize GLFW!");
         }
 
         glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
-        auto window = glfwCreateWindow(SCR_WIDTH, SCR_HEIGHT, "PrismEngine", nullptr, nullptr);
+        auto window = glfwCreateWindow(width, height, "PrismEngine", nullptr, nullptr);
 
         if (!window) {
             throw std::runtime_error("Failed to create GLFW window");
@@ -30,7 +38,7 @@ namespace Prism::Loaders {
 
         Resources::WindowResource windowResource{std::move(window)};
 
-        windowResource.UpdateWindowExtent(SCR_WIDTH, SCR_HEIGHT);
+        windowResource.UpdateWindowExtent(width, height);
 
         return windowResource;
     }
@@ -1,8 +1,12 @@
 #include "context/context.hpp"
+#include "utils/frustum_culling.hpp"
+#include "utils/normal_matrix.hpp"
 
 
 #include <iostream>
+#include <optional>
 #include <stdexcept>
+#include <string>
 
 #define GLFW_INCLUDE_VULKAN
 #include "GLFW/glfw3.h"
@@ -28,12 +32,95 @@ std::vector<const char *> getRequiredInstanceExtensions() {
     return extensions;
 };
 
-int main() {
+Prism::Context::ContextSettings parseSettings(int argc, char **argv) {
+    Prism::Context::ContextSettings settings{};
+
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+
+        if (argument == "--headless") {
+            settings.headless = true;
+        } else if (argument == "--frames" && i + 1 < argc) {
+            settings.headlessFrameCount = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if (argument == "--frames-in-flight" && i + 1 < argc) {
+            settings.framesInFlight = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if (argument == "--cpu-trace" && i + 1 < argc) {
+            settings.cpuTraceOutputPath = argv[++i];
+        } else if (argument == "--no-mesh-optimization") {
+            settings.optimizeMeshes = false;
+        } else if (argument == "--no-mesh-cache") {
+            settings.useMeshCache = false;
+        } else if (argument == "--per-vertex-normal-matrix") {
+            settings.perVertexNormalMatrix = true;
+        } else if (argument == "--vertex-format" && i + 1 < argc) {
+            std::string vertexFormat = argv[++i];
+            if (vertexFormat == "float") {
+                settings.meshVertexFormat = Prism::Resources::MeshResource::VertexFormat::Float;
+            } else if (vertexFormat == "quantized") {
+                settings.meshVertexFormat = Prism::Resources::MeshResource::VertexFormat::Quantized;
+            } else {
+                throw std::runtime_error("Invalid vertex format, expected float or quantized: " + vertexFormat);
+            }
+        } else if (argument == "--resolution" && i + 1 < argc) {
+            // Expected format: WIDTHxHEIGHT, e.g. 1920x1080.
+            std::string resolution = argv[++i];
+            auto separator = resolution.find('x');
+            if (separator == std::string::npos) {
+                throw std::runtime_error("Invalid resolution, expected WIDTHxHEIGHT: " + resolution);
+            }
+
+            settings.headlessWidth = static_cast<uint32_t>(std::stoul(resolution.substr(0, separator)));
+            settings.headlessHeight = static_cast<uint32_t>(std::stoul(resolution.substr(separator + 1)));
+        } else {
+            std::cerr << "Unknown argument: " << argument << std::endl;
+        }
+    }
+
+    return settings;
+}
+
+// Microbenchmarks run without creating a window or Vulkan device, e.g. --benchmark culling --entities 100000.
+std::optional<int> runBenchmark(int argc, char **argv) {
+    std::optional<std::string> benchmark;
+    size_t entityCount = 100000;
+
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+
+        if (argument == "--benchmark" && i + 1 < argc) {
+            benchmark = argv[++i];
+        } else if (argument == "--entities" && i + 1 < argc) {
+            entityCount = std::stoul(argv[++i]);
+        }
+    }
+
+    if (!benchmark) {
+        return std::nullopt;
+    }
+
+    if (*benchmark == "culling") {
+        return Prism::Utils::Culling::RunCullingBenchmark(entityCount) ? 0 : 1;
+    }
+
+    if (*benchmark == "normal-matrices") {
+        return Prism::Utils::NormalMatrices::RunNormalMatrixBenchmark(entityCount) ? 0 : 1;
+    }
+
+    std::cerr << "Unknown benchmark: " << *benchmark << std::endl;
+    return 1;
+}
+
+int main(int argc, char **argv) {
+    if (auto benchmarkResult = runBenchmark(argc, argv)) {
+        return *benchmarkResult;
+    }
+
     try {
-        Prism::Context::Context context;
+        Prism::Context::Context context{parseSettings(argc, argv)};
         context.RunEngine();
     } catch (const std::exception &e) {
         std::cerr << "Shader compilation error: " << e.what() << std::endl;
+        return 1;
     }
     return 0;
 }
@@ -0,0 +1,185 @@
+#pragma once
+
+#include "vulkan/vulkan.h"
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Prism::Managers {
+    // Passes of a single frame, recorded into one command buffer. Passes declare how they use images & buffers, the graph orders
+    // them by those uses, drops passes whose results are never used and puts one vkCmdPipelineBarrier2 batch with only the needed
+    // barriers in front of every pass.
+    //
+    // Within a frame every resource is first written, then modified and then read: Write passes run before ReadWrite passes, which
+    // run before Read passes of the same resource. Passes of the same kind keep the order they were added in, reads of one resource
+    // don't depend on each other. Passes without a dependency between them run in the order they were added.
+    class RenderGraph {
+      public:
+        using ResourceId = uint32_t;
+
+        // Synchronization2 scope of a resource use. Layout is ignored for buffers.
+        struct Usage {
+            VkPipelineStageFlags2 stageMask = VK_PIPELINE_STAGE_2_NONE;
+            VkAccessFlags2 accessMask = VK_ACCESS_2_NONE;
+            VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+        };
+
+        static constexpr Usage COLOR_ATTACHMENT = {VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+                                                   VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
+                                                   VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL};
+        static constexpr Usage DEPTH_STENCIL_ATTACHMENT = {
+            VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT,
+            VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL};
+        static constexpr Usage TRANSFER_SOURCE = {VK_PIPELINE_STAGE_2_COPY_BIT, VK_ACCESS_2_TRANSFER_READ_BIT, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL};
+        static constexpr Usage TRANSFER_DESTINATION = {VK_PIPELINE_STAGE_2_COPY_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL};
+        static constexpr Usage PRESENT = {VK_PIPELINE_STAGE_2_NONE, VK_ACCESS_2_NONE, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR};
+        static constexpr Usage VERTEX_BUFFER = {VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT, VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT,
+                                                VK_IMAGE_LAYOUT_UNDEFINED};
+        static constexpr Usage INDEX_BUFFER = {VK_PIPELINE_STAGE_2_INDEX_INPUT_BIT, VK_ACCESS_2_INDEX_READ_BIT, VK_IMAGE_LAYOUT_UNDEFINED};
+        static constexpr Usage INDIRECT_BUFFER = {VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT, VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT, VK_IMAGE_LAYOUT_UNDEFINED};
+        static constexpr Usage VERTEX_SHADER_STORAGE_READ = {VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT, VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
+                                                             VK_IMAGE_LAYOUT_UNDEFINED};
+        static constexpr Usage COMPUTE_STORAGE = {VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                                                  VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT, VK_IMAGE_LAYOUT_UNDEFINED};
+        static constexpr Usage HOST_READ = {VK_PIPELINE_STAGE_2_HOST_BIT, VK_ACCESS_2_HOST_READ_BIT, VK_IMAGE_LAYOUT_UNDEFINED};
+
+        class PassBuilder {
+          public:
+            // Pass depends on earlier contents of the resource.
+            void Read(ResourceId resource, Usage usage);
+
+            // Earlier contents are overwritten, e.g. attachments cleared on load.
+            void Write(ResourceId resource, Usage usage);
+
+            // Earlier contents are kept & modified, e.g. attachments loaded with VK_ATTACHMENT_LOAD_OP_LOAD.
+            void ReadWrite(ResourceId resource, Usage usage);
+
+            // Pass is kept even when nothing reads what it writes.
+            void SetSideEffect();
+
+          private:
+            friend class RenderGraph;
+
+            PassBuilder(RenderGraph &renderGraph, uint32_t passIndex) : m_renderGraph(renderGraph), m_passIndex(passIndex) {}
+
+            RenderGraph &m_renderGraph;
+            uint32_t m_passIndex;
+
+            void addAccess(ResourceId resource, Usage usage, bool reads, bool writes);
+        };
+
+        using SetupCallback = std::function<void(PassBuilder &)>;
+        using ExecuteCallback = std::function<void(VkCommandBuffer)>;
+
+        RenderGraph() = default;
+        ~RenderGraph() = default;
+
+        RenderGraph(const RenderGraph &) = delete;
+        RenderGraph &operator=(const RenderGraph &) = delete;
+
+        RenderGraph(RenderGraph &&) = default;
+        RenderGraph &operator=(RenderGraph &&) = default;
+
+        // Resources are owned outside of the graph. Initial usage is the last use before the graph runs, waited on by the first
+        // pass - UNDEFINED layout lets the first transition discard contents.
+        ResourceId ImportImage(std::string_view name, VkImage image, VkImageAspectFlags aspectMask, Usage initialUsage);
+
+        // Ranges of one VkBuffer, e.g. suballocated ones, are tracked as separate resources & must not overlap.
+        ResourceId ImportBuffer(std::string_view name, VkBuffer buffer, Usage initialUsage, VkDeviceSize offset = 0, VkDeviceSize size = VK_WHOLE_SIZE);
+
+        // Result of the frame, passes writing it are never culled. Images are transitioned to final usage after the last pass.
+        void MarkOutput(ResourceId resource, std::optional<Usage> finalUsage = std::nullopt);
+
+        void AddPass(std::string_view name, const SetupCallback &setup, ExecuteCallback execute);
+
+        // Orders & culls passes and computes barriers, has to be called after every pass was added. Throws when passes depend on each
+        // other in a cycle.
+        void Compile();
+
+        void Execute(VkCommandBuffer commandBuffer);
+
+        // Forgets passes & resources of the frame, allocations are kept for the next one.
+        void Reset();
+
+        size_t GetPassCount() const { return m_passes.size(); }
+
+        size_t GetCulledPassCount() const;
+
+      private:
+        struct Resource {
+            std::string name;
+            VkImage image = VK_NULL_HANDLE;
+            VkImageAspectFlags aspectMask = 0;
+            VkBuffer buffer = VK_NULL_HANDLE;
+            VkDeviceSize offset = 0;
+            VkDeviceSize size = VK_WHOLE_SIZE;
+            Usage initialUsage = {};
+            std::optional<Usage> finalUsage = std::nullopt;
+            bool output = false;
+        };
+
+        struct Access {
+            ResourceId resource;
+            Usage usage;
+            bool reads;
+            bool writes;
+        };
+
+        // Ranges of m_imageBarriers & m_bufferBarriers recorded in front of a pass.
+        struct BarrierBatch {
+            uint32_t firstImageBarrier = 0;
+            uint32_t imageBarrierCount = 0;
+            uint32_t firstBufferBarrier = 0;
+            uint32_t bufferBarrierCount = 0;
+        };
+
+        struct Pass {
+            std::string name;
+            ExecuteCallback execute;
+            std::vector<Access> accesses = {};
+            bool sideEffect = false;
+            bool culled = false;
+            BarrierBatch barriers = {};
+        };
+
+        // Synchronization state of a resource while barriers are computed.
+        struct ResourceState {
+            VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+            // Last write, or layout transition, every later use has to wait for.
+            VkPipelineStageFlags2 writeStageMask = VK_PIPELINE_STAGE_2_NONE;
+            VkAccessFlags2 writeAccessMask = VK_ACCESS_2_NONE;
+            // Reads since the last write, the next write has to wait for them.
+            VkPipelineStageFlags2 readStageMask = VK_PIPELINE_STAGE_2_NONE;
+            // Scopes the last write was already made visible to.
+            VkPipelineStageFlags2 visibleStageMask = VK_PIPELINE_STAGE_2_NONE;
+            VkAccessFlags2 visibleAccessMask = VK_ACCESS_2_NONE;
+        };
+
+        std::vector<Resource> m_resources = {};
+        std::vector<Pass> m_passes = {};
+        // Scratch of sortPasses, kept to reuse allocations.
+        std::vector<Pass> m_sortedPasses = {};
+        std::vector<uint8_t> m_passDependencies = {};
+        std::vector<uint32_t> m_passDependencyCounts = {};
+        std::vector<uint32_t> m_passOrder = {};
+
+        std::vector<VkImageMemoryBarrier2> m_imageBarriers = {};
+        std::vector<VkBufferMemoryBarrier2> m_bufferBarriers = {};
+        // Transitions of outputs to their final usage, after the last pass.
+        BarrierBatch m_finalBarriers = {};
+
+        bool m_compiled = false;
+
+        void sortPasses();
+
+        void cullPasses();
+
+        void addBarrier(ResourceId resource, ResourceState &state, const Usage &usage, bool writes);
+
+        void recordBarriers(VkCommandBuffer commandBuffer, const BarrierBatch &batch) const;
+    };
+} // namespace Prism::Managers
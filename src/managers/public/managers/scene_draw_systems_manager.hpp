@@ -1,6 +1,9 @@
 #pragma once
 
+#include "managers/render_graph.hpp"
+
 #include "systems/gizmo_drawing_system.hpp"
+#include "systems/mesh_culling_system.hpp"
 #include "systems/mesh_drawing_system.hpp"
 #include "systems/present_system.hpp"
 #include "systems/screen_clearing_system.hpp"
@@ -16,9 +19,10 @@
 namespace Prism::Managers {
     class SceneDrawSystemsManager {
       public:
-        SceneDrawSystemsManager(Resources::ContextResources &contextResources);
+        // Per vertex normal matrix is only meant for benchmarking, see MeshDrawingSystem.
+        SceneDrawSystemsManager(Resources::ContextResources &contextResources, bool perVertexNormalMatrix = false);
 
-        ~SceneDrawSystemsManager();
+        ~SceneDrawSystemsManager() = default;
 
         SceneDrawSystemsManager(const SceneDrawSystemsManager &) = delete;
         SceneDrawSystemsManager &operator=(const SceneDrawSystemsManager &) = delete;
@@ -31,19 +35,24 @@ namespace Prism::Managers {
         void Update(float deltaTime, Resources::Scene &scene, Resources::VkStagingBufferResource &stagingBuffer);
 
       private:
-        inline static const size_t RENDER_TARGET_RESOURCE_ID = std::hash<std::string_view>{}("SceneDrawSystemsManager/RenderTargetResource");
+        // Declares what every ported system reads & writes, barriers between them are left to the graph. Uploads copied by the frame's
+        // own command buffer are waited on where geometry is read.
+        void buildRenderGraph(float deltaTime, Resources::Scene &scene, Resources::RenderTargetResource &renderTarget, bool geometryCopied);
+
         Resources::ContextResources &m_contextResources;
 
         Systems::ScreenClearingSystem screenClearingSystem;
+        Systems::MeshCullingSystem meshCullingSystem;
         Systems::MeshDrawingSystem meshDrawingSystem;
         Systems::GizmoDrawingSystem gizmoDrawingSystem;
         Systems::UIDrawingSystem uiDrawingSystem;
         Systems::PresentSystem presentSystem;
 
+        // Rebuilt every frame, keeps its allocations.
+        RenderGraph m_renderGraph;
+
         // That is temporary, need a place for that. This is per frame in flight.
         std::vector<Resources::VkCommandPoolResource> m_commandPools = {};
-        std::vector<VkSemaphore> m_updateSemaphores = {};
-        std::vector<VkSemaphore> m_renderSemaphores = {};
     };
 
 } // namespace Prism::Managers
\ No newline at end of file
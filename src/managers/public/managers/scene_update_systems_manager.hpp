@@ -3,6 +3,7 @@
 #include "systems/camera_creation_system.hpp"
 #include "systems/common_uniform_update_system.hpp"
 #include "systems/fps_motion_control_system.hpp"
+#include "systems/transform_system.hpp"
 
 #include "resources/context_resources.hpp"
 #include "resources/scene.hpp"
@@ -28,6 +29,7 @@ namespace Prism::Managers {
       private:
         Systems::CameraCreationSystem cameraCreationSystem;
         Systems::FpsMotionControlSystem fpsMotionControlSystem;
+        Systems::TransformSystem transformSystem;
         Systems::CommonUniformUpdateSystem commonUniformUpdateSystem;
     };
 } // namespace Prism::Managers
\ No newline at end of file
@@ -0,0 +1,337 @@
+#include "managers/render_graph.hpp"
+
+#include "utils/profiler.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace Prism::Managers {
+    namespace {
+        constexpr VkAccessFlags2 WRITE_ACCESS_MASK = VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT |
+                                                     VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT |
+                                                     VK_ACCESS_2_TRANSFER_WRITE_BIT | VK_ACCESS_2_HOST_WRITE_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT;
+    } // namespace
+
+    void RenderGraph::PassBuilder::Read(ResourceId resource, Usage usage) { addAccess(resource, usage, true, false); }
+
+    void RenderGraph::PassBuilder::Write(ResourceId resource, Usage usage) { addAccess(resource, usage, false, true); }
+
+    void RenderGraph::PassBuilder::ReadWrite(ResourceId resource, Usage usage) { addAccess(resource, usage, true, true); }
+
+    void RenderGraph::PassBuilder::SetSideEffect() { m_renderGraph.m_passes[m_passIndex].sideEffect = true; }
+
+    void RenderGraph::PassBuilder::addAccess(ResourceId resource, Usage usage, bool reads, bool writes) {
+        auto &pass = m_renderGraph.m_passes[m_passIndex];
+
+        if (resource >= m_renderGraph.m_resources.size()) {
+            throw std::runtime_error("Render graph pass " + pass.name + " uses an unknown resource!");
+        }
+
+        // A single barrier can only move a resource to one layout, so every pass declares one combined use.
+        auto sameResource = [resource](const Access &access) { return access.resource == resource; };
+        if (std::any_of(pass.accesses.begin(), pass.accesses.end(), sameResource)) {
+            throw std::runtime_error("Render graph pass " + pass.name + " uses " + m_renderGraph.m_resources[resource].name + " more than once!");
+        }
+
+        pass.accesses.push_back({resource, usage, reads, writes});
+    }
+
+    RenderGraph::ResourceId RenderGraph::ImportImage(std::string_view name, VkImage image, VkImageAspectFlags aspectMask, Usage initialUsage) {
+        m_resources.push_back({.name = std::string(name), .image = image, .aspectMask = aspectMask, .initialUsage = initialUsage});
+        m_compiled = false;
+        return static_cast<ResourceId>(m_resources.size() - 1);
+    }
+
+    RenderGraph::ResourceId RenderGraph::ImportBuffer(std::string_view name, VkBuffer buffer, Usage initialUsage, VkDeviceSize offset, VkDeviceSize size) {
+        m_resources.push_back({.name = std::string(name), .buffer = buffer, .offset = offset, .size = size, .initialUsage = initialUsage});
+        m_compiled = false;
+        return static_cast<ResourceId>(m_resources.size() - 1);
+    }
+
+    void RenderGraph::MarkOutput(ResourceId resource, std::optional<Usage> finalUsage) {
+        if (resource >= m_resources.size()) {
+            throw std::runtime_error("Render graph output is an unknown resource!");
+        }
+
+        m_resources[resource].output = true;
+        m_resources[resource].finalUsage = finalUsage;
+        m_compiled = false;
+    }
+
+    void RenderGraph::AddPass(std::string_view name, const SetupCallback &setup, ExecuteCallback execute) {
+        m_passes.push_back({.name = std::string(name), .execute = std::move(execute)});
+        m_compiled = false;
+
+        PassBuilder builder{*this, static_cast<uint32_t>(m_passes.size() - 1)};
+        setup(builder);
+    }
+
+    void RenderGraph::Compile() {
+        PRISM_PROFILE_SCOPE("RenderGraph::Compile");
+
+        sortPasses();
+        cullPasses();
+
+        m_imageBarriers.clear();
+        m_bufferBarriers.clear();
+
+        std::vector<ResourceState> states(m_resources.size());
+        for (size_t i = 0; i < m_resources.size(); i++) {
+            const auto &initialUsage = m_resources[i].initialUsage;
+            states[i].layout = initialUsage.layout;
+            // Whatever happened before the graph is waited on by the first use, reads included.
+            states[i].writeStageMask = initialUsage.stageMask;
+            states[i].writeAccessMask = initialUsage.accessMask & WRITE_ACCESS_MASK;
+        }
+
+        auto beginBatch = [this]() {
+            return BarrierBatch{.firstImageBarrier = static_cast<uint32_t>(m_imageBarriers.size()),
+                                .firstBufferBarrier = static_cast<uint32_t>(m_bufferBarriers.size())};
+        };
+        auto endBatch = [this](BarrierBatch &batch) {
+            batch.imageBarrierCount = static_cast<uint32_t>(m_imageBarriers.size()) - batch.firstImageBarrier;
+            batch.bufferBarrierCount = static_cast<uint32_t>(m_bufferBarriers.size()) - batch.firstBufferBarrier;
+        };
+
+        for (auto &pass : m_passes) {
+            if (pass.culled) {
+                continue;
+            }
+
+            pass.barriers = beginBatch();
+            for (const auto &access : pass.accesses) {
+                addBarrier(access.resource, states[access.resource], access.usage, access.writes);
+            }
+            endBatch(pass.barriers);
+        }
+
+        m_finalBarriers = beginBatch();
+        for (ResourceId resource = 0; resource < m_resources.size(); resource++) {
+            if (m_resources[resource].finalUsage) {
+                addBarrier(resource, states[resource], *m_resources[resource].finalUsage, false);
+            }
+        }
+        endBatch(m_finalBarriers);
+
+        m_compiled = true;
+    }
+
+    void RenderGraph::Execute(VkCommandBuffer commandBuffer) {
+        PRISM_PROFILE_SCOPE("RenderGraph::Execute");
+
+        if (!m_compiled) {
+            throw std::runtime_error("Render graph has to be compiled before it is executed!");
+        }
+
+        for (const auto &pass : m_passes) {
+            if (pass.culled) {
+                continue;
+            }
+
+            recordBarriers(commandBuffer, pass.barriers);
+            pass.execute(commandBuffer);
+        }
+
+        recordBarriers(commandBuffer, m_finalBarriers);
+    }
+
+    void RenderGraph::Reset() {
+        m_resources.clear();
+        m_passes.clear();
+        m_imageBarriers.clear();
+        m_bufferBarriers.clear();
+        m_finalBarriers = {};
+        m_compiled = false;
+    }
+
+    size_t RenderGraph::GetCulledPassCount() const {
+        return static_cast<size_t>(std::count_if(m_passes.begin(), m_passes.end(), [](const Pass &pass) { return pass.culled; }));
+    }
+
+    void RenderGraph::sortPasses() {
+        const size_t passCount = m_passes.size();
+
+        // Position of a use within the frame, see the class comment.
+        auto getPhase = [](const Access &access) { return access.reads ? (access.writes ? 1 : 2) : 0; };
+
+        // Row of a pass holds the passes that have to run after it.
+        m_passDependencies.assign(passCount * passCount, 0);
+        m_passDependencyCounts.assign(passCount, 0);
+        auto addDependency = [this, passCount](size_t first, size_t second) {
+            if (m_passDependencies[first * passCount + second] == 0) {
+                m_passDependencies[first * passCount + second] = 1;
+                m_passDependencyCounts[second]++;
+            }
+        };
+
+        for (size_t earlier = 0; earlier < passCount; earlier++) {
+            for (size_t later = earlier + 1; later < passCount; later++) {
+                for (const auto &earlierAccess : m_passes[earlier].accesses) {
+                    for (const auto &laterAccess : m_passes[later].accesses) {
+                        if (earlierAccess.resource != laterAccess.resource) {
+                            continue;
+                        }
+
+                        const int earlierPhase = getPhase(earlierAccess);
+                        const int laterPhase = getPhase(laterAccess);
+                        if (earlierPhase < laterPhase || (earlierPhase == laterPhase && earlierPhase != 2)) {
+                            addDependency(earlier, later);
+                        } else if (laterPhase < earlierPhase) {
+                            addDependency(later, earlier);
+                        }
+                    }
+                }
+            }
+        }
+
+        // Picks the first added pass whose dependencies already run, so independent passes keep their order. Placed passes are
+        // marked by an impossible dependency count.
+        constexpr uint32_t PLACED = UINT32_MAX;
+        m_passOrder.clear();
+        for (size_t step = 0; step < passCount; step++) {
+            size_t next = 0;
+            while (next < passCount && m_passDependencyCounts[next] != 0) {
+                next++;
+            }
+
+            if (next == passCount) {
+                auto unplaced = std::find_if(m_passDependencyCounts.begin(), m_passDependencyCounts.end(), [](uint32_t count) { return count != PLACED; });
+                throw std::runtime_error("Render graph pass " + m_passes[unplaced - m_passDependencyCounts.begin()].name + " is part of a dependency cycle!");
+            }
+
+            m_passDependencyCounts[next] = PLACED;
+            for (size_t dependent = 0; dependent < passCount; dependent++) {
+                if (m_passDependencies[next * passCount + dependent] != 0) {
+                    m_passDependencyCounts[dependent]--;
+                }
+            }
+            m_passOrder.push_back(static_cast<uint32_t>(next));
+        }
+
+        m_sortedPasses.clear();
+        for (auto passIndex : m_passOrder) {
+            m_sortedPasses.push_back(std::move(m_passes[passIndex]));
+        }
+        std::swap(m_passes, m_sortedPasses);
+        m_sortedPasses.clear();
+    }
+
+    void RenderGraph::cullPasses() {
+        // Walks passes backwards, a pass is kept when a later kept pass or the frame output needs something it writes.
+        std::vector<uint8_t> needed(m_resources.size(), 0);
+        for (size_t i = 0; i < m_resources.size(); i++) {
+            needed[i] = m_resources[i].output ? 1 : 0;
+        }
+
+        for (auto pass = m_passes.rbegin(); pass != m_passes.rend(); ++pass) {
+            bool kept = pass->sideEffect;
+            for (const auto &access : pass->accesses) {
+                kept |= access.writes && needed[access.resource] != 0;
+            }
+
+            pass->culled = !kept;
+            if (!kept) {
+                continue;
+            }
+
+            // Contents overwritten by this pass aren't needed from earlier ones, contents it reads are.
+            for (const auto &access : pass->accesses) {
+                if (access.writes && !access.reads) {
+                    needed[access.resource] = 0;
+                }
+            }
+            for (const auto &access : pass->accesses) {
+                if (access.reads) {
+                    needed[access.resource] = 1;
+                }
+            }
+        }
+    }
+
+    void RenderGraph::addBarrier(ResourceId resource, ResourceState &state, const Usage &usage, bool writes) {
+        const auto &graphResource = m_resources[resource];
+        const bool isImage = graphResource.image != VK_NULL_HANDLE;
+        const bool layoutChange = isImage && usage.layout != state.layout;
+
+        VkPipelineStageFlags2 srcStageMask = VK_PIPELINE_STAGE_2_NONE;
+        VkAccessFlags2 srcAccessMask = VK_ACCESS_2_NONE;
+
+        if (layoutChange || writes) {
+            // Has to wait for every earlier use, earlier reads only need an execution dependency.
+            srcStageMask = state.writeStageMask | state.readStageMask;
+            srcAccessMask = state.writeAccessMask;
+        } else {
+            // Reads of data already visible to their scope share the barrier of the first one.
+            const bool visible = (usage.stageMask & ~state.visibleStageMask) == 0 && (usage.accessMask & ~state.visibleAccessMask) == 0;
+            if (!visible) {
+                srcStageMask = state.writeStageMask;
+                srcAccessMask = state.writeAccessMask;
+            }
+        }
+
+        if (srcStageMask != VK_PIPELINE_STAGE_2_NONE || srcAccessMask != VK_ACCESS_2_NONE || layoutChange) {
+            if (isImage) {
+                VkImageMemoryBarrier2 barrier{};
+                barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+                barrier.srcStageMask = srcStageMask;
+                barrier.srcAccessMask = srcAccessMask;
+                barrier.dstStageMask = usage.stageMask;
+                barrier.dstAccessMask = usage.accessMask;
+                barrier.oldLayout = state.layout;
+                barrier.newLayout = usage.layout;
+                barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                barrier.image = graphResource.image;
+                barrier.subresourceRange.aspectMask = graphResource.aspectMask;
+                barrier.subresourceRange.baseMipLevel = 0;
+                barrier.subresourceRange.levelCount = VK_REMAINING_MIP_LEVELS;
+                barrier.subresourceRange.baseArrayLayer = 0;
+                barrier.subresourceRange.layerCount = VK_REMAINING_ARRAY_LAYERS;
+                m_imageBarriers.push_back(barrier);
+            } else {
+                VkBufferMemoryBarrier2 barrier{};
+                barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+                barrier.srcStageMask = srcStageMask;
+                barrier.srcAccessMask = srcAccessMask;
+                barrier.dstStageMask = usage.stageMask;
+                barrier.dstAccessMask = usage.accessMask;
+                barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                barrier.buffer = graphResource.buffer;
+                barrier.offset = graphResource.offset;
+                barrier.size = graphResource.size;
+                m_bufferBarriers.push_back(barrier);
+            }
+        }
+
+        if (layoutChange || writes) {
+            // Layout transition is a write of its own, done by the barrier & visible to its destination scope.
+            state.layout = isImage ? usage.layout : state.layout;
+            state.writeStageMask = usage.stageMask;
+            state.writeAccessMask = writes ? usage.accessMask & WRITE_ACCESS_MASK : VK_ACCESS_2_NONE;
+            state.readStageMask = writes ? VK_PIPELINE_STAGE_2_NONE : usage.stageMask;
+            state.visibleStageMask = writes ? VK_PIPELINE_STAGE_2_NONE : usage.stageMask;
+            state.visibleAccessMask = writes ? VK_ACCESS_2_NONE : usage.accessMask;
+        } else {
+            state.readStageMask |= usage.stageMask;
+            state.visibleStageMask |= usage.stageMask;
+            state.visibleAccessMask |= usage.accessMask;
+        }
+    }
+
+    void RenderGraph::recordBarriers(VkCommandBuffer commandBuffer, const BarrierBatch &batch) const {
+        if (batch.imageBarrierCount == 0 && batch.bufferBarrierCount == 0) {
+            return;
+        }
+
+        VkDependencyInfo dependencyInfo{};
+        dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+        dependencyInfo.imageMemoryBarrierCount = batch.imageBarrierCount;
+        dependencyInfo.pImageMemoryBarriers = batch.imageBarrierCount > 0 ? &m_imageBarriers[batch.firstImageBarrier] : nullptr;
+        dependencyInfo.bufferMemoryBarrierCount = batch.bufferBarrierCount;
+        dependencyInfo.pBufferMemoryBarriers = batch.bufferBarrierCount > 0 ? &m_bufferBarriers[batch.firstBufferBarrier] : nullptr;
+
+        vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+    }
+} // namespace Prism::Managers
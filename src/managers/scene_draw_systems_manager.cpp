@@ -1,22 +1,11 @@
 #include "managers/scene_draw_systems_manager.hpp"
 
-namespace Prism::Managers {
-    namespace {
-        std::vector<VkSemaphore> createSemaphores(VkDevice device, size_t count) {
-            std::vector<VkSemaphore> semaphores(count);
-
-            VkSemaphoreCreateInfo semaphoreInfo{};
-            semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
-
-            for (auto &sem : semaphores) {
-                if (vkCreateSemaphore(device, &semaphoreInfo, nullptr, &sem) != VK_SUCCESS) {
-                    throw std::runtime_error("Failed to create semaphore!");
-                }
-            }
+#include "utils/profiler.hpp"
 
-            return semaphores;
-        }
+#include <optional>
 
+namespace Prism::Managers {
+    namespace {
         std::vector<Resources::VkCommandPoolResource> createCommandPools(VkDevice device, uint32_t graphicsQueueFamilyIndex, size_t count) {
             std::vector<Resources::VkCommandPoolResource> pools;
             pools.reserve(count);
@@ -30,33 +19,21 @@ namespace Prism::Managers {
 
     } // namespace
 
-    SceneDrawSystemsManager::SceneDrawSystemsManager(Resources::ContextResources &contextResources)
-        : m_contextResources(contextResources), screenClearingSystem{contextResources}, meshDrawingSystem{contextResources}, uiDrawingSystem{contextResources},
-          presentSystem{contextResources}, gizmoDrawingSystem{contextResources} {
+    SceneDrawSystemsManager::SceneDrawSystemsManager(Resources::ContextResources &contextResources, bool perVertexNormalMatrix)
+        : m_contextResources(contextResources), screenClearingSystem{contextResources}, meshCullingSystem{contextResources},
+          meshDrawingSystem{contextResources, perVertexNormalMatrix}, gizmoDrawingSystem{contextResources}, uiDrawingSystem{contextResources},
+          presentSystem{contextResources} {
         auto &vulkanResource = m_contextResources.GetVulkanResource();
         auto device = vulkanResource.GetDevice();
         auto graphicsQueueFamilyIndex = vulkanResource.GetGraphicsQueueFamilyIndex();
         auto framesInFlight = vulkanResource.GetFramesInFlight();
 
         m_commandPools = createCommandPools(device, graphicsQueueFamilyIndex, framesInFlight);
-
-        m_updateSemaphores = createSemaphores(device, framesInFlight);
-        m_renderSemaphores = createSemaphores(device, framesInFlight);
-    }
-
-    SceneDrawSystemsManager::~SceneDrawSystemsManager() {
-        auto &vulkanResource = m_contextResources.GetVulkanResource();
-
-        for (auto &sem : m_updateSemaphores) {
-            vkDestroySemaphore(vulkanResource.GetDevice(), sem, nullptr);
-        }
-        for (auto &sem : m_renderSemaphores) {
-            vkDestroySemaphore(vulkanResource.GetDevice(), sem, nullptr);
-        }
     }
 
     void SceneDrawSystemsManager::Initialize() {
         screenClearingSystem.Initialize();
+        meshCullingSystem.Initialize();
         meshDrawingSystem.Initialize();
         gizmoDrawingSystem.Initialize();
         uiDrawingSystem.Initialize();
@@ -64,100 +41,266 @@ namespace Prism::Managers {
     }
 
     void SceneDrawSystemsManager::Update(float deltaTime, Resources::Scene &scene, Resources::VkStagingBufferResource &stagingBuffer) {
-        auto &vulkanResource = m_contextResources.GetVulkanResource();
-        auto &swapchainBoundResourceStorage = vulkanResource.GetSwapchainBoundStorage();
+        PRISM_PROFILE_SCOPE("SceneDrawSystemsManager::Update");
 
-        auto &currentCommandPoolResource = m_commandPools.at(vulkanResource.GetCurrentFrameOffset());
-        auto &currentUpdateSemaphore = m_updateSemaphores.at(vulkanResource.GetCurrentFrameOffset());
-        auto &currentRenderSemaphore = m_renderSemaphores.at(vulkanResource.GetCurrentFrameOffset());
-        auto imageAcquiredSemaphore = vulkanResource.GetCurrentImageAcquiredSemaphore();
-        auto currentFence = vulkanResource.GetCurrentFence();
+        auto &vulkanResource = m_contextResources.GetVulkanResource();
 
         // This could be probably moved to frame swap system.
         vulkanResource.AdvanceFrame();
 
-        auto renderTargetOpt =
-            swapchainBoundResourceStorage.Get<Resources::RenderTargetResource>(RENDER_TARGET_RESOURCE_ID, vulkanResource.GetCurrentImageIndex());
-        if (!renderTargetOpt) {
-            uint32_t flags = 0;
-            flags |= Resources::RenderTargetResource::RenderTargetCreationFlags::COLOR_ATTACHMENT;
-            flags |= Resources::RenderTargetResource::RenderTargetCreationFlags::DEPTH_STENCIL_ATTACHMENT;
+        auto currentFrameOffset = vulkanResource.GetCurrentFrameOffset();
+        auto frameNumber = vulkanResource.GetFrameNumber();
+        auto &currentCommandPoolResource = m_commandPools.at(currentFrameOffset);
 
-            auto renderTarget = std::make_unique<Resources::RenderTargetResource>(vulkanResource.GetDevice(), vulkanResource.GetVmaAllocator(),
-                                                                                  vulkanResource.GetSwapchainExtent(), flags);
+        // Previous frame of this slot has finished, so its GPU timings can be read without stalling.
+        m_contextResources.GetGpuProfilerResource().BeginFrame(currentFrameOffset);
 
-            swapchainBoundResourceStorage.Insert<Resources::RenderTargetResource>(RENDER_TARGET_RESOURCE_ID, std::move(renderTarget),
-                                                                                  vulkanResource.GetCurrentImageIndex());
-            renderTargetOpt =
-                swapchainBoundResourceStorage.Get<Resources::RenderTargetResource>(RENDER_TARGET_RESOURCE_ID, vulkanResource.GetCurrentImageIndex());
-        }
-        auto &renderTarget = renderTargetOpt->get();
+        // Releases geometry of meshes removed before the last frame the GPU has finished.
+        m_contextResources.GetGeometryPoolResource().BeginFrame(frameNumber, vulkanResource.GetCompletedFrameNumber());
+
+        // Copies deferred for lack of staging space are staged into chunks retired since.
+        stagingBuffer.BeginFrame(vulkanResource.GetCompletedFrameNumber());
+
+        // Previous frame of the slot has finished, so its target can be recreated when the swapchain outgrew it.
+        auto &renderTarget = m_contextResources.GetRenderTargetPoolResource().Acquire(currentFrameOffset, vulkanResource.GetSwapchainExtent());
 
         currentCommandPoolResource.Reset();
 
+        // Whole frame is recorded into one command buffer and submitted once.
+        auto commandBuffersScope = currentCommandPoolResource.BeginScope();
+        auto commandBuffer = commandBuffersScope.GetNextCommandBuffer();
+
+        VkCommandBufferBeginInfo beginInfo{};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        vkBeginCommandBuffer(commandBuffer, &beginInfo);
+
+        // Value of the transfer timeline the frame has to wait for, when uploads went through the transfer queue.
+        std::optional<uint64_t> transferValue;
+        // Whether uploads were copied by this command buffer instead.
+        bool geometryCopied = false;
+
         { // Update
-            auto commandBuffersScope = currentCommandPoolResource.BeginScope();
-
-            screenClearingSystem.Update(deltaTime, commandBuffersScope.GetNextCommandBuffer(), scene);
-            meshDrawingSystem.Update(deltaTime, commandBuffersScope.GetNextCommandBuffer(), scene);
-            uiDrawingSystem.Update(deltaTime, commandBuffersScope.GetNextCommandBuffer(), scene);
-            gizmoDrawingSystem.Update(deltaTime, commandBuffersScope.GetNextCommandBuffer(), scene);
-            presentSystem.Update(deltaTime, commandBuffersScope.GetNextCommandBuffer(), scene);
-
-            stagingBuffer.Commit(commandBuffersScope.GetNextCommandBuffer());
-
-            VkSubmitInfo submitInfo{};
-            submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-            submitInfo.waitSemaphoreCount = 0;
-            submitInfo.pWaitSemaphores = nullptr;
-            VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_ALL_COMMANDS_BIT};
-            submitInfo.pWaitDstStageMask = waitStages;
-            submitInfo.commandBufferCount = static_cast<uint32_t>(commandBuffersScope.size());
-            submitInfo.pCommandBuffers = commandBuffersScope.data();
-            submitInfo.signalSemaphoreCount = 1;
-            submitInfo.pSignalSemaphores = &currentUpdateSemaphore;
-
-            vkQueueSubmit(vulkanResource.GetGraphicsQueue(), 1, &submitInfo, VK_NULL_HANDLE);
+            bool updateRecorded = false;
+            updateRecorded |= screenClearingSystem.Update(deltaTime, commandBuffer, scene);
+            updateRecorded |= meshCullingSystem.Update(deltaTime, commandBuffer, scene);
+            updateRecorded |= meshDrawingSystem.Update(deltaTime, commandBuffer, scene);
+            updateRecorded |= uiDrawingSystem.Update(deltaTime, commandBuffer, scene);
+            updateRecorded |= gizmoDrawingSystem.Update(deltaTime, commandBuffer, scene);
+            updateRecorded |= presentSystem.Update(deltaTime, commandBuffer, scene);
+
+            // Uploads overlap with rendering on a dedicated transfer queue, the frame only waits for them where geometry is read. Frames
+            // without uploads still commit, so staging stats of every frame are collected.
+            auto &transferQueueResource = m_contextResources.GetTransferQueueResource();
+            if (transferQueueResource.IsAvailable() && !stagingBuffer.GetPendingCopies().empty()) {
+                transferValue = transferQueueResource.Submit(stagingBuffer, commandBuffer, currentFrameOffset, frameNumber);
+            } else {
+                PRISM_PROFILE_SCOPE("VkStagingBufferResource::Commit");
+                geometryCopied = stagingBuffer.Commit(commandBuffer, frameNumber);
+            }
+
+            // Uploads are synchronized by the render graph, only work recorded by systems themselves has to finish before rendering.
+            if (updateRecorded) {
+                VkMemoryBarrier2 barrier{};
+                barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+                barrier.srcStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+                barrier.srcAccessMask = VK_ACCESS_2_MEMORY_WRITE_BIT;
+                barrier.dstStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+                barrier.dstAccessMask = VK_ACCESS_2_MEMORY_READ_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT;
+
+                VkDependencyInfo dependencyInfo{};
+                dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+                dependencyInfo.memoryBarrierCount = 1;
+                dependencyInfo.pMemoryBarriers = &barrier;
+                vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+            }
         }
 
         { // Render
-            auto commandBuffersScope = currentCommandPoolResource.BeginScope();
-
-            screenClearingSystem.Render(deltaTime, commandBuffersScope.GetNextCommandBuffer(), scene, renderTarget);
-            meshDrawingSystem.Render(deltaTime, commandBuffersScope.GetNextCommandBuffer(), scene, renderTarget);
-            uiDrawingSystem.Render(deltaTime, commandBuffersScope.GetNextCommandBuffer(), scene, renderTarget);
-            gizmoDrawingSystem.Render(deltaTime, commandBuffersScope.GetNextCommandBuffer(), scene, renderTarget);
-            presentSystem.Render(deltaTime, commandBuffersScope.GetNextCommandBuffer(), scene, renderTarget);
-
-            VkSubmitInfo submitInfo{};
-            submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-            VkSemaphore waitSemaphores[] = {currentUpdateSemaphore, imageAcquiredSemaphore};
-            VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
-            submitInfo.waitSemaphoreCount = 2;
-            submitInfo.pWaitSemaphores = waitSemaphores;
-            submitInfo.pWaitDstStageMask = waitStages;
-            submitInfo.commandBufferCount = static_cast<uint32_t>(commandBuffersScope.size());
-            submitInfo.pCommandBuffers = commandBuffersScope.data();
-            submitInfo.signalSemaphoreCount = 1;
-            VkSemaphore signalSemaphores[] = {currentRenderSemaphore};
-            submitInfo.pSignalSemaphores = signalSemaphores;
-
-            vkQueueSubmit(vulkanResource.GetGraphicsQueue(), 1, &submitInfo, currentFence);
+            gizmoDrawingSystem.Render(deltaTime, commandBuffer, scene, renderTarget);
+
+            buildRenderGraph(deltaTime, scene, renderTarget, geometryCopied);
+            m_renderGraph.Execute(commandBuffer);
+        }
+
+        vkEndCommandBuffer(commandBuffer);
+
+        // Update & draw systems are done writing transient uniforms of this frame.
+        m_contextResources.GetUniformRingResource().Flush();
+
+        { // Submit
+            // In headless mode no swapchain image is acquired and nothing waits for the render to be presented.
+            const bool headless = vulkanResource.IsHeadless();
+
+            VkCommandBufferSubmitInfo commandBufferInfo{};
+            commandBufferInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
+            commandBufferInfo.commandBuffer = commandBuffer;
+
+            VkSemaphoreSubmitInfo waitSemaphoreInfos[2] = {};
+            uint32_t waitSemaphoreInfoCount = 0;
+            if (!headless) {
+                auto &waitSemaphoreInfo = waitSemaphoreInfos[waitSemaphoreInfoCount++];
+                waitSemaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+                waitSemaphoreInfo.semaphore = vulkanResource.GetCurrentImageAcquiredSemaphore();
+                waitSemaphoreInfo.stageMask = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+            }
+            if (transferValue) {
+                auto &waitSemaphoreInfo = waitSemaphoreInfos[waitSemaphoreInfoCount++];
+                waitSemaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+                waitSemaphoreInfo.semaphore = m_contextResources.GetTransferQueueResource().GetTimelineSemaphore();
+                waitSemaphoreInfo.value = *transferValue;
+                waitSemaphoreInfo.stageMask = Resources::VkTransferQueueResource::ACQUIRE_STAGE_MASK;
+            }
+
+            // Timeline value marks the whole frame as finished, presentation waits on its own binary semaphore.
+            VkSemaphoreSubmitInfo signalSemaphoreInfos[2] = {};
+            signalSemaphoreInfos[0].sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+            signalSemaphoreInfos[0].semaphore = vulkanResource.GetFrameTimelineSemaphore();
+            signalSemaphoreInfos[0].value = frameNumber;
+            signalSemaphoreInfos[0].stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+            signalSemaphoreInfos[1].sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+            signalSemaphoreInfos[1].semaphore = headless ? VK_NULL_HANDLE : vulkanResource.GetCurrentRenderFinishedSemaphore();
+            signalSemaphoreInfos[1].stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+
+            VkSubmitInfo2 submitInfo{};
+            submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
+            submitInfo.waitSemaphoreInfoCount = waitSemaphoreInfoCount;
+            submitInfo.pWaitSemaphoreInfos = waitSemaphoreInfos;
+            submitInfo.commandBufferInfoCount = 1;
+            submitInfo.pCommandBufferInfos = &commandBufferInfo;
+            submitInfo.signalSemaphoreInfoCount = headless ? 1 : 2;
+            submitInfo.pSignalSemaphoreInfos = signalSemaphoreInfos;
+
+            PRISM_PROFILE_SCOPE("SceneDrawSystemsManager::Submit");
+            vkQueueSubmit2(vulkanResource.GetGraphicsQueue(), 1, &submitInfo, VK_NULL_HANDLE);
         }
 
-        { // Present
+        if (!vulkanResource.IsHeadless()) { // Present
             auto currentImageIndex = vulkanResource.GetCurrentImageIndex();
 
             VkPresentInfoKHR presentInfo{};
             presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+            VkSemaphore renderFinishedSemaphore = vulkanResource.GetCurrentRenderFinishedSemaphore();
             presentInfo.waitSemaphoreCount = 1;
-            presentInfo.pWaitSemaphores = &currentRenderSemaphore;
+            presentInfo.pWaitSemaphores = &renderFinishedSemaphore;
             VkSwapchainKHR swapchains[] = {vulkanResource.GetSwapchain()};
             presentInfo.swapchainCount = 1;
             presentInfo.pSwapchains = swapchains;
             presentInfo.pImageIndices = &currentImageIndex;
 
+            PRISM_PROFILE_SCOPE("SceneDrawSystemsManager::Present");
             vkQueuePresentKHR(vulkanResource.GetPresentationQueue(), &presentInfo);
         }
     }
+
+    void SceneDrawSystemsManager::buildRenderGraph(float deltaTime, Resources::Scene &scene, Resources::RenderTargetResource &renderTarget,
+                                                   bool geometryCopied) {
+        PRISM_PROFILE_SCOPE("SceneDrawSystemsManager::BuildRenderGraph");
+
+        using Usage = RenderGraph::Usage;
+
+        auto &vulkanResource = m_contextResources.GetVulkanResource();
+
+        m_renderGraph.Reset();
+
+        // Contents of the previous frame are cleared, but its writes & copies out of the target are still waited on.
+        auto colorTarget = m_renderGraph.ImportImage(
+            "RenderTarget/Color", renderTarget.GetColorImage(), VK_IMAGE_ASPECT_COLOR_BIT,
+            Usage{VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_2_COPY_BIT, VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT});
+        // Depth format has a stencil aspect, both are transitioned together.
+        auto depthTarget = m_renderGraph.ImportImage(
+            "RenderTarget/Depth", renderTarget.GetDepthImage(), VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT,
+            Usage{RenderGraph::DEPTH_STENCIL_ATTACHMENT.stageMask, VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT});
+
+        // Copies out of the staging buffer are the only writes of geometry within the frame. Uploads through the transfer queue were
+        // already acquired at vertex input, older ones are covered by the frame timeline.
+        auto &geometryPool = m_contextResources.GetGeometryPoolResource();
+        const Usage geometryUsage = geometryCopied ? Usage{VK_PIPELINE_STAGE_2_COPY_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT} : Usage{};
+        auto vertexBuffer = m_renderGraph.ImportBuffer("GeometryPool/Vertices", geometryPool.GetVertexBuffer().GetBuffer(), geometryUsage);
+        auto indexBuffer = m_renderGraph.ImportBuffer("GeometryPool/Indices", geometryPool.GetIndexBuffer().GetBuffer(), geometryUsage);
+
+        // Draw lists written on the CPU live in host memory written before the submit, only GPU culled ones are tracked. Buffers of a draw
+        // list were last used by the frame of its slot, which has finished.
+        auto &drawList = meshCullingSystem.GetDrawList();
+        std::optional<RenderGraph::ResourceId> drawInstances;
+        std::optional<RenderGraph::ResourceId> drawCommands;
+        std::optional<RenderGraph::ResourceId> drawStatistics;
+        if (drawList.gpuCulled) {
+            auto importRange = [&](std::string_view name, const Resources::BufferRange &range) {
+                return m_renderGraph.ImportBuffer(name, range.buffer, Usage{}, range.offset, range.size);
+            };
+            drawInstances = importRange("MeshDrawList/Instances", drawList.instanceBuffer.GetRange());
+            drawCommands = importRange("MeshDrawList/DrawCommands", drawList.drawCommandBuffer.GetRange());
+            drawStatistics = importRange("MeshDrawList/Statistics", drawList.statisticsBuffer.GetRange());
+
+            // Statistics are read back once the frame has finished.
+            m_renderGraph.MarkOutput(*drawStatistics, RenderGraph::HOST_READ);
+
+            m_renderGraph.AddPass(
+                "MeshCulling",
+                [&](RenderGraph::PassBuilder &builder) {
+                    builder.Write(*drawInstances, RenderGraph::COMPUTE_STORAGE);
+                    builder.Write(*drawCommands, RenderGraph::COMPUTE_STORAGE);
+                    // Visible draw count is accumulated on top of zero written by the host.
+                    builder.ReadWrite(*drawStatistics, RenderGraph::COMPUTE_STORAGE);
+                },
+                [this, deltaTime, &scene, &renderTarget](VkCommandBuffer commandBuffer) {
+                    meshCullingSystem.Render(deltaTime, commandBuffer, scene, renderTarget);
+                });
+        }
+
+        m_renderGraph.AddPass(
+            "ScreenClearing",
+            [&](RenderGraph::PassBuilder &builder) {
+                builder.Write(colorTarget, RenderGraph::COLOR_ATTACHMENT);
+            },
+            [this, deltaTime, &scene, &renderTarget](VkCommandBuffer commandBuffer) {
+                screenClearingSystem.Render(deltaTime, commandBuffer, scene, renderTarget);
+            });
+
+        m_renderGraph.AddPass(
+            "MeshDrawing",
+            [&](RenderGraph::PassBuilder &builder) {
+                builder.ReadWrite(colorTarget, RenderGraph::COLOR_ATTACHMENT);
+                // Depth is cleared by the pass itself.
+                builder.Write(depthTarget, RenderGraph::DEPTH_STENCIL_ATTACHMENT);
+                builder.Read(vertexBuffer, RenderGraph::VERTEX_BUFFER);
+                builder.Read(indexBuffer, RenderGraph::INDEX_BUFFER);
+                if (drawList.gpuCulled) {
+                    builder.Read(*drawInstances, RenderGraph::VERTEX_SHADER_STORAGE_READ);
+                    builder.Read(*drawCommands, RenderGraph::INDIRECT_BUFFER);
+                    // Visible draw count.
+                    builder.Read(*drawStatistics, RenderGraph::INDIRECT_BUFFER);
+                }
+            },
+            [this, deltaTime, &scene, &renderTarget](VkCommandBuffer commandBuffer) {
+                meshDrawingSystem.Render(deltaTime, commandBuffer, scene, renderTarget);
+            });
+
+        m_renderGraph.AddPass(
+            "UIDrawing", [&](RenderGraph::PassBuilder &builder) { builder.ReadWrite(colorTarget, RenderGraph::COLOR_ATTACHMENT); },
+            [this, deltaTime, &scene, &renderTarget](VkCommandBuffer commandBuffer) { uiDrawingSystem.Render(deltaTime, commandBuffer, scene, renderTarget); });
+
+        // Headless frame ends in the render target, there is no swapchain image to copy into.
+        if (vulkanResource.IsHeadless()) {
+            m_renderGraph.MarkOutput(colorTarget);
+        } else {
+            // Acquire semaphore is waited on at color attachment output, so the first transition of the image has to come after it.
+            auto swapchainImage = m_renderGraph.ImportImage("Swapchain", vulkanResource.GetRenderTargetImage(), VK_IMAGE_ASPECT_COLOR_BIT,
+                                                            Usage{VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_NONE});
+            m_renderGraph.MarkOutput(swapchainImage, RenderGraph::PRESENT);
+
+            m_renderGraph.AddPass(
+                "Present",
+                [&](RenderGraph::PassBuilder &builder) {
+                    builder.Read(colorTarget, RenderGraph::TRANSFER_SOURCE);
+                    builder.Write(swapchainImage, RenderGraph::TRANSFER_DESTINATION);
+                },
+                [this, deltaTime, &scene, &renderTarget](VkCommandBuffer commandBuffer) {
+                    presentSystem.Render(deltaTime, commandBuffer, scene, renderTarget);
+                });
+        }
+
+        m_renderGraph.Compile();
+    }
 } // namespace Prism::Managers
\ No newline at end of file
@@ -1,18 +1,26 @@
 #include "managers/scene_update_systems_manager.hpp"
 
+#include "utils/profiler.hpp"
+
 namespace Prism::Managers {
     SceneUpdateSystemsManager::SceneUpdateSystemsManager(Resources::ContextResources &contextResources)
-        : cameraCreationSystem{contextResources}, fpsMotionControlSystem{contextResources}, commonUniformUpdateSystem{contextResources} {}
+        : cameraCreationSystem{contextResources}, fpsMotionControlSystem{contextResources}, transformSystem{contextResources},
+          commonUniformUpdateSystem{contextResources} {}
 
     void SceneUpdateSystemsManager::Initialize() {
         cameraCreationSystem.Initialize();
         fpsMotionControlSystem.Initialize();
+        transformSystem.Initialize();
         commonUniformUpdateSystem.Initialize();
     }
 
     void SceneUpdateSystemsManager::Update(float deltaTime, Resources::Scene &scene) {
+        PRISM_PROFILE_SCOPE("SceneUpdateSystemsManager::Update");
+
         cameraCreationSystem.Update(deltaTime, scene);
         fpsMotionControlSystem.Update(deltaTime, scene);
+        // After everything that moves entities, before anything that reads world transforms.
+        transformSystem.Update(deltaTime, scene);
         commonUniformUpdateSystem.Update(deltaTime, scene);
     }
 } // namespace Prism::Managers
\ No newline at end of file
@@ -0,0 +1,134 @@
+#include "managers/render_graph.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Uses no stages or layouts, so the graph never records barriers and runs without a device.
+namespace {
+    using Prism::Managers::RenderGraph;
+
+    constexpr RenderGraph::Usage NO_SYNC = {};
+
+    int failures = 0;
+
+    void expect(bool condition, const std::string &message) {
+        if (!condition) {
+            std::cerr << "FAILED: " << message << std::endl;
+            failures++;
+        }
+    }
+
+    RenderGraph::ExecuteCallback record(std::vector<std::string> &order, std::string name) {
+        return [&order, name](VkCommandBuffer) { order.push_back(name); };
+    }
+
+    void passesAddedOutOfOrderRunAfterTheirInputs() {
+        RenderGraph renderGraph;
+        std::vector<std::string> order;
+
+        auto first = renderGraph.ImportBuffer("First", VK_NULL_HANDLE, NO_SYNC);
+        auto second = renderGraph.ImportBuffer("Second", VK_NULL_HANDLE, NO_SYNC);
+        auto output = renderGraph.ImportBuffer("Output", VK_NULL_HANDLE, NO_SYNC);
+        renderGraph.MarkOutput(output);
+
+        renderGraph.AddPass(
+            "Independent", [](RenderGraph::PassBuilder &builder) { builder.SetSideEffect(); }, record(order, "Independent"));
+        renderGraph.AddPass(
+            "Consume",
+            [&](RenderGraph::PassBuilder &builder) {
+                builder.Read(second, NO_SYNC);
+                builder.Write(output, NO_SYNC);
+            },
+            record(order, "Consume"));
+        renderGraph.AddPass(
+            "Transform",
+            [&](RenderGraph::PassBuilder &builder) {
+                builder.Read(first, NO_SYNC);
+                builder.Write(second, NO_SYNC);
+            },
+            record(order, "Transform"));
+        renderGraph.AddPass(
+            "Produce", [&](RenderGraph::PassBuilder &builder) { builder.Write(first, NO_SYNC); }, record(order, "Produce"));
+
+        renderGraph.Compile();
+        renderGraph.Execute(VK_NULL_HANDLE);
+
+        expect(order == std::vector<std::string>{"Independent", "Produce", "Transform", "Consume"}, "passes run after the passes writing their inputs");
+    }
+
+    void writesRunBeforeModificationsAndReads() {
+        RenderGraph renderGraph;
+        std::vector<std::string> order;
+
+        auto target = renderGraph.ImportBuffer("Target", VK_NULL_HANDLE, NO_SYNC);
+        auto output = renderGraph.ImportBuffer("Output", VK_NULL_HANDLE, NO_SYNC);
+        renderGraph.MarkOutput(output);
+
+        renderGraph.AddPass(
+            "Read",
+            [&](RenderGraph::PassBuilder &builder) {
+                builder.Read(target, NO_SYNC);
+                builder.Write(output, NO_SYNC);
+            },
+            record(order, "Read"));
+        renderGraph.AddPass(
+            "ModifyFirst", [&](RenderGraph::PassBuilder &builder) { builder.ReadWrite(target, NO_SYNC); }, record(order, "ModifyFirst"));
+        renderGraph.AddPass(
+            "ModifySecond", [&](RenderGraph::PassBuilder &builder) { builder.ReadWrite(target, NO_SYNC); }, record(order, "ModifySecond"));
+        renderGraph.AddPass(
+            "Write", [&](RenderGraph::PassBuilder &builder) { builder.Write(target, NO_SYNC); }, record(order, "Write"));
+
+        renderGraph.Compile();
+        renderGraph.Execute(VK_NULL_HANDLE);
+
+        expect(order == std::vector<std::string>{"Write", "ModifyFirst", "ModifySecond", "Read"},
+               "write runs first, modifications in the order they were added, reads last");
+    }
+
+    void cyclesAreRejected() {
+        RenderGraph renderGraph;
+
+        auto first = renderGraph.ImportBuffer("First", VK_NULL_HANDLE, NO_SYNC);
+        auto second = renderGraph.ImportBuffer("Second", VK_NULL_HANDLE, NO_SYNC);
+
+        renderGraph.AddPass(
+            "Forward",
+            [&](RenderGraph::PassBuilder &builder) {
+                builder.Read(first, NO_SYNC);
+                builder.Write(second, NO_SYNC);
+                builder.SetSideEffect();
+            },
+            [](VkCommandBuffer) {});
+        renderGraph.AddPass(
+            "Backward",
+            [&](RenderGraph::PassBuilder &builder) {
+                builder.Read(second, NO_SYNC);
+                builder.Write(first, NO_SYNC);
+                builder.SetSideEffect();
+            },
+            [](VkCommandBuffer) {});
+
+        bool thrown = false;
+        try {
+            renderGraph.Compile();
+        } catch (const std::runtime_error &) {
+            thrown = true;
+        }
+
+        expect(thrown, "passes depending on each other in a cycle are rejected");
+    }
+} // namespace
+
+int main() {
+    passesAddedOutOfOrderRunAfterTheirInputs();
+    writesRunBeforeModificationsAndReads();
+    cyclesAreRejected();
+
+    if (failures == 0) {
+        std::cout << "Render graph tests passed" << std::endl;
+    }
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,113 @@
+#include "resources/buffer_arena_resource.hpp"
+#include "utils/vulkan/common.hpp"
+
+#include <algorithm>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+namespace Prism::Resources {
+    namespace {
+        // Covers index, vertex & indirect offsets, which only need 4 bytes.
+        constexpr VkDeviceSize MIN_ALIGNMENT = 16;
+    } // namespace
+
+    BufferArenaResource::BufferArenaResource(VmaAllocator allocator, VkPhysicalDevice physicalDevice, VmaMemoryUsage memoryUsage, VkBufferUsageFlags usage,
+                                             VkDeviceSize blockSize)
+        : allocator(allocator), memoryUsage(memoryUsage), usage(usage), blockSize(blockSize) {
+        alignment = std::max(Utils::Vulkan::Common::getBufferOffsetAlignment(physicalDevice), MIN_ALIGNMENT);
+    }
+
+    BufferArenaResource::~BufferArenaResource() {
+        for (auto &block : blocks) {
+            if (block.mappedData != nullptr) {
+                vmaUnmapMemory(allocator, block.buffer.GetAllocation());
+            }
+            vmaDestroyVirtualBlock(block.virtualBlock);
+        }
+    }
+
+    BufferArenaResource::BufferArenaResource(BufferArenaResource &&other) noexcept { swap(*this, other); }
+
+    BufferArenaResource &BufferArenaResource::operator=(BufferArenaResource &&other) noexcept {
+        if (this != &other) {
+            swap(*this, other);
+        }
+        return *this;
+    }
+
+    void swap(BufferArenaResource &first, BufferArenaResource &second) noexcept {
+        using std::swap;
+        swap(first.allocator, second.allocator);
+        swap(first.memoryUsage, second.memoryUsage);
+        swap(first.usage, second.usage);
+        swap(first.blockSize, second.blockSize);
+        swap(first.alignment, second.alignment);
+        swap(first.blocks, second.blocks);
+    }
+
+    VkDeviceSize BufferArenaResource::GetReservedSize() const {
+        VkDeviceSize size = 0;
+        for (const auto &block : blocks) {
+            size += block.buffer.GetBufferSize();
+        }
+        return size;
+    }
+
+    VkBufferSuballocation BufferArenaResource::allocate(VkDeviceSize size) {
+        VmaVirtualAllocationCreateInfo allocationInfo{};
+        allocationInfo.size = std::max<VkDeviceSize>(size, 1);
+        allocationInfo.alignment = alignment;
+
+        auto suballocate = [&](Block &block) -> std::optional<VkBufferSuballocation> {
+            VmaVirtualAllocation virtualAllocation = VK_NULL_HANDLE;
+            VkDeviceSize offset = 0;
+            if (vmaVirtualAllocate(block.virtualBlock, &allocationInfo, &virtualAllocation, &offset) != VK_SUCCESS) {
+                return std::nullopt;
+            }
+
+            return VkBufferSuballocation{.range = {block.buffer.GetBuffer(), offset, size},
+                                         .virtualBlock = block.virtualBlock,
+                                         .virtualAllocation = virtualAllocation,
+                                         .allocator = allocator,
+                                         .blockAllocation = block.buffer.GetAllocation(),
+                                         .mappedData = block.mappedData != nullptr ? block.mappedData + offset : nullptr};
+        };
+
+        for (auto &block : blocks) {
+            if (auto suballocation = suballocate(block)) {
+                return *suballocation;
+            }
+        }
+
+        auto suballocation = suballocate(createBlock(std::max(blockSize, allocationInfo.size)));
+        if (!suballocation) {
+            throw std::runtime_error("Failed to suballocate from a new buffer arena block!");
+        }
+        return *suballocation;
+    }
+
+    BufferArenaResource::Block &BufferArenaResource::createBlock(VkDeviceSize size) {
+        Block block{};
+        block.buffer = VkBufferResource<>(allocator, size, usage, memoryUsage);
+
+        VmaVirtualBlockCreateInfo virtualBlockInfo{};
+        virtualBlockInfo.size = size;
+        if (vmaCreateVirtualBlock(&virtualBlockInfo, &block.virtualBlock) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create buffer arena virtual block!");
+        }
+
+        VkMemoryPropertyFlags memoryProperties = 0;
+        vmaGetAllocationMemoryProperties(allocator, block.buffer.GetAllocation(), &memoryProperties);
+        if (memoryProperties & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) {
+            void *data = nullptr;
+            if (vmaMapMemory(allocator, block.buffer.GetAllocation(), &data) != VK_SUCCESS) {
+                vmaDestroyVirtualBlock(block.virtualBlock);
+                throw std::runtime_error("Failed to map buffer arena block!");
+            }
+            block.mappedData = static_cast<std::byte *>(data);
+        }
+
+        return blocks.emplace_back(std::move(block));
+    }
+} // namespace Prism::Resources
@@ -5,6 +5,15 @@ namespace Prism::Resources {
     ContextResources::ContextResources(Resources::WindowResource &&windowResource, Resources::VulkanResource &&vulkanResource,
                                        Resources::ImGuiResource &&imguiResource)
         : dispatcher{}, windowResource(std::move(windowResource)), vulkanResource(std::move(vulkanResource)), imguiResource(std::move(imguiResource)),
+          gpuProfilerResource(this->vulkanResource.GetDevice(), this->vulkanResource.GetPhysicalDevice(), this->vulkanResource.GetGraphicsQueueFamilyIndex(),
+                              this->vulkanResource.GetFramesInFlight()),
+          geometryPoolResource(this->vulkanResource.GetVmaAllocator()),
+          uniformRingResource(this->vulkanResource.GetVmaAllocator(), this->vulkanResource.GetPhysicalDevice(), this->vulkanResource.GetFramesInFlight()),
+          renderTargetPoolResource(this->vulkanResource.GetDevice(), this->vulkanResource.GetVmaAllocator(), this->vulkanResource.GetFramesInFlight()),
+          transferQueueResource(this->vulkanResource.GetDevice(), this->vulkanResource.GetTransferQueue(), this->vulkanResource.GetTransferQueueFamilyIndex(),
+                                this->vulkanResource.GetGraphicsQueueFamilyIndex(), this->vulkanResource.GetFramesInFlight()),
+          hostBufferArenaResource(this->vulkanResource.GetVmaAllocator(), this->vulkanResource.GetPhysicalDevice(), VMA_MEMORY_USAGE_CPU_TO_GPU),
+          deviceBufferArenaResource(this->vulkanResource.GetVmaAllocator(), this->vulkanResource.GetPhysicalDevice(), VMA_MEMORY_USAGE_GPU_ONLY),
           resourceStorage{} {}
 
 } // namespace Prism::Resources
\ No newline at end of file
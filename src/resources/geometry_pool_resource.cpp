@@ -0,0 +1,173 @@
+#include "resources/geometry_pool_resource.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace Prism::Resources {
+    namespace {
+        uint32_t getVerticesPerSlot(MeshResource::VertexFormat vertexFormat) {
+            static_assert(sizeof(MeshResource::Vertex) % sizeof(MeshResource::QuantizedVertex) == 0);
+            return static_cast<uint32_t>(sizeof(MeshResource::Vertex) / MeshResource::GetVertexStride(vertexFormat));
+        }
+
+        uint32_t getSlotCount(MeshResource::VertexFormat vertexFormat, uint32_t vertexCount) {
+            uint32_t verticesPerSlot = getVerticesPerSlot(vertexFormat);
+            return (vertexCount + verticesPerSlot - 1) / verticesPerSlot;
+        }
+    } // namespace
+
+    GeometryPoolResource::GeometryPoolResource(VmaAllocator allocator, uint32_t vertexCapacity, uint32_t indexCapacity)
+        : vertexCapacity(vertexCapacity), indexCapacity(indexCapacity) {
+        vertexBuffer = VkBufferResource<Vertex>(allocator, static_cast<VkDeviceSize>(vertexCapacity) * sizeof(Vertex),
+                                                VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_GPU_ONLY);
+        indexBuffer = VkBufferResource<Index>(allocator, static_cast<VkDeviceSize>(indexCapacity) * sizeof(Index),
+                                              VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_GPU_ONLY);
+
+        vertexRanges.Reset(vertexCapacity);
+        indexRanges.Reset(indexCapacity);
+    }
+
+    GeometryPoolResource::GeometryPoolResource(GeometryPoolResource &&other) noexcept { swap(*this, other); }
+
+    GeometryPoolResource &GeometryPoolResource::operator=(GeometryPoolResource &&other) noexcept {
+        if (this != &other) {
+            swap(*this, other);
+        }
+        return *this;
+    }
+
+    void swap(GeometryPoolResource &first, GeometryPoolResource &second) noexcept {
+        using std::swap;
+        swap(first.currentFrame, second.currentFrame);
+        swap(first.vertexCapacity, second.vertexCapacity);
+        swap(first.indexCapacity, second.indexCapacity);
+        swap(first.vertexBuffer, second.vertexBuffer);
+        swap(first.indexBuffer, second.indexBuffer);
+        swap(first.vertexRanges, second.vertexRanges);
+        swap(first.indexRanges, second.indexRanges);
+        swap(first.pendingFrees, second.pendingFrees);
+    }
+
+    std::optional<MeshResource::GeometryRange> GeometryPoolResource::Allocate(VkStagingBufferResource &stagingBuffer, std::vector<Vertex> &vertices,
+                                                                              std::vector<Index> &indices) {
+        return Allocate(stagingBuffer, MeshResource::VertexFormat::Float, vertices.data(), static_cast<uint32_t>(vertices.size()), indices.data(),
+                        static_cast<uint32_t>(indices.size()));
+    }
+
+    std::optional<MeshResource::GeometryRange> GeometryPoolResource::Allocate(VkStagingBufferResource &stagingBuffer,
+                                                                              std::vector<QuantizedVertex> &vertices, std::vector<Index> &indices) {
+        return Allocate(stagingBuffer, MeshResource::VertexFormat::Quantized, vertices.data(), static_cast<uint32_t>(vertices.size()), indices.data(),
+                        static_cast<uint32_t>(indices.size()));
+    }
+
+    std::optional<MeshResource::GeometryRange> GeometryPoolResource::Allocate(VkStagingBufferResource &stagingBuffer,
+                                                                              MeshResource::VertexFormat vertexFormat, const void *vertices,
+                                                                              uint32_t vertexCount, const Index *indices, uint32_t indexCount) {
+        if (vertexCount == 0 || indexCount == 0) {
+            return std::nullopt;
+        }
+
+        const uint32_t slotCount = getSlotCount(vertexFormat, vertexCount);
+
+        auto firstSlot = vertexRanges.Allocate(slotCount);
+        if (!firstSlot) {
+            return std::nullopt;
+        }
+
+        auto firstIndex = indexRanges.Allocate(indexCount);
+        if (!firstIndex) {
+            vertexRanges.Free(*firstSlot, slotCount);
+            return std::nullopt;
+        }
+
+        MeshResource::GeometryRange range{};
+        range.vertexFormat = vertexFormat;
+        range.vertexOffset = *firstSlot * getVerticesPerSlot(vertexFormat);
+        range.vertexCount = vertexCount;
+        range.firstIndex = *firstIndex;
+        range.indexCount = indexCount;
+
+        stagingBuffer.Copy(vertexBuffer.GetBuffer(), vertices, vertexCount * MeshResource::GetVertexStride(vertexFormat),
+                           static_cast<VkDeviceSize>(*firstSlot) * sizeof(Vertex));
+        stagingBuffer.Copy(indexBuffer.GetBuffer(), indices, static_cast<size_t>(indexCount) * sizeof(Index),
+                           static_cast<VkDeviceSize>(range.firstIndex) * sizeof(Index));
+
+        return range;
+    }
+
+    void GeometryPoolResource::Free(const MeshResource::GeometryRange &range) {
+        if (range.vertexCount == 0 && range.indexCount == 0) {
+            return;
+        }
+
+        pendingFrees.push_back({.range = range, .frame = currentFrame});
+    }
+
+    void GeometryPoolResource::BeginFrame(uint64_t frameNumber, uint64_t completedFrameNumber) {
+        currentFrame = frameNumber;
+
+        // Frames recorded up to the free could still be reading the range until the GPU finishes them.
+        auto released = std::partition(pendingFrees.begin(), pendingFrees.end(),
+                                       [&](const PendingFree &pending) { return pending.frame > completedFrameNumber; });
+
+        for (auto it = released; it != pendingFrees.end(); ++it) {
+            const auto vertexFormat = it->range.vertexFormat;
+            vertexRanges.Free(it->range.vertexOffset / getVerticesPerSlot(vertexFormat), getSlotCount(vertexFormat, it->range.vertexCount));
+            indexRanges.Free(it->range.firstIndex, it->range.indexCount);
+        }
+
+        pendingFrees.erase(released, pendingFrees.end());
+    }
+
+    void GeometryPoolResource::FreeRangeList::Reset(uint32_t capacity) {
+        freeRanges.clear();
+        freeRanges.emplace(0, capacity);
+        freeCount = capacity;
+    }
+
+    std::optional<uint32_t> GeometryPoolResource::FreeRangeList::Allocate(uint32_t count) {
+        auto it = std::find_if(freeRanges.begin(), freeRanges.end(), [&](const auto &range) { return range.second >= count; });
+        if (it == freeRanges.end()) {
+            return std::nullopt;
+        }
+
+        auto [offset, rangeCount] = *it;
+        freeRanges.erase(it);
+
+        if (rangeCount > count) {
+            freeRanges.emplace(offset + count, rangeCount - count);
+        }
+
+        freeCount -= count;
+        return offset;
+    }
+
+    void GeometryPoolResource::FreeRangeList::Free(uint32_t offset, uint32_t count) {
+        if (count == 0) {
+            return;
+        }
+
+        freeCount += count;
+
+        auto next = freeRanges.lower_bound(offset);
+
+        // Merge with preceding range.
+        if (next != freeRanges.begin()) {
+            auto previous = std::prev(next);
+            if (previous->first + previous->second == offset) {
+                offset = previous->first;
+                count += previous->second;
+                freeRanges.erase(previous);
+            }
+        }
+
+        // Merge with following range.
+        if (next != freeRanges.end() && offset + count == next->first) {
+            count += next->second;
+            freeRanges.erase(next);
+        }
+
+        freeRanges.emplace(offset, count);
+    }
+} // namespace Prism::Resources
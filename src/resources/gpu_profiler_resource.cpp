@@ -0,0 +1,227 @@
+#include "resources/gpu_profiler_resource.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace Prism::Resources {
+    namespace {
+        constexpr VkQueryPipelineStatisticFlags PIPELINE_STATISTICS_FLAGS =
+            VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_VERTICES_BIT | VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES_BIT |
+            VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT | VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT |
+            VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT | VK_QUERY_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS_BIT;
+
+        VkQueryPool createQueryPool(VkDevice device, VkQueryType type, uint32_t count, VkQueryPipelineStatisticFlags pipelineStatistics) {
+            VkQueryPoolCreateInfo createInfo{};
+            createInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+            createInfo.queryType = type;
+            createInfo.queryCount = count;
+            createInfo.pipelineStatistics = pipelineStatistics;
+
+            VkQueryPool queryPool = VK_NULL_HANDLE;
+            if (vkCreateQueryPool(device, &createInfo, nullptr, &queryPool) != VK_SUCCESS) {
+                throw std::runtime_error("Failed to create query pool!");
+            }
+
+            return queryPool;
+        }
+    } // namespace
+
+    GpuProfilerResource::GpuProfilerResource(VkDevice device, VkPhysicalDevice physicalDevice, uint32_t queueFamilyIndex, uint32_t framesInFlight)
+        : device(device) {
+        VkPhysicalDeviceProperties properties;
+        vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+        VkPhysicalDeviceFeatures features;
+        vkGetPhysicalDeviceFeatures(physicalDevice, &features);
+
+        uint32_t queueFamilyCount = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, nullptr);
+        std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+        vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, queueFamilies.data());
+
+        uint32_t timestampValidBits = queueFamilyIndex < queueFamilyCount ? queueFamilies[queueFamilyIndex].timestampValidBits : 0;
+
+        timestampsSupported = timestampValidBits > 0 && properties.limits.timestampPeriod > 0.0f;
+        // Feature is enabled on device creation whenever it is available.
+        pipelineStatisticsSupported = features.pipelineStatisticsQuery == VK_TRUE;
+
+        timestampPeriod = static_cast<double>(properties.limits.timestampPeriod);
+        timestampMask = timestampValidBits >= 64 ? UINT64_MAX : ((uint64_t{1} << timestampValidBits) - 1);
+
+        if (!timestampsSupported) {
+            return;
+        }
+
+        frames.resize(framesInFlight);
+        for (auto &frame : frames) {
+            frame.timestampPool = createQueryPool(device, VK_QUERY_TYPE_TIMESTAMP, MAX_ZONES_PER_FRAME * 2, 0);
+
+            if (pipelineStatisticsSupported) {
+                frame.pipelineStatisticsPool =
+                    createQueryPool(device, VK_QUERY_TYPE_PIPELINE_STATISTICS, MAX_ZONES_PER_FRAME, PIPELINE_STATISTICS_FLAGS);
+            }
+        }
+    }
+
+    GpuProfilerResource::~GpuProfilerResource() {
+        if (device == VK_NULL_HANDLE) {
+            return;
+        }
+
+        for (auto &frame : frames) {
+            if (frame.timestampPool != VK_NULL_HANDLE) {
+                vkDestroyQueryPool(device, frame.timestampPool, nullptr);
+            }
+            if (frame.pipelineStatisticsPool != VK_NULL_HANDLE) {
+                vkDestroyQueryPool(device, frame.pipelineStatisticsPool, nullptr);
+            }
+        }
+    }
+
+    GpuProfilerResource::GpuProfilerResource(GpuProfilerResource &&other) noexcept { swap(*this, other); }
+
+    GpuProfilerResource &GpuProfilerResource::operator=(GpuProfilerResource &&other) noexcept {
+        if (this != &other) {
+            swap(*this, other);
+        }
+        return *this;
+    }
+
+    void swap(GpuProfilerResource &first, GpuProfilerResource &second) noexcept {
+        using std::swap;
+
+        swap(first.device, second.device);
+        swap(first.timestampsSupported, second.timestampsSupported);
+        swap(first.pipelineStatisticsSupported, second.pipelineStatisticsSupported);
+        swap(first.enabled, second.enabled);
+        swap(first.pipelineStatisticsEnabled, second.pipelineStatisticsEnabled);
+        swap(first.timestampPeriod, second.timestampPeriod);
+        swap(first.timestampMask, second.timestampMask);
+        swap(first.frames, second.frames);
+        swap(first.currentFrame, second.currentFrame);
+        swap(first.lastResults, second.lastResults);
+        swap(first.lastFrameGpuTimeMs, second.lastFrameGpuTimeMs);
+    }
+
+    void GpuProfilerResource::BeginFrame(uint32_t frameOffset) {
+        if (!timestampsSupported) {
+            return;
+        }
+
+        currentFrame = frameOffset;
+
+        auto &frame = frames.at(currentFrame);
+        if (frame.zoneCount > 0) {
+            collectResults(frame);
+        }
+
+        frame.zoneCount = 0;
+        frame.hasPipelineStatistics = pipelineStatisticsEnabled;
+    }
+
+    GpuProfilerResource::ZoneId GpuProfilerResource::BeginZone(VkCommandBuffer commandBuffer, const char *name) {
+        if (!timestampsSupported || !enabled) {
+            return INVALID_ZONE;
+        }
+
+        auto &frame = frames[currentFrame];
+        if (frame.zoneCount >= MAX_ZONES_PER_FRAME) {
+            return INVALID_ZONE;
+        }
+
+        ZoneId zoneId = frame.zoneCount++;
+        frame.zoneNames[zoneId] = name;
+
+        vkCmdResetQueryPool(commandBuffer, frame.timestampPool, zoneId * 2, 2);
+        vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, frame.timestampPool, zoneId * 2);
+
+        if (frame.hasPipelineStatistics) {
+            vkCmdResetQueryPool(commandBuffer, frame.pipelineStatisticsPool, zoneId, 1);
+            vkCmdBeginQuery(commandBuffer, frame.pipelineStatisticsPool, zoneId, 0);
+        }
+
+        return zoneId;
+    }
+
+    void GpuProfilerResource::EndZone(VkCommandBuffer commandBuffer, ZoneId zoneId) {
+        if (zoneId == INVALID_ZONE) {
+            return;
+        }
+
+        auto &frame = frames[currentFrame];
+
+        if (frame.hasPipelineStatistics) {
+            vkCmdEndQuery(commandBuffer, frame.pipelineStatisticsPool, zoneId);
+        }
+
+        vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, frame.timestampPool, zoneId * 2 + 1);
+    }
+
+    void GpuProfilerResource::collectResults(FrameQueries &frame) {
+        // Each query is followed by its availability value.
+        std::array<uint64_t, MAX_ZONES_PER_FRAME * 2 * 2> timestamps{};
+
+        VkResult result = vkGetQueryPoolResults(device, frame.timestampPool, 0, frame.zoneCount * 2, sizeof(timestamps), timestamps.data(),
+                                                sizeof(uint64_t) * 2, VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+        if (result != VK_SUCCESS && result != VK_NOT_READY) {
+            return;
+        }
+
+        std::array<uint64_t, MAX_ZONES_PER_FRAME * (PIPELINE_STATISTICS_COUNT + 1)> statistics{};
+        bool statisticsRead = false;
+
+        if (frame.hasPipelineStatistics) {
+            result = vkGetQueryPoolResults(device, frame.pipelineStatisticsPool, 0, frame.zoneCount, sizeof(statistics), statistics.data(),
+                                           sizeof(uint64_t) * (PIPELINE_STATISTICS_COUNT + 1),
+                                           VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+            statisticsRead = result == VK_SUCCESS || result == VK_NOT_READY;
+        }
+
+        std::vector<ZoneResult> results;
+        results.reserve(frame.zoneCount);
+
+        uint64_t frameStart = UINT64_MAX;
+        uint64_t frameEnd = 0;
+
+        for (uint32_t zoneId = 0; zoneId < frame.zoneCount; zoneId++) {
+            uint64_t begin = timestamps[zoneId * 4 + 0] & timestampMask;
+            bool beginAvailable = timestamps[zoneId * 4 + 1] != 0;
+            uint64_t end = timestamps[zoneId * 4 + 2] & timestampMask;
+            bool endAvailable = timestamps[zoneId * 4 + 3] != 0;
+
+            // Frame fence was signalled, so missing results mean the zone was never submitted.
+            if (!beginAvailable || !endAvailable || end < begin) {
+                continue;
+            }
+
+            frameStart = std::min(frameStart, begin);
+            frameEnd = std::max(frameEnd, end);
+
+            ZoneResult zoneResult{};
+            zoneResult.name = frame.zoneNames[zoneId];
+            zoneResult.gpuTimeMs = static_cast<double>(end - begin) * timestampPeriod / 1e6;
+
+            const uint64_t *zoneStatistics = statistics.data() + zoneId * (PIPELINE_STATISTICS_COUNT + 1);
+            if (statisticsRead && zoneStatistics[PIPELINE_STATISTICS_COUNT] != 0) {
+                // Values are ordered by bit position of the enabled flags.
+                zoneResult.hasPipelineStatistics = true;
+                zoneResult.pipelineStatistics.inputAssemblyVertices = zoneStatistics[0];
+                zoneResult.pipelineStatistics.inputAssemblyPrimitives = zoneStatistics[1];
+                zoneResult.pipelineStatistics.vertexShaderInvocations = zoneStatistics[2];
+                zoneResult.pipelineStatistics.clippingPrimitives = zoneStatistics[3];
+                zoneResult.pipelineStatistics.fragmentShaderInvocations = zoneStatistics[4];
+                zoneResult.pipelineStatistics.computeShaderInvocations = zoneStatistics[5];
+            }
+
+            results.push_back(zoneResult);
+        }
+
+        if (results.empty()) {
+            return;
+        }
+
+        lastResults = std::move(results);
+        lastFrameGpuTimeMs = static_cast<double>(frameEnd - frameStart) * timestampPeriod / 1e6;
+    }
+} // namespace Prism::Resources
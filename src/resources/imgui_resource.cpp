@@ -7,15 +7,17 @@
 #include <iostream>
 
 namespace Prism::Resources {
-    ImGuiResource::ImGuiResource(VkDevice device, VkDescriptorPool descriptorPool, VkRenderPass renderPass)
-        : isOwned(true), device(device), descriptorPool(descriptorPool), renderPass(renderPass) {}
+    ImGuiResource::ImGuiResource(VkDevice device, VkDescriptorPool descriptorPool, VkRenderPass renderPass, bool hasPlatformBackend)
+        : isOwned(true), hasPlatformBackend(hasPlatformBackend), device(device), descriptorPool(descriptorPool), renderPass(renderPass) {}
 
     ImGuiResource::~ImGuiResource() {
         if (isOwned) {
             std::cout << "Shutting down imgui!" << std::endl;
 
             ImGui_ImplVulkan_Shutdown();
-            ImGui_ImplGlfw_Shutdown();
+            if (hasPlatformBackend) {
+                ImGui_ImplGlfw_Shutdown();
+            }
             ImGui::DestroyContext();
 
             if (descriptorPool != VK_NULL_HANDLE) {
@@ -41,6 +43,7 @@ namespace Prism::Resources {
         using std::swap;
 
         swap(first.isOwned, second.isOwned);
+        swap(first.hasPlatformBackend, second.hasPlatformBackend);
         swap(first.descriptorPool, second.descriptorPool);
         swap(first.renderPass, second.renderPass);
         swap(first.device, second.device);
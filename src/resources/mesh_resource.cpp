@@ -1,8 +1,45 @@
 #include "resources/mesh_resource.hpp"
 
+#include "resources/geometry_pool_resource.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
 namespace Prism::Resources {
-    MeshResource::MeshResource(Resources::VkBufferResource<Vertex> vertexBuffer, Resources::VkBufferResource<Index> indexBuffer)
-        : vertexBuffer(std::move(vertexBuffer)), indexBuffer(std::move(indexBuffer)) {}
+    size_t MeshResource::GetVertexStride(VertexFormat vertexFormat) {
+        switch (vertexFormat) {
+        case VertexFormat::Float:
+            return sizeof(Vertex);
+        case VertexFormat::Quantized:
+            return sizeof(QuantizedVertex);
+        }
+
+        throw std::runtime_error("Unknown vertex format!");
+    }
+
+    MeshResource::MeshResource(GeometryPoolResource &geometryPool, GeometryRange geometryRange, std::vector<Submesh> submeshes, BoundingBox boundingBox,
+                               BoundingSphere boundingSphere, VertexDequantization vertexDequantization)
+        : geometryPool(&geometryPool), geometryRange(geometryRange), submeshes(std::move(submeshes)), boundingBox(boundingBox),
+          boundingSphere(boundingSphere), vertexDequantization(vertexDequantization) {
+        size_t lodCount = 0;
+        for (const auto &submesh : this->submeshes) {
+            lodCount = std::max(lodCount, submesh.lods.size());
+        }
+
+        lodErrors.assign(lodCount, 0.0f);
+        for (const auto &submesh : this->submeshes) {
+            for (size_t level = 0; level < lodCount && !submesh.lods.empty(); level++) {
+                lodErrors[level] = std::max(lodErrors[level], submesh.lods[std::min(level, submesh.lods.size() - 1)].error);
+            }
+        }
+    }
+
+    MeshResource::~MeshResource() {
+        if (geometryPool != nullptr) {
+            geometryPool->Free(geometryRange);
+        }
+    }
 
     MeshResource::MeshResource(MeshResource &&other) {
         using std::swap;
@@ -17,7 +54,12 @@ namespace Prism::Resources {
 
     void swap(MeshResource &lhs, MeshResource &rhs) noexcept {
         using std::swap;
-        swap(lhs.vertexBuffer, rhs.vertexBuffer);
-        swap(lhs.indexBuffer, rhs.indexBuffer);
+        swap(lhs.geometryPool, rhs.geometryPool);
+        swap(lhs.geometryRange, rhs.geometryRange);
+        swap(lhs.submeshes, rhs.submeshes);
+        swap(lhs.lodErrors, rhs.lodErrors);
+        swap(lhs.boundingBox, rhs.boundingBox);
+        swap(lhs.boundingSphere, rhs.boundingSphere);
+        swap(lhs.vertexDequantization, rhs.vertexDequantization);
     }
 } // namespace Prism::Resources
\ No newline at end of file
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "resources/resource.hpp"
+
+#include "resources/vulkan/vk_buffer_resource.hpp"
+
+#include "vk_mem_alloc.h"
+#include "vulkan/vulkan.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace Prism::Resources {
+    // Hands out ranges of a few large buffers instead of a VkBuffer & allocation per small buffer. Every block is one buffer of the
+    // arena's usage & memory type, ranges within it are managed by a VMA virtual block. Host visible blocks stay mapped.
+    // Blocks are kept once created, buffers handed out have to be destroyed before the arena.
+    struct BufferArenaResource : ResourceImpl<BufferArenaResource> {
+        static constexpr VkDeviceSize DEFAULT_BLOCK_SIZE = 16 * 1024 * 1024;
+
+        // Vertex, index, uniform, storage & indirect data, written by the host or by copies.
+        static constexpr VkBufferUsageFlags DEFAULT_USAGE = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT |
+                                                            VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                                                            VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT |
+                                                            VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+        BufferArenaResource(VmaAllocator allocator, VkPhysicalDevice physicalDevice, VmaMemoryUsage memoryUsage,
+                            VkBufferUsageFlags usage = DEFAULT_USAGE, VkDeviceSize blockSize = DEFAULT_BLOCK_SIZE);
+        ~BufferArenaResource();
+
+        BufferArenaResource(const BufferArenaResource &other) = delete;
+        BufferArenaResource &operator=(const BufferArenaResource &other) = delete;
+
+        BufferArenaResource(BufferArenaResource &&other) noexcept;
+        BufferArenaResource &operator=(BufferArenaResource &&other) noexcept;
+
+        // Ranges are aligned for any of the usages, so they can be bound as descriptors directly. Ranges larger than a block get a
+        // block of their own.
+        template <typename T = void> VkBufferResource<T> Allocate(VkDeviceSize size) { return VkBufferResource<T>(allocate(size)); }
+
+        size_t GetBlockCount() const { return blocks.size(); }
+
+        // Bytes of all blocks, free ranges included.
+        VkDeviceSize GetReservedSize() const;
+
+      private:
+        struct Block {
+            VkBufferResource<> buffer = {};
+            VmaVirtualBlock virtualBlock = VK_NULL_HANDLE;
+            std::byte *mappedData = nullptr;
+        };
+
+        friend void swap(BufferArenaResource &first, BufferArenaResource &second) noexcept;
+
+        VkBufferSuballocation allocate(VkDeviceSize size);
+        Block &createBlock(VkDeviceSize size);
+
+        VmaAllocator allocator = VK_NULL_HANDLE;
+        VmaMemoryUsage memoryUsage = VMA_MEMORY_USAGE_UNKNOWN;
+        VkBufferUsageFlags usage = 0;
+        VkDeviceSize blockSize = 0;
+        VkDeviceSize alignment = 1;
+
+        std::vector<Block> blocks = {};
+    };
+} // namespace Prism::Resources
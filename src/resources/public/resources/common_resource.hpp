@@ -7,13 +7,22 @@
 
 #include <GLFW/glfw3.h>
 
+#include <optional>
+#include <string_view>
+
 namespace Prism::Resources {
 
     struct CommonResource {
         glm::mat4 view{};
         glm::mat4 projection{};
         glm::vec4 cameraPosition{};
+    };
+
+    // Where CommonResource of the current frame lives in UniformRingResource. Written by CommonUniformUpdateSystem.
+    struct CommonUniformResource : ResourceImpl<CommonUniformResource> {
+        // Dynamic offset of the uniform binding, nullopt when there is no active camera this frame.
+        std::optional<uint32_t> offset = std::nullopt;
 
-        inline static const Resources::Resource::ID UNIFORM_BUFFER_ID = std::hash<std::string_view>{}("CommonUniformUpdateSystem/UniformBufferResource");
+        inline static const Resources::Resource::ID COMMON_UNIFORM_ID = std::hash<std::string_view>{}("CommonUniformUpdateSystem/CommonUniformResource");
     };
 }; // namespace Prism::Resources
\ No newline at end of file
@@ -2,8 +2,14 @@
 
 #include "resources/resource.hpp"
 
+#include "resources/buffer_arena_resource.hpp"
+#include "resources/geometry_pool_resource.hpp"
+#include "resources/gpu_profiler_resource.hpp"
 #include "resources/imgui_resource.hpp"
+#include "resources/render_target_pool_resource.hpp"
 #include "resources/resource_storage.hpp"
+#include "resources/uniform_ring_resource.hpp"
+#include "resources/vulkan/vk_transfer_queue_resource.hpp"
 #include "resources/vulkan_resource.hpp"
 #include "resources/window_resource.hpp"
 
@@ -28,6 +34,22 @@ namespace Prism::Resources {
 
         Resources::ImGuiResource &GetImGuiResource() { return imguiResource; }
 
+        Resources::GpuProfilerResource &GetGpuProfilerResource() { return gpuProfilerResource; }
+
+        Resources::GeometryPoolResource &GetGeometryPoolResource() { return geometryPoolResource; }
+
+        Resources::UniformRingResource &GetUniformRingResource() { return uniformRingResource; }
+
+        Resources::RenderTargetPoolResource &GetRenderTargetPoolResource() { return renderTargetPoolResource; }
+
+        // Small buffers written by the host every frame.
+        Resources::BufferArenaResource &GetHostBufferArenaResource() { return hostBufferArenaResource; }
+
+        // Small buffers only the GPU reads & writes.
+        Resources::BufferArenaResource &GetDeviceBufferArenaResource() { return deviceBufferArenaResource; }
+
+        Resources::VkTransferQueueResource &GetTransferQueueResource() { return transferQueueResource; }
+
         Resources::ResourceStorage &GetResourceStorage() { return resourceStorage; }
 
       private:
@@ -35,6 +57,14 @@ namespace Prism::Resources {
         Resources::WindowResource windowResource;
         Resources::VulkanResource vulkanResource;
         Resources::ImGuiResource imguiResource;
+        Resources::GpuProfilerResource gpuProfilerResource;
+        Resources::GeometryPoolResource geometryPoolResource;
+        Resources::UniformRingResource uniformRingResource;
+        Resources::RenderTargetPoolResource renderTargetPoolResource;
+        Resources::VkTransferQueueResource transferQueueResource;
+        // Buffers handed out by the arenas live in the resource storage, which is destroyed first.
+        Resources::BufferArenaResource hostBufferArenaResource;
+        Resources::BufferArenaResource deviceBufferArenaResource;
         Resources::ResourceStorage resourceStorage;
     };
 }; // namespace Prism::Resources
\ No newline at end of file
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "resources/resource.hpp"
+
+#include "resources/mesh_resource.hpp"
+#include "resources/vulkan/vk_buffer_resource.hpp"
+#include "resources/vulkan/vk_staging_buffer_resource.hpp"
+
+#include <map>
+#include <optional>
+#include <vector>
+
+namespace Prism::Resources {
+    // Shared vertex & index buffers all meshes are suballocated from, so the whole scene can be drawn
+    // with one set of bound buffers and a single indirect draw per vertex format.
+    //
+    // Vertex buffer is managed in slots of sizeof(Vertex). Smaller formats pack several vertices into a slot, so the same
+    // buffer bound with their stride addresses them by a whole vertex offset.
+    struct GeometryPoolResource : ResourceImpl<GeometryPoolResource> {
+        using Vertex = MeshResource::Vertex;
+        using QuantizedVertex = MeshResource::QuantizedVertex;
+        using Index = MeshResource::Index;
+
+        static constexpr uint32_t DEFAULT_VERTEX_CAPACITY = 1u << 21;
+        static constexpr uint32_t DEFAULT_INDEX_CAPACITY = 1u << 23;
+
+        GeometryPoolResource(VmaAllocator allocator, uint32_t vertexCapacity = DEFAULT_VERTEX_CAPACITY, uint32_t indexCapacity = DEFAULT_INDEX_CAPACITY);
+        ~GeometryPoolResource() = default;
+
+        GeometryPoolResource(const GeometryPoolResource &other) = delete;
+        GeometryPoolResource &operator=(const GeometryPoolResource &other) = delete;
+
+        GeometryPoolResource(GeometryPoolResource &&other) noexcept;
+        GeometryPoolResource &operator=(GeometryPoolResource &&other) noexcept;
+
+        // Reserves space for the geometry and schedules its upload. Returns nullopt when the pool is full.
+        std::optional<MeshResource::GeometryRange> Allocate(VkStagingBufferResource &stagingBuffer, std::vector<Vertex> &vertices,
+                                                            std::vector<Index> &indices);
+        std::optional<MeshResource::GeometryRange> Allocate(VkStagingBufferResource &stagingBuffer, std::vector<QuantizedVertex> &vertices,
+                                                            std::vector<Index> &indices);
+        // Geometry the caller keeps elsewhere, e.g. in a mapped mesh cache. Vertices are expected in vertexFormat.
+        std::optional<MeshResource::GeometryRange> Allocate(VkStagingBufferResource &stagingBuffer, MeshResource::VertexFormat vertexFormat,
+                                                            const void *vertices, uint32_t vertexCount, const Index *indices, uint32_t indexCount);
+
+        // Range is reused only after the last recorded frame, the latest one that could reference it, has finished.
+        void Free(const MeshResource::GeometryRange &range);
+
+        // Has to be called once per frame with the number of the frame being recorded & of the last one finished on the GPU.
+        void BeginFrame(uint64_t frameNumber, uint64_t completedFrameNumber);
+
+        VkBufferResource<Vertex> &GetVertexBuffer() { return vertexBuffer; }
+
+        VkBufferResource<Index> &GetIndexBuffer() { return indexBuffer; }
+
+        // In slots, i.e. full size vertices.
+        uint32_t GetUsedVertexCount() const { return vertexCapacity - vertexRanges.GetFreeCount(); }
+
+        uint32_t GetUsedIndexCount() const { return indexCapacity - indexRanges.GetFreeCount(); }
+
+      private:
+        // First-fit free list, adjacent free ranges are merged on release.
+        struct FreeRangeList {
+            std::map<uint32_t, uint32_t> freeRanges = {}; // offset -> count
+            uint32_t freeCount = 0;
+
+            void Reset(uint32_t capacity);
+            std::optional<uint32_t> Allocate(uint32_t count);
+            void Free(uint32_t offset, uint32_t count);
+
+            uint32_t GetFreeCount() const { return freeCount; }
+        };
+
+        struct PendingFree {
+            MeshResource::GeometryRange range;
+            uint64_t frame;
+        };
+
+        uint64_t currentFrame = 0;
+
+        uint32_t vertexCapacity = 0;
+        uint32_t indexCapacity = 0;
+
+        VkBufferResource<Vertex> vertexBuffer = {};
+        VkBufferResource<Index> indexBuffer = {};
+
+        FreeRangeList vertexRanges = {};
+        FreeRangeList indexRanges = {};
+
+        std::vector<PendingFree> pendingFrees = {};
+
+        friend void swap(GeometryPoolResource &first, GeometryPoolResource &second) noexcept;
+    };
+} // namespace Prism::Resources
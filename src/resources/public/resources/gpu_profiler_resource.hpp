@@ -0,0 +1,106 @@
+#pragma once
+
+#include "resources/resource.hpp"
+
+#include "vulkan/vulkan.h"
+
+#include <array>
+#include <vector>
+
+namespace Prism::Resources {
+    // Measures GPU time (and optionally pipeline statistics) of zones recorded into command buffers.
+    // Every frame in flight owns its own query pools, results of a frame are read back when the same
+    // frame slot is reused - its fence has already been waited on, so reading never stalls.
+    struct GpuProfilerResource : ResourceImpl<GpuProfilerResource> {
+        using ZoneId = uint32_t;
+
+        static constexpr ZoneId INVALID_ZONE = UINT32_MAX;
+        static constexpr uint32_t MAX_ZONES_PER_FRAME = 32;
+
+        struct PipelineStatistics {
+            uint64_t inputAssemblyVertices = 0;
+            uint64_t inputAssemblyPrimitives = 0;
+            uint64_t vertexShaderInvocations = 0;
+            uint64_t clippingPrimitives = 0;
+            uint64_t fragmentShaderInvocations = 0;
+            uint64_t computeShaderInvocations = 0;
+        };
+
+        struct ZoneResult {
+            const char *name = nullptr;
+            double gpuTimeMs = 0.0;
+
+            bool hasPipelineStatistics = false;
+            PipelineStatistics pipelineStatistics = {};
+        };
+
+        GpuProfilerResource(VkDevice device, VkPhysicalDevice physicalDevice, uint32_t queueFamilyIndex, uint32_t framesInFlight);
+        ~GpuProfilerResource();
+
+        GpuProfilerResource(const GpuProfilerResource &other) = delete;
+        GpuProfilerResource &operator=(const GpuProfilerResource &other) = delete;
+
+        GpuProfilerResource(GpuProfilerResource &&other) noexcept;
+        GpuProfilerResource &operator=(GpuProfilerResource &&other) noexcept;
+
+        // Has to be called after fence of given frame slot was waited on - collects its previous results.
+        void BeginFrame(uint32_t frameOffset);
+
+        // Has to be recorded outside of render pass. Name has to outlive the profiler - string literals are expected.
+        ZoneId BeginZone(VkCommandBuffer commandBuffer, const char *name);
+        void EndZone(VkCommandBuffer commandBuffer, ZoneId zoneId);
+
+        // Results of the most recently completed frame.
+        const std::vector<ZoneResult> &GetLastResults() const { return lastResults; }
+
+        // Time from the first zone start to the last zone end of the most recently completed frame.
+        double GetLastFrameGpuTimeMs() const { return lastFrameGpuTimeMs; }
+
+        bool IsSupported() const { return timestampsSupported; }
+
+        bool IsPipelineStatisticsSupported() const { return pipelineStatisticsSupported; }
+
+        bool IsEnabled() const { return enabled; }
+
+        void SetEnabled(bool value) { enabled = value; }
+
+        bool IsPipelineStatisticsEnabled() const { return pipelineStatisticsEnabled; }
+
+        void SetPipelineStatisticsEnabled(bool value) { pipelineStatisticsEnabled = value && pipelineStatisticsSupported; }
+
+      private:
+        static constexpr uint32_t PIPELINE_STATISTICS_COUNT = 6;
+
+        struct FrameQueries {
+            VkQueryPool timestampPool = VK_NULL_HANDLE;
+            VkQueryPool pipelineStatisticsPool = VK_NULL_HANDLE;
+
+            uint32_t zoneCount = 0;
+            std::array<const char *, MAX_ZONES_PER_FRAME> zoneNames = {};
+            // Latched on BeginFrame, so all zones of a frame are recorded the same way.
+            bool hasPipelineStatistics = false;
+        };
+
+        VkDevice device = VK_NULL_HANDLE;
+
+        bool timestampsSupported = false;
+        bool pipelineStatisticsSupported = false;
+
+        bool enabled = true;
+        bool pipelineStatisticsEnabled = false;
+
+        // Nanoseconds per timestamp tick.
+        double timestampPeriod = 1.0;
+        uint64_t timestampMask = UINT64_MAX;
+
+        std::vector<FrameQueries> frames = {};
+        uint32_t currentFrame = 0;
+
+        std::vector<ZoneResult> lastResults = {};
+        double lastFrameGpuTimeMs = 0.0;
+
+        friend void swap(GpuProfilerResource &first, GpuProfilerResource &second) noexcept;
+
+        void collectResults(FrameQueries &frame);
+    };
+} // namespace Prism::Resources
@@ -6,7 +6,7 @@
 
 namespace Prism::Resources {
     struct ImGuiResource : ResourceImpl<ImGuiResource> {
-        ImGuiResource(VkDevice device, VkDescriptorPool descriptorPool, VkRenderPass renderPass);
+        ImGuiResource(VkDevice device, VkDescriptorPool descriptorPool, VkRenderPass renderPass, bool hasPlatformBackend);
         ~ImGuiResource();
 
         ImGuiResource(ImGuiResource &other) = delete;
@@ -19,8 +19,12 @@ namespace Prism::Resources {
 
         VkRenderPass GetRenderPass() const { return renderPass; }
 
+        // False in headless mode - there is no GLFW window to drive ImGui input and platform windows.
+        bool HasPlatformBackend() const { return hasPlatformBackend; }
+
       private:
         bool isOwned = false;
+        bool hasPlatformBackend = false;
 
         VkDevice device = VK_NULL_HANDLE;
         VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "resources/mesh_resource.hpp"
+#include "resources/resource.hpp"
+
+#include <cstdint>
+#include <string_view>
+
+namespace Prism::Resources {
+    // Result of mesh culling of the most recently completed frame.
+    struct MeshCullingStatisticsResource : ResourceImpl<MeshCullingStatisticsResource> {
+        // Layout has to match mesh_culling.comp, draw counts are used as counts of vkCmdDrawIndexedIndirectCount.
+        struct Statistics {
+            // Per MeshResource::VertexFormat.
+            uint32_t drawCounts[MeshResource::VERTEX_FORMAT_COUNT] = {};
+            // Instances of submeshes, every submesh is culled on its own bounds.
+            uint32_t visibleInstanceCount = 0;
+            uint32_t culledInstanceCount = 0;
+
+            uint32_t GetDrawCount() const {
+                uint32_t drawCount = 0;
+                for (auto formatDrawCount : drawCounts) {
+                    drawCount += formatDrawCount;
+                }
+                return drawCount;
+            }
+        };
+
+        Statistics statistics = {};
+
+        // False when the device lacks indirect count support and culling falls back to the CPU.
+        bool gpuCulling = false;
+
+        inline static const Resources::Resource::ID STATISTICS_ID = std::hash<std::string_view>{}("MeshCullingSystem/StatisticsResource");
+    };
+}; // namespace Prism::Resources
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "resources/resource.hpp"
+
+#include "resources/mesh_culling_statistics_resource.hpp"
+#include "resources/mesh_instance_resource.hpp"
+#include "resources/mesh_resource.hpp"
+#include "resources/vulkan/vk_buffer_resource.hpp"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <string_view>
+#include <vector>
+
+namespace Prism::Resources {
+    // Instances & indirect draws of a single frame in flight. Filled by MeshCullingSystem, consumed by MeshDrawingSystem.
+    struct MeshDrawListResource : ResourceImpl<MeshDrawListResource> {
+        // Input of the culling pass, layout has to match mesh_culling.comp.
+        struct CullInstance {
+            glm::mat4 model{};
+            glm::vec4 boundingSphere{}; // Object space center & radius.
+            // Copied to MeshInstanceResource of visible instances.
+            glm::mat3x4 normalMatrix{};
+            glm::vec4 positionScale = glm::vec4(1.0f);
+            glm::vec4 positionOffset = glm::vec4(0.0f);
+            uint32_t drawIndex = 0;
+            uint32_t padding[3] = {};
+        };
+
+        // Draws of a single vertex format, which are contiguous in draw buffers.
+        struct DrawRange {
+            uint32_t firstDraw = 0;
+            // Upper bound, GPU culled draws are counted by drawCounts of statistics buffer.
+            uint32_t maxDrawCount = 0;
+        };
+
+        using Statistics = MeshCullingStatisticsResource::Statistics;
+
+        // Culling pass inputs, only used when culling runs on the GPU.
+        VkBufferResource<CullInstance> cullInstanceBuffer = {};
+        VkBufferResource<VkDrawIndexedIndirectCommand> drawGroupBuffer = {};
+
+        // Visible instances, read by basic.vert through gl_InstanceIndex.
+        VkBufferResource<MeshInstanceResource> instanceBuffer = {};
+
+        // Draws with at least one visible instance, drawCount of statistics buffer tells how many are valid.
+        VkBufferResource<VkDrawIndexedIndirectCommand> drawCommandBuffer = {};
+        VkBufferResource<Statistics> statisticsBuffer = {};
+
+        // Draws recorded on the CPU, used when the device can't draw indirectly.
+        std::vector<VkDrawIndexedIndirectCommand> drawCommands = {};
+
+        // Upper bound of draws in drawCommandBuffer.
+        uint32_t maxDrawCount = 0;
+        std::array<DrawRange, MeshResource::VERTEX_FORMAT_COUNT> formatDrawRanges = {};
+        bool gpuCulled = false;
+
+        inline static const Resources::Resource::ID DRAW_LIST_ID = std::hash<std::string_view>{}("MeshCullingSystem/MeshDrawListResource");
+    };
+}; // namespace Prism::Resources
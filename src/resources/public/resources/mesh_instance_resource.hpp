@@ -0,0 +1,15 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+namespace Prism::Resources {
+    // Per-instance data read by vertex shader through gl_InstanceIndex, layout has to match basic.vert & mesh_culling.comp.
+    struct MeshInstanceResource {
+        glm::mat4 model{};
+        // Inverse transpose of the upper 3x3 of model, see Utils::NormalMatrices.
+        glm::mat3x4 normalMatrix{};
+        // MeshResource::VertexDequantization of the drawn mesh, w unused.
+        glm::vec4 positionScale = glm::vec4(1.0f);
+        glm::vec4 positionOffset = glm::vec4(0.0f);
+    };
+}; // namespace Prism::Resources
@@ -3,26 +3,101 @@
 
 #include <glm/glm.hpp>
 
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 #include "resources/resource.hpp"
-#include "resources/vulkan/vk_buffer_resource.hpp"
 
 namespace Prism::Resources {
+    struct GeometryPoolResource;
+
     struct MeshResource : ResourceImpl<MeshResource> {
+        // Layout vertices of a mesh are stored & fetched in, every format is drawn with its own pipeline.
+        enum class VertexFormat : uint32_t {
+            // Vertex, 32 bytes.
+            Float = 0,
+            // QuantizedVertex, 16 bytes.
+            Quantized = 1,
+        };
+
+        static constexpr uint32_t VERTEX_FORMAT_COUNT = 2;
+
+        // Size of a single vertex in vertexFormat, in bytes.
+        static size_t GetVertexStride(VertexFormat vertexFormat);
+
         struct Vertex {
             glm::vec3 position;
             glm::vec3 normal;
             glm::vec2 textureUV;
         };
 
+        struct QuantizedVertex {
+            // Unorm position within the bounding box of the mesh, last component only pads the attribute to 8 bytes.
+            uint16_t position[4];
+            // Octahedral encoded snorm normal.
+            int16_t normal[2];
+            // Half floats.
+            uint16_t textureUV[2];
+        };
+
+        // Maps positions as fetched by the vertex shader back to object space - position * scale + offset.
+        struct VertexDequantization {
+            glm::vec3 scale = glm::vec3(1.0f);
+            glm::vec3 offset = glm::vec3(0.0f);
+        };
+
         struct Index {
             uint32_t idx;
         };
 
-        MeshResource(Resources::VkBufferResource<Vertex> vertexBuffer, Resources::VkBufferResource<Index> indexBuffer);
+        // Location of mesh geometry inside of the geometry pool, in elements. Vertices are counted in their own format.
+        struct GeometryRange {
+            VertexFormat vertexFormat = VertexFormat::Float;
+            uint32_t vertexOffset = 0;
+            uint32_t vertexCount = 0;
+            uint32_t firstIndex = 0;
+            uint32_t indexCount = 0;
+        };
+
+        // Object space bounds, used for culling.
+        struct BoundingSphere {
+            glm::vec3 center = glm::vec3(0.0f);
+            float radius = 0.0f;
+        };
+
+        struct BoundingBox {
+            glm::vec3 min = glm::vec3(0.0f);
+            glm::vec3 max = glm::vec3(0.0f);
+        };
+
+        // Simplified index list sharing vertices of its submesh. Level 0 is full detail.
+        struct Lod {
+            // Relative to firstIndex of the geometry range.
+            uint32_t firstIndex = 0;
+            uint32_t indexCount = 0;
+            // Largest object space distance simplification moved the surface by.
+            float error = 0.0f;
+        };
+
+        // Part of the mesh drawn & culled on its own, e.g. a single assimp mesh of a node.
+        struct Submesh {
+            // Relative to vertexOffset of the geometry range, indices of the submesh start at its first vertex.
+            uint32_t vertexOffset = 0;
+            uint32_t vertexCount = 0;
+            // Submeshes too small to simplify have fewer levels than the mesh, coarser levels fall back to their last one.
+            std::vector<Lod> lods = {};
+            BoundingBox boundingBox = {};
+            BoundingSphere boundingSphere = {};
+            // Index into materials of the source model.
+            uint32_t materialIndex = 0;
+        };
+
+        MeshResource(GeometryPoolResource &geometryPool, GeometryRange geometryRange, std::vector<Submesh> submeshes, BoundingBox boundingBox,
+                     BoundingSphere boundingSphere, VertexDequantization vertexDequantization);
 
-        ~MeshResource() = default;
+        // Returns geometry range back to the pool.
+        ~MeshResource();
 
         MeshResource(MeshResource &other) = delete;
         MeshResource &operator=(MeshResource &other) = delete;
@@ -30,15 +105,32 @@ namespace Prism::Resources {
         MeshResource(MeshResource &&other);
         MeshResource &operator=(MeshResource &&other);
 
-        Resources::VkBufferResource<Vertex> &GetVertexBuffer() { return vertexBuffer; }
+        const GeometryRange &GetGeometryRange() const { return geometryRange; }
+
+        const std::vector<Submesh> &GetSubmeshes() const { return submeshes; }
+
+        // Largest error of every level across submeshes, LOD is selected for the whole mesh.
+        const std::vector<float> &GetLodErrors() const { return lodErrors; }
+
+        // Bounds of all submeshes.
+        const BoundingBox &GetBoundingBox() const { return boundingBox; }
+
+        const BoundingSphere &GetBoundingSphere() const { return boundingSphere; }
+
+        VertexFormat GetVertexFormat() const { return geometryRange.vertexFormat; }
 
-        Resources::VkBufferResource<Index> &GetIndexBuffer() { return indexBuffer; }
+        const VertexDequantization &GetVertexDequantization() const { return vertexDequantization; }
 
         friend void swap(MeshResource &lhs, MeshResource &rhs) noexcept;
 
       private:
-        Resources::VkBufferResource<Vertex> vertexBuffer = {};
-        Resources::VkBufferResource<Index> indexBuffer = {};
+        GeometryPoolResource *geometryPool = nullptr;
+        GeometryRange geometryRange = {};
+        std::vector<Submesh> submeshes = {};
+        std::vector<float> lodErrors = {};
+        BoundingBox boundingBox = {};
+        BoundingSphere boundingSphere = {};
+        VertexDequantization vertexDequantization = {};
     };
 
 }; // namespace Prism::Resources
\ No newline at end of file
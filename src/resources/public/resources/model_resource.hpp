@@ -0,0 +1,33 @@
+#pragma once
+
+#include "resources/resource.hpp"
+
+#include "resources/mesh_resource.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Prism::Resources {
+    // Node hierarchy of an imported model and the meshes its nodes reference, Scene::AddModel turns every node into an entity.
+    struct ModelResource : ResourceImpl<ModelResource> {
+        static constexpr uint32_t NO_PARENT = UINT32_MAX;
+        static constexpr uint32_t NO_MESH = UINT32_MAX;
+
+        struct Node {
+            std::string name;
+            // Relative to the parent node.
+            glm::mat4 transform = glm::mat4(1.0f);
+            // Index into nodes, parents always precede their children.
+            uint32_t parent = NO_PARENT;
+            // Index into meshes, nodes instancing the same geometry share it.
+            uint32_t mesh = NO_MESH;
+        };
+
+        std::vector<Node> nodes = {};
+        std::vector<std::unique_ptr<MeshResource>> meshes = {};
+    };
+}; // namespace Prism::Resources
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "resources/resource.hpp"
+
+#include "resources/render_target_resource.hpp"
+
+#include <optional>
+#include <vector>
+
+namespace Prism::Resources {
+    // Render targets of frames in flight. Only one frame records into a slot at a time, so there is one target per frame in flight
+    // rather than per swapchain image. Targets survive swapchain recreation and are reused as long as the requested extent fits,
+    // rendering just covers a part of them - shrinking the window or resizing back never allocates.
+    struct RenderTargetPoolResource : ResourceImpl<RenderTargetPoolResource> {
+        RenderTargetPoolResource(VkDevice device, VmaAllocator allocator, uint32_t framesInFlight);
+        ~RenderTargetPoolResource() = default;
+
+        RenderTargetPoolResource(const RenderTargetPoolResource &other) = delete;
+        RenderTargetPoolResource &operator=(const RenderTargetPoolResource &other) = delete;
+
+        RenderTargetPoolResource(RenderTargetPoolResource &&other) noexcept;
+        RenderTargetPoolResource &operator=(RenderTargetPoolResource &&other) noexcept;
+
+        // Target at least as large as the extent. Has to be called after the fence of the frame slot was waited on, a target
+        // that is too small is recreated in place.
+        RenderTargetResource &Acquire(uint32_t frameOffset, VkExtent2D extent);
+
+        // Number of times a target had to be (re)created.
+        uint32_t GetAllocationCount() const { return allocationCount; }
+
+      private:
+        VkDevice device = VK_NULL_HANDLE;
+        VmaAllocator allocator = VK_NULL_HANDLE;
+
+        std::vector<std::optional<RenderTargetResource>> renderTargets = {};
+        uint32_t allocationCount = 0;
+
+        friend void swap(RenderTargetPoolResource &first, RenderTargetPoolResource &second) noexcept;
+    };
+} // namespace Prism::Resources
@@ -12,6 +12,8 @@ namespace Prism::Resources {
         enum RenderTargetCreationFlags {
             COLOR_ATTACHMENT = 1u << 0,
             DEPTH_STENCIL_ATTACHMENT = 1u << 1,
+            // Depth is never read after the frame, tile based GPUs can keep it in on-chip memory only.
+            TRANSIENT_DEPTH_STENCIL_ATTACHMENT = 1u << 2,
         };
 
         RenderTargetResource(VkDevice device, VmaAllocator allocator, VkExtent2D extent, uint32_t flags);
@@ -36,6 +38,9 @@ namespace Prism::Resources {
 
         VkFormat GetColorFormat() const { return COLOR_FORMAT; }
 
+        // Size of the attachments, rendering may use only a part of them.
+        VkExtent2D GetExtent() const { return extent; }
+
       private:
         // For now, maybe in the future parametrize it. TODO: Move it to VulkanResource
         VkFormat COLOR_FORMAT = VK_FORMAT_B8G8R8A8_SRGB;
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace Prism::Resources {
+    // 32 bit reference to a resource of a ResourcePool. Generation of the slot is stored next to its index, so a handle
+    // of a removed resource stays invalid even after its slot is reused.
+    template <typename T> struct ResourceHandle {
+        static constexpr uint32_t INDEX_BITS = 20;
+        static constexpr uint32_t GENERATION_BITS = 32 - INDEX_BITS;
+        static constexpr uint32_t MAX_INDEX = (1u << INDEX_BITS) - 1;
+        static constexpr uint32_t MAX_GENERATION = (1u << GENERATION_BITS) - 1;
+        static constexpr uint32_t INVALID_VALUE = UINT32_MAX;
+
+        uint32_t value = INVALID_VALUE;
+
+        static ResourceHandle Create(uint32_t index, uint32_t generation) { return {(generation << INDEX_BITS) | index}; }
+
+        uint32_t GetIndex() const { return value & MAX_INDEX; }
+
+        uint32_t GetGeneration() const { return value >> INDEX_BITS; }
+
+        bool IsValid() const { return value != INVALID_VALUE; }
+
+        bool operator==(const ResourceHandle &other) const = default;
+    };
+
+    // Resources of a single type. Slots live in a deque that only ever grows and a removed resource is destroyed in place, so a
+    // reference stays valid until its own resource is removed - inserting or removing others never moves it.
+    template <typename T> struct ResourcePool {
+        using Handle = ResourceHandle<T>;
+
+        ResourcePool() = default;
+        ~ResourcePool() = default;
+
+        ResourcePool(const ResourcePool &other) = delete;
+        ResourcePool &operator=(const ResourcePool &other) = delete;
+
+        ResourcePool(ResourcePool &&other) noexcept = default;
+        ResourcePool &operator=(ResourcePool &&other) noexcept = default;
+
+        template <typename... Args> Handle Emplace(Args &&...args) {
+            if (freeSlots.empty()) {
+                // Last index is left out, with the last generation it would spell INVALID_VALUE.
+                if (slots.size() >= Handle::MAX_INDEX) {
+                    throw std::runtime_error("Resource pool is full!");
+                }
+                freeSlots.push_back(static_cast<uint32_t>(slots.size()));
+                slots.emplace_back();
+            }
+
+            // Slot is taken once the resource is constructed, a throwing constructor leaves it free.
+            const uint32_t slotIndex = freeSlots.back();
+            auto &slot = slots[slotIndex];
+            slot.resource.emplace(std::forward<Args>(args)...);
+            freeSlots.pop_back();
+            size++;
+
+            return Handle::Create(slotIndex, slot.generation);
+        }
+
+        Handle Insert(T &&resource) { return Emplace(std::move(resource)); }
+
+        // Returns false when the handle no longer refers to a resource.
+        bool Remove(Handle handle) {
+            if (!Contains(handle)) {
+                return false;
+            }
+
+            releaseSlot(handle.GetIndex());
+            size--;
+            return true;
+        }
+
+        bool Contains(Handle handle) const {
+            if (!handle.IsValid() || handle.GetIndex() >= slots.size()) {
+                return false;
+            }
+
+            const auto &slot = slots[handle.GetIndex()];
+            return slot.generation == handle.GetGeneration() && slot.resource.has_value();
+        }
+
+        T *Get(Handle handle) { return Contains(handle) ? &*slots[handle.GetIndex()].resource : nullptr; }
+
+        const T *Get(Handle handle) const { return Contains(handle) ? &*slots[handle.GetIndex()].resource : nullptr; }
+
+        // Invalidates all handles.
+        void Clear() {
+            freeSlots.clear();
+            for (uint32_t i = 0; i < slots.size(); i++) {
+                releaseSlot(i);
+            }
+            size = 0;
+        }
+
+        size_t Size() const { return size; }
+
+      private:
+        struct Slot {
+            std::optional<T> resource = std::nullopt;
+            uint32_t generation = 0;
+        };
+
+        std::deque<Slot> slots = {};
+        std::vector<uint32_t> freeSlots = {};
+        size_t size = 0;
+
+        void releaseSlot(uint32_t slotIndex) {
+            auto &slot = slots[slotIndex];
+            slot.resource.reset();
+
+            // Slots that ran out of generations are retired, so an old handle can never match again.
+            if (slot.generation == Handle::MAX_GENERATION) {
+                return;
+            }
+            slot.generation++;
+            freeSlots.push_back(slotIndex);
+        }
+    };
+} // namespace Prism::Resources
@@ -1,17 +1,25 @@
 #pragma once
 
 #include "resources/resource.hpp"
+#include "resources/resource_pool.hpp"
 
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <optional>
 #include <stdexcept>
 #include <type_traits>
+#include <typeinfo>
 #include <unordered_map>
 #include <vector>
-#include <optional>
 
 namespace Prism::Resources {
 
+    // Resources of every type live in their own ResourcePool. Hot paths keep the handle returned on insertion and
+    // resolve it without hashing, lookups by ID & index remain for resources that are shared by name.
     struct ResourceStorage {
+        template <typename T> using Handle = ResourceHandle<T>;
+
         ResourceStorage() = default;
         ~ResourceStorage() = default;
         ResourceStorage(const ResourceStorage &) = delete;
@@ -20,46 +28,147 @@ namespace Prism::Resources {
         ResourceStorage(ResourceStorage &&) noexcept = default;
         ResourceStorage &operator=(ResourceStorage &&) noexcept = default;
 
+        // Replaces resource previously stored under the same ID & index. Pools hold resources by value, so a resource of a
+        // type derived from T is rejected instead of being sliced.
+        template <typename T>
+            requires std::is_base_of<Resources::Resource, T>::value
+        Handle<T> Emplace(Resource::ID id, T &&resource, size_t index = 0) {
+            if (typeid(resource) != typeid(T)) {
+                throw std::runtime_error("Resource has to be stored with its own type!");
+            }
+
+            auto &entries = namedResources[id];
+            if (index >= entries.size()) {
+                entries.resize(index + 1);
+            }
+
+            auto &entry = entries[index];
+            if (entry.pool != nullptr) {
+                entry.pool->Remove(entry.handle);
+            }
+
+            auto &pool = getPool<T>();
+            auto handle = pool.resources.Insert(std::move(resource));
+            entry = {T::TYPE_ID, handle.value, &pool};
+
+            return handle;
+        }
+
         template <typename T>
             requires std::is_base_of<Resources::Resource, T>::value
-        void Insert(Resource::ID id, std::unique_ptr<T> resource, size_t index = 0) {
-            auto &storedResources = resources[id];
-            if (index >= storedResources.size()) {
-                storedResources.resize(index + 1);
+        Handle<T> Insert(Resource::ID id, std::unique_ptr<T> resource, size_t index = 0) {
+            if (resource == nullptr) {
+                throw std::runtime_error("Can't insert a null resource!");
             }
-            storedResources[index] = std::move(resource);
+            return Emplace<T>(id, std::move(*resource), index);
         }
 
         void Delete(Resource::ID id, size_t index = 0) {
-            auto &storedResources = resources[id];
-            if (index < storedResources.size()) {
-                storedResources.erase(storedResources.begin() + index);
+            auto &entries = namedResources[id];
+            if (index < entries.size()) {
+                if (entries[index].pool != nullptr) {
+                    entries[index].pool->Remove(entries[index].handle);
+                }
+                entries.erase(entries.begin() + index);
             }
         }
 
         template <typename T>
             requires std::is_base_of<Resource, T>::value
         std::optional<std::reference_wrapper<T>> Get(Resource::ID id, size_t index = 0) const {
-            auto it = resources.find(id);
-            if (it == resources.end()) {
+            auto it = namedResources.find(id);
+            if (it == namedResources.end()) {
                 return std::nullopt;
             }
-            auto &storedResources = it->second;
+            auto &entries = it->second;
 
-            if (index < storedResources.size()) {
-                if (storedResources[index] == nullptr) {
+            if (index < entries.size() && entries[index].pool != nullptr) {
+                if (entries[index].typeId != T::TYPE_ID) {
+                    throw std::runtime_error("Resource is stored with a different type!");
+                }
+
+                auto *resource = static_cast<TypedPool<T> *>(entries[index].pool)->resources.Get(Handle<T>{entries[index].handle});
+                if (resource == nullptr) {
                     throw std::runtime_error("It shouldn't be that way - check that!");
                 }
-                return static_cast<T &>(*storedResources[index]);
+                return *resource;
             }
 
             return std::nullopt;
         }
 
-        void Clear() { resources.clear(); }
+        // O(1) without hashing. Returns nullptr once the resource was replaced or deleted. Resolved pointers & references stay
+        // valid until that happens, other inserts & removals never move a resource.
+        template <typename T>
+            requires std::is_base_of<Resource, T>::value
+        T *Get(Handle<T> handle) const {
+            const auto typeIndex = getTypeIndex<T>();
+            if (typeIndex >= pools.size() || pools[typeIndex] == nullptr) {
+                return nullptr;
+            }
+            return static_cast<TypedPool<T> &>(*pools[typeIndex]).resources.Get(handle);
+        }
+
+        // Pools are emptied rather than destroyed, so their generations keep invalidating old handles.
+        void Clear() {
+            namedResources.clear();
+            for (auto &pool : pools) {
+                if (pool != nullptr) {
+                    pool->Clear();
+                }
+            }
+        }
 
       private:
-        std::unordered_map<Resource::ID, std::vector<std::unique_ptr<Resources::Resource>>> resources = {};
+        struct PoolBase {
+            virtual ~PoolBase() = default;
+            virtual void Remove(uint32_t handle) = 0;
+            virtual void Clear() = 0;
+        };
+
+        template <typename T> struct TypedPool : PoolBase {
+            ResourcePool<T> resources = {};
+
+            void Remove(uint32_t handle) override { resources.Remove(Handle<T>{handle}); }
+
+            void Clear() override { resources.Clear(); }
+        };
+
+        // Type is kept to catch lookups with a wrong type, pool to resolve the handle without another lookup.
+        struct NamedEntry {
+            Resource::TypeID typeId = 0;
+            uint32_t handle = ResourceHandle<void>::INVALID_VALUE;
+            PoolBase *pool = nullptr;
+        };
+
+        // Sequential index of every resource type, so pools are found by indexing instead of hashing TYPE_ID. Types can be
+        // seen first from different threads, so the counter is atomic.
+        static uint32_t nextTypeIndex() {
+            static std::atomic<uint32_t> typeCount = 0;
+            return typeCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        template <typename T> static uint32_t getTypeIndex() {
+            static const uint32_t typeIndex = nextTypeIndex();
+            return typeIndex;
+        }
+
+        template <typename T> TypedPool<T> &getPool() {
+            const auto typeIndex = getTypeIndex<T>();
+            if (typeIndex >= pools.size()) {
+                pools.resize(typeIndex + 1);
+            }
+
+            auto &pool = pools[typeIndex];
+            if (pool == nullptr) {
+                pool = std::make_unique<TypedPool<T>>();
+            }
+            return static_cast<TypedPool<T> &>(*pool);
+        }
+
+        // Indexed by getTypeIndex.
+        std::vector<std::unique_ptr<PoolBase>> pools = {};
+        std::unordered_map<Resource::ID, std::vector<NamedEntry>> namedResources = {};
     };
 
-} // namespace Prism::Resources
\ No newline at end of file
+} // namespace Prism::Resources
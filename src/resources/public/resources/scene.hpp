@@ -3,19 +3,23 @@
 #include "resources/resource.hpp"
 
 #include "resources/mesh_resource.hpp"
+#include "resources/model_resource.hpp"
+#include "resources/scene_bvh.hpp"
 
 #include <entt/entt.hpp>
 
 
+#include <cstdint>
 #include <optional>
+#include <string>
 #include <utility>
 
 namespace Prism::Resources {
     struct Scene : ResourceImpl<Scene> {
-        Scene() = default;
+        Scene();
         ~Scene() = default;
 
-        Scene &operator=(Scene &&other) = default;
+        Scene &operator=(Scene &&other) noexcept;
         Scene(Scene &&other) = default;
 
         // For now, will be implemented in the future. Scene should be copyable.
@@ -28,11 +32,26 @@ namespace Prism::Resources {
 
         void AddNewMesh(Resources::MeshResource::ID id, std::string name, std::unique_ptr<Resources::MeshResource> meshResource);
 
+        // Registers a mesh without creating an entity for it, e.g. one shared by entities created elsewhere.
+        void AddMeshResource(Resources::MeshResource::ID id, std::unique_ptr<Resources::MeshResource> meshResource);
+
+        // Creates an entity per node of the model, parented like the nodes are. Returns the root entity, which is named after the model -
+        // unless it is parented to a given parent, which is then expected to carry the name.
+        entt::entity AddModel(const std::string &name, ModelResource &&model, entt::entity parent = entt::null);
+
         void RemoveMesh(Resources::MeshResource::ID meshId);
 
+        // Spatial index of mesh entities, brought up to date with registry changes before it is returned.
+        SceneBvh &GetSpatialIndex();
+
       private:
         entt::registry m_registry;
 
         std::unordered_map<Resources::MeshResource::ID, std::unique_ptr<Resources::MeshResource>> m_meshes;
+        // Counts models added, mesh IDs of every model are derived from it so models sharing a name don't replace each other's meshes.
+        uint64_t m_addedModelCount = 0;
+
+        // Declared after the registry, so it disconnects from registry signals before the registry is destroyed.
+        std::unique_ptr<SceneBvh> m_spatialIndex;
     };
 }; // namespace Prism::Resources
\ No newline at end of file
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "resources/mesh_resource.hpp"
+
+#include "utils/frustum_culling.hpp"
+
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+
+#include <limits>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace Prism::Resources {
+    struct Scene;
+
+    // Bounding volume hierarchy over world space bounds of mesh entities. Built with binned SAH, large subtrees are built on
+    // worker threads. Listens to registry signals - transform changes are refitted, added or removed meshes trigger a rebuild.
+    // Follows Components::WorldTransform, which TransformSystem replaces only for entities that moved.
+    class SceneBvh {
+      public:
+        using BoundingBox = MeshResource::BoundingBox;
+
+        struct RayHit {
+            entt::entity entity = entt::null;
+            float distance = 0.0f;
+        };
+
+        SceneBvh(entt::registry &registry);
+        ~SceneBvh() = default;
+
+        SceneBvh(SceneBvh &other) = delete;
+        SceneBvh &operator=(SceneBvh &other) = delete;
+
+        // Signals are connected to this instance.
+        SceneBvh(SceneBvh &&other) = delete;
+        SceneBvh &operator=(SceneBvh &&other) = delete;
+
+        // Applies changes collected since the last call.
+        void Refresh(Scene &scene);
+
+        void QueryFrustum(const Utils::Culling::Frustum &frustum, std::vector<entt::entity> &entities) const;
+
+        void QueryBox(const BoundingBox &box, std::vector<entt::entity> &entities) const;
+
+        // Closest entity whose bounds are hit by the ray, direction doesn't have to be normalized.
+        std::optional<RayHit> Raycast(const glm::vec3 &origin, const glm::vec3 &direction, float maxDistance = std::numeric_limits<float>::max()) const;
+
+        size_t GetEntityCount() const { return m_primitiveIndices.size(); }
+
+        size_t GetNodeCount() const { return m_nodes.size(); }
+
+      private:
+        static constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+
+        struct Node {
+            BoundingBox bounds = {};
+            // Leaves reference primitives, inner nodes their children.
+            uint32_t firstPrimitive = 0;
+            uint32_t primitiveCount = 0;
+            uint32_t left = INVALID_INDEX;
+            uint32_t right = INVALID_INDEX;
+            uint32_t parent = INVALID_INDEX;
+
+            bool IsLeaf() const { return primitiveCount > 0; }
+        };
+
+        struct Primitive {
+            // Null for entities removed since the last build.
+            entt::entity entity = entt::null;
+            BoundingBox bounds = {};
+            uint32_t leaf = INVALID_INDEX;
+        };
+
+        void onChanged(entt::registry &, entt::entity entity);
+
+        void onRemoved(entt::registry &, entt::entity entity);
+
+        void rebuild(Scene &scene);
+
+        uint32_t buildNode(std::vector<Node> &nodes, uint32_t begin, uint32_t end, uint32_t depth);
+
+        void refit(uint32_t nodeIndex);
+
+        std::vector<Node> m_nodes;
+        std::vector<Primitive> m_primitives;
+        std::unordered_map<entt::entity, uint32_t> m_primitiveIndices;
+
+        entt::sparse_set m_dirtyEntities;
+        bool m_rebuildRequired = true;
+        // Refits loosen the tree, it is rebuilt once as many primitives were refitted or removed as it holds.
+        size_t m_changesSinceBuild = 0;
+
+        std::vector<entt::scoped_connection> m_connections;
+    };
+} // namespace Prism::Resources
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "resources/resource.hpp"
+
+#include "resources/vulkan/vk_buffer_resource.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <optional>
+
+namespace Prism::Resources {
+    // Persistently mapped buffer for transient uniform & storage data, written by the CPU and read by the GPU within the same frame.
+    // Every frame owns a region that is filled linearly and reset as a whole, so allocating is a pointer bump without driver calls.
+    // Descriptors point at the whole buffer once and allocations are selected with dynamic offsets.
+    struct UniformRingResource : ResourceImpl<UniformRingResource> {
+        static constexpr VkDeviceSize DEFAULT_FRAME_CAPACITY = 256 * 1024;
+
+        struct Allocation {
+            // Dynamic offset to bind the allocation with.
+            uint32_t offset = 0;
+            void *data = nullptr;
+        };
+
+        UniformRingResource(VmaAllocator allocator, VkPhysicalDevice physicalDevice, uint32_t framesInFlight,
+                            VkDeviceSize frameCapacity = DEFAULT_FRAME_CAPACITY);
+        ~UniformRingResource();
+
+        UniformRingResource(const UniformRingResource &other) = delete;
+        UniformRingResource &operator=(const UniformRingResource &other) = delete;
+
+        UniformRingResource(UniformRingResource &&other) noexcept;
+        UniformRingResource &operator=(UniformRingResource &&other) noexcept;
+
+        // Has to be called once per frame, before any system allocates.
+        void BeginFrame();
+
+        // Makes writes of the current frame visible to the device, has to be called once all of them are done, before the frame is submitted.
+        void Flush();
+
+        // Returns nullopt when the region of this frame is full. Data is only valid until the frame finishes on the GPU.
+        std::optional<Allocation> Allocate(VkDeviceSize size);
+
+        template <typename T> std::optional<uint32_t> Write(const T &value) {
+            auto allocation = Allocate(sizeof(T));
+            if (!allocation) {
+                return std::nullopt;
+            }
+
+            std::memcpy(allocation->data, &value, sizeof(T));
+            return allocation->offset;
+        }
+
+        VkBuffer GetBuffer() const { return buffer.GetBuffer(); }
+
+        VkDeviceSize GetFrameCapacity() const { return frameCapacity; }
+
+        // Bytes allocated in the region of the current frame.
+        VkDeviceSize GetUsedSize() const { return head - currentRegion * frameCapacity; }
+
+      private:
+        VmaAllocator allocator = VK_NULL_HANDLE;
+        VkBufferResource<> buffer = {};
+        std::byte *mappedData = nullptr;
+
+        // Satisfies uniform & storage buffer offset alignment and the non coherent atom size.
+        VkDeviceSize alignment = 1;
+        VkDeviceSize frameCapacity = 0;
+
+        uint32_t regionCount = 0;
+        uint32_t currentRegion = 0;
+        // Absolute offset of the next allocation.
+        VkDeviceSize head = 0;
+
+        friend void swap(UniformRingResource &first, UniformRingResource &second) noexcept;
+    };
+} // namespace Prism::Resources
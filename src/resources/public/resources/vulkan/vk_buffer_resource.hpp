@@ -11,6 +11,28 @@
 #include <utility>
 
 namespace Prism::Resources {
+    // What descriptors, binds & indirect draws refer to - the whole buffer when it is dedicated, a range of a shared one otherwise.
+    struct BufferRange {
+        VkBuffer buffer = VK_NULL_HANDLE;
+        VkDeviceSize offset = 0;
+        VkDeviceSize size = 0;
+
+        bool operator==(const BufferRange &other) const = default;
+    };
+
+    // Range handed out by BufferArenaResource, returned to its virtual block when the buffer resource is destroyed.
+    struct VkBufferSuballocation {
+        BufferRange range = {};
+        VmaVirtualBlock virtualBlock = VK_NULL_HANDLE;
+        VmaVirtualAllocation virtualAllocation = VK_NULL_HANDLE;
+        // Of the whole block, used to flush the range.
+        VmaAllocator allocator = VK_NULL_HANDLE;
+        VmaAllocation blockAllocation = VK_NULL_HANDLE;
+        // Start of the range, null when the block isn't host visible.
+        std::byte *mappedData = nullptr;
+    };
+
+    // Either owns a dedicated VkBuffer or a suballocated range of a shared one. Anything binding the buffer has to use GetOffset.
     template <typename T = void> struct VkBufferResource : ResourceImpl<VkBufferResource<T>> {
       private:
         VkBuffer buffer = VK_NULL_HANDLE;
@@ -18,6 +40,13 @@ namespace Prism::Resources {
         VmaAllocation allocation = VK_NULL_HANDLE;
         VmaAllocator allocator = VK_NULL_HANDLE;
 
+        // Suballocated ranges only.
+        VkDeviceSize offset = 0;
+        VmaVirtualBlock virtualBlock = VK_NULL_HANDLE;
+        VmaVirtualAllocation virtualAllocation = VK_NULL_HANDLE;
+        VmaAllocation blockAllocation = VK_NULL_HANDLE;
+        std::byte *mappedData = nullptr;
+
       public:
         VkBufferResource() = default;
 
@@ -39,8 +68,15 @@ namespace Prism::Resources {
             }
         }
 
+        explicit VkBufferResource(const VkBufferSuballocation &suballocation)
+            : buffer(suballocation.range.buffer), bufferSize(suballocation.range.size), allocator(suballocation.allocator), offset(suballocation.range.offset),
+              virtualBlock(suballocation.virtualBlock), virtualAllocation(suballocation.virtualAllocation), blockAllocation(suballocation.blockAllocation),
+              mappedData(suballocation.mappedData) {}
+
         ~VkBufferResource() {
-            if (buffer != VK_NULL_HANDLE && allocation != VK_NULL_HANDLE && allocator != VK_NULL_HANDLE) {
+            if (virtualBlock != VK_NULL_HANDLE) {
+                vmaVirtualFree(virtualBlock, virtualAllocation);
+            } else if (buffer != VK_NULL_HANDLE && allocation != VK_NULL_HANDLE && allocator != VK_NULL_HANDLE) {
                 vmaDestroyBuffer(allocator, buffer, allocation);
             }
         }
@@ -51,6 +87,11 @@ namespace Prism::Resources {
             swap(first.bufferSize, second.bufferSize);
             swap(first.allocation, second.allocation);
             swap(first.allocator, second.allocator);
+            swap(first.offset, second.offset);
+            swap(first.virtualBlock, second.virtualBlock);
+            swap(first.virtualAllocation, second.virtualAllocation);
+            swap(first.blockAllocation, second.blockAllocation);
+            swap(first.mappedData, second.mappedData);
         }
 
         VkBufferResource(VkBufferResource &&other) noexcept { swap(*this, other); }
@@ -67,10 +108,63 @@ namespace Prism::Resources {
 
         VkBuffer GetBuffer() const { return buffer; }
 
+        // Null for suballocated ranges, the allocation belongs to the whole block.
         VmaAllocation GetAllocation() const { return allocation; }
 
         VkDeviceSize GetBufferSize() const { return bufferSize; }
 
+        VkDeviceSize GetOffset() const { return offset; }
+
+        BufferRange GetRange() const { return {buffer, offset, bufferSize}; }
+
+        bool IsSuballocated() const { return virtualBlock != VK_NULL_HANDLE; }
+
+        // Start of the buffer's own range, null when it isn't host visible. Ranges of an arena stay mapped, Unmap is a no-op for them.
+        void *Map() {
+            if (IsSuballocated()) {
+                return mappedData;
+            }
+
+            void *data = nullptr;
+            if (allocation == VK_NULL_HANDLE || vmaMapMemory(allocator, allocation, &data) != VK_SUCCESS) {
+                return nullptr;
+            }
+            return data;
+        }
+
+        void Unmap() {
+            if (!IsSuballocated() && allocation != VK_NULL_HANDLE) {
+                vmaUnmapMemory(allocator, allocation);
+            }
+        }
+
+        // Makes host writes to a part of the buffer's own range visible to the device. Host visible memory isn't always coherent,
+        // no-op when it is.
+        void Flush(VkDeviceSize rangeOffset = 0, VkDeviceSize size = VK_WHOLE_SIZE) {
+            if (size == VK_WHOLE_SIZE) {
+                size = bufferSize - rangeOffset;
+            }
+
+            if (IsSuballocated()) {
+                vmaFlushAllocation(allocator, blockAllocation, offset + rangeOffset, size);
+            } else if (allocation != VK_NULL_HANDLE) {
+                vmaFlushAllocation(allocator, allocation, rangeOffset, size);
+            }
+        }
+
+        // Makes device writes to a part of the buffer's own range visible to the host, counterpart of Flush.
+        void Invalidate(VkDeviceSize rangeOffset = 0, VkDeviceSize size = VK_WHOLE_SIZE) {
+            if (size == VK_WHOLE_SIZE) {
+                size = bufferSize - rangeOffset;
+            }
+
+            if (IsSuballocated()) {
+                vmaInvalidateAllocation(allocator, blockAllocation, offset + rangeOffset, size);
+            } else if (allocation != VK_NULL_HANDLE) {
+                vmaInvalidateAllocation(allocator, allocation, rangeOffset, size);
+            }
+        }
+
         constexpr VkDeviceSize GetElementSize() const
             requires(!std::is_void_v<T>)
         {
@@ -6,6 +6,9 @@
 #include "vk_mem_alloc.h"
 #include "vulkan/vulkan.h"
 
+#include <cstddef>
+#include <cstdint>
+#include <deque>
 #include <vector>
 
 namespace Prism::Resources {
@@ -14,9 +17,24 @@ namespace Prism::Resources {
         VkBufferCopy region;
     };
 
+    // Persistently mapped ring of fixed size chunks that uploads are written into. Chunks are handed out in ring order and retired by the
+    // value of the frame timeline that committed them last, so memory is reused once the GPU is done with it instead of growing.
+    // Copies that don't fit even after waiting for the oldest chunk are kept on the CPU and staged over the following frames.
     struct VkStagingBufferResource : ResourceImpl<VkStagingBufferResource> {
-        VkStagingBufferResource(VmaAllocator allocator);
-        ~VkStagingBufferResource() = default;
+        static constexpr VkDeviceSize DEFAULT_BUDGET = 64 * 1024 * 1024;
+        static constexpr uint32_t CHUNK_COUNT = 16;
+
+        // Of the last Commit.
+        struct FrameStats {
+            VkDeviceSize uploadedBytes = 0;
+            // Still waiting for a chunk after the commit.
+            VkDeviceSize deferredBytes = 0;
+            // Spent waiting for chunks to retire since the previous commit.
+            double stallTimeMs = 0.0;
+        };
+
+        VkStagingBufferResource(VmaAllocator allocator, VkDevice device, VkSemaphore frameTimelineSemaphore, VkDeviceSize budget = DEFAULT_BUDGET);
+        ~VkStagingBufferResource();
 
         VkStagingBufferResource(VkStagingBufferResource &&other) noexcept;
 
@@ -25,20 +43,70 @@ namespace Prism::Resources {
         VkStagingBufferResource(const VkStagingBufferResource &) = delete;
         VkStagingBufferResource &operator=(const VkStagingBufferResource &) = delete;
 
-        void Copy(VkBuffer destination, void *data, size_t size);
+        // Returns the id of the copy, see IsStaged. Stalls when the ring is full of chunks of frames still in flight.
+        uint64_t Copy(VkBuffer destination, const void *data, size_t size, VkDeviceSize destinationOffset = 0);
+
+        // Whether the copy and all before it are in the ring, so the next Commit records them. Copies larger than the free part of the
+        // budget are staged in pieces over several frames - their destination must not be read before then.
+        bool IsStaged(uint64_t copyId) const { return copyId <= stagedCopyId; }
+
+        // Id of the last Copy call.
+        uint64_t GetLastCopyId() const { return lastCopyId; }
+
+        // Stages copies deferred by earlier frames into chunks retired by now, has to be called once per frame before Commit.
+        void BeginFrame(uint64_t completedFrameNumber);
+
+        // Records pending copies into a command buffer that is already recording, returns whether there were any. Chunks they were
+        // read from are retired once frameNumber is reached on the frame timeline, the frame has to wait for the copies to complete.
+        bool Commit(VkCommandBuffer commandBuffer, uint64_t frameNumber);
 
-        void Commit(VkCommandBuffer commandBuffer);
+        // Copies recorded by the next Commit.
+        const std::vector<PendingCopy> &GetPendingCopies() const { return pendingCopies; }
+
+        const FrameStats &GetLastFrameStats() const { return lastFrameStats; }
 
       private:
-        static constexpr const VkDeviceSize INITIAL_SIZE = 10000;
+        struct Chunk {
+            VkDeviceSize used = 0;
+            uint64_t retireFrame = 0;
+        };
+
+        // Copy, or what is left of it, waiting for ring space.
+        struct DeferredCopy {
+            uint64_t id;
+            VkBuffer destination;
+            VkDeviceSize destinationOffset;
+            std::vector<std::byte> data;
+            size_t written = 0;
+        };
+
         friend void swap(VkStagingBufferResource &first, VkStagingBufferResource &second) noexcept;
 
+        // Writes as much as fits, returns the number of bytes written.
+        size_t write(VkBuffer destination, const std::byte *data, size_t size, VkDeviceSize destinationOffset, bool allowStall);
+        bool acquireNextChunk(bool allowStall);
+
         VmaAllocator allocator = VK_NULL_HANDLE;
+        VkDevice device = VK_NULL_HANDLE;
+        VkSemaphore frameTimelineSemaphore = VK_NULL_HANDLE;
 
         Resources::VkBufferResource<> stagingBuffer = {};
-        size_t currentlyUtilized = 0;
+        std::byte *mappedData = nullptr;
+        VkDeviceSize chunkSize = 0;
 
+        std::vector<Chunk> chunks = {};
+        uint32_t currentChunk = 0;
+        // Chunks written since the last commit, the current one included. When all of them are, the ring is full until the next frame.
+        uint32_t batchChunkCount = 1;
+        uint64_t completedFrame = 0;
 
         std::vector<PendingCopy> pendingCopies = {};
+        std::deque<DeferredCopy> deferredCopies = {};
+
+        uint64_t lastCopyId = 0;
+        uint64_t stagedCopyId = 0;
+
+        FrameStats lastFrameStats = {};
+        double stallTimeMs = 0.0;
     };
-} // namespace Prism::Resources
\ No newline at end of file
+} // namespace Prism::Resources
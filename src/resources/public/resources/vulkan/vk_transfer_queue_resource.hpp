@@ -0,0 +1,56 @@
+#pragma once
+
+#include "resources/resource.hpp"
+#include "resources/vulkan/vk_command_pool_resource.hpp"
+#include "resources/vulkan/vk_staging_buffer_resource.hpp"
+
+#include "vulkan/vulkan.h"
+
+#include <optional>
+#include <vector>
+
+namespace Prism::Resources {
+    // Uploads staged copies on a dedicated transfer queue, so large uploads overlap with rendering instead of being serialized with it.
+    // Written ranges are released to the graphics queue family, the acquire half is recorded into the frame that first reads them.
+    // Without a transfer only queue family the resource is unavailable and copies are recorded into the frame as before.
+    struct VkTransferQueueResource : ResourceImpl<VkTransferQueueResource> {
+        // Everything staged so far is geometry, read at vertex input. Frames waiting for an upload run their earlier stages meanwhile.
+        static constexpr VkPipelineStageFlags2 ACQUIRE_STAGE_MASK = VK_PIPELINE_STAGE_2_VERTEX_INPUT_BIT;
+
+        VkTransferQueueResource(VkDevice device, VkQueue transferQueue, uint32_t transferQueueFamilyIndex, uint32_t graphicsQueueFamilyIndex,
+                                uint32_t framesInFlight);
+        ~VkTransferQueueResource();
+
+        VkTransferQueueResource(const VkTransferQueueResource &) = delete;
+        VkTransferQueueResource &operator=(const VkTransferQueueResource &) = delete;
+
+        VkTransferQueueResource(VkTransferQueueResource &&other) noexcept;
+        VkTransferQueueResource &operator=(VkTransferQueueResource &&other) noexcept;
+
+        bool IsAvailable() const { return queue != VK_NULL_HANDLE; }
+
+        // Submits pending copies of the staging buffer & records their acquire barriers into graphicsCommandBuffer. Returns the value of
+        // GetTimelineSemaphore() the graphics submit has to wait for at ACQUIRE_STAGE_MASK, nullopt when nothing was staged. Command
+        // buffers are reused per frame slot, the frame of the slot that waited on the previous upload has to be finished. Staging chunks
+        // are retired with frameNumber, the frame waits for the upload.
+        std::optional<uint64_t> Submit(VkStagingBufferResource &stagingBuffer, VkCommandBuffer graphicsCommandBuffer, uint32_t frameOffset,
+                                       uint64_t frameNumber);
+
+        // Every upload signals the next value once its copies have finished.
+        VkSemaphore GetTimelineSemaphore() const { return timelineSemaphore; }
+
+      private:
+        friend void swap(VkTransferQueueResource &first, VkTransferQueueResource &second) noexcept;
+
+        VkDevice device = VK_NULL_HANDLE;
+        VkQueue queue = VK_NULL_HANDLE;
+        uint32_t transferQueueFamilyIndex = 0;
+        uint32_t graphicsQueueFamilyIndex = 0;
+
+        std::vector<VkCommandPoolResource> commandPools = {};
+        VkSemaphore timelineSemaphore = VK_NULL_HANDLE;
+        uint64_t submittedValue = 0;
+
+        std::vector<VkBufferMemoryBarrier2> barriers = {};
+    };
+} // namespace Prism::Resources
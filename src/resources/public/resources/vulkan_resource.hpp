@@ -2,6 +2,7 @@
 
 #include "resource.hpp"
 
+#include "utils/vulkan/common.hpp"
 #include "utils/vulkan/debug_messenger.hpp"
 
 #include "vulkan/vulkan.h"
@@ -16,7 +17,8 @@ namespace Prism::Resources {
     struct VulkanResource : ResourceImpl<VulkanResource> {
         VulkanResource(VkInstance instance, std::unique_ptr<Utils::Vulkan::DebugMessenger> debugMessenger, VkSurfaceKHR surface,
                        VkPhysicalDevice physicalDevice, VkDevice device, VmaAllocator allocator, VkQueue graphicsQueue, VkQueue presentationQueue,
-                       VkExtent2D swapchainExtent);
+                       VkQueue transferQueue, Utils::Vulkan::Common::QueueFamilyIndices queueFamilyIndices, VkExtent2D swapchainExtent,
+                       uint32_t framesInFlight = DEFAULT_FRAMES_IN_FLIGHT);
         ~VulkanResource();
 
         VulkanResource(const VulkanResource &other) = delete;
@@ -27,8 +29,13 @@ namespace Prism::Resources {
 
         void RecreateSwapchain(int newWidth, int newHeight);
 
+        // Starts recording of the next frame - waits until the frame that used its slot before has finished on the GPU and
+        // acquires a swapchain image.
         void AdvanceFrame();
 
+        // Headless resource has no surface and no swapchain, rendering ends in the offscreen render targets.
+        bool IsHeadless() const { return surface == VK_NULL_HANDLE; }
+
         // Getters
 
         VkInstance GetInstance() const { return instance; }
@@ -43,10 +50,15 @@ namespace Prism::Resources {
 
         VkQueue GetPresentationQueue() const { return presentationQueue; }
 
+        // VK_NULL_HANDLE when the device has no transfer only queue family, uploads are recorded on the graphics queue then.
+        VkQueue GetTransferQueue() const { return transferQueue; }
+
         uint32_t GetGraphicsQueueFamilyIndex() const { return graphicsQueueFamilyIndex; }
 
         uint32_t GetPresentationQueueFamilyIndex() const { return presentationQueueFamilyIndex; }
 
+        uint32_t GetTransferQueueFamilyIndex() const { return transferQueueFamilyIndex; }
+
         VkFormat GetSwapchainImageFormat() const { return swapchainImageFormat; }
 
         VkFormat GetSwapchainDepthFormat() const { return swapchainDepthFormat; }
@@ -65,19 +77,34 @@ namespace Prism::Resources {
 
         uint32_t GetCurrentImageIndex() const { return currentImageIndex; }
 
+        // Slot of per frame in flight resources the current frame records into.
         uint32_t GetCurrentFrameOffset() const { return currentFrameOffset; }
 
         VkSemaphore GetCurrentImageAcquiredSemaphore() const { return imageAcquiredSemaphores[currentFrameOffset]; }
 
-        VkFence GetCurrentFence() const { return fences[currentFrameOffset]; }
+        // Binary, as presentation can't wait on timeline semaphores. One per swapchain image, an image is only acquired again once
+        // its previous presentation has consumed the semaphore.
+        VkSemaphore GetCurrentRenderFinishedSemaphore() const { return renderFinishedSemaphores[currentImageIndex]; }
+
+        // Last submit of every frame signals this semaphore with the frame number.
+        VkSemaphore GetFrameTimelineSemaphore() const { return frameTimelineSemaphore; }
 
-        auto GetFramesInFlight() const { return FRAMES_IN_FLIGHT; }
+        // Number of the frame being recorded, starting at 1. Resources no longer used from now on can be released once
+        // GetCompletedFrameNumber() reaches it.
+        uint64_t GetFrameNumber() const { return frameNumber; }
+
+        // Number of the last frame the GPU has finished.
+        uint64_t GetCompletedFrameNumber() const;
+
+        uint32_t GetFramesInFlight() const { return framesInFlight; }
 
         auto &GetSwapchainBoundStorage() { return swapchainBoundResourceStorage; }
 
         auto &GetVmaAllocator() { return vmaAllocator; }
 
-        static constexpr auto FRAMES_IN_FLIGHT = 2;
+        static constexpr uint32_t MIN_FRAMES_IN_FLIGHT = 1;
+        static constexpr uint32_t MAX_FRAMES_IN_FLIGHT = 4;
+        static constexpr uint32_t DEFAULT_FRAMES_IN_FLIGHT = 2;
 
       private:
         VkSurfaceFormatKHR USED_SURFACE_FORMAT = {.format = VK_FORMAT_B8G8R8A8_SRGB, .colorSpace = VK_COLOR_SPACE_SRGB_NONLINEAR_KHR};
@@ -90,6 +117,7 @@ namespace Prism::Resources {
         VmaAllocator vmaAllocator = VK_NULL_HANDLE;
         VkQueue graphicsQueue = VK_NULL_HANDLE;
         VkQueue presentationQueue = VK_NULL_HANDLE;
+        VkQueue transferQueue = VK_NULL_HANDLE;
 
         VkFormat swapchainImageFormat = VK_FORMAT_B8G8R8A8_SRGB;
         VkFormat swapchainDepthFormat = VK_FORMAT_D32_SFLOAT_S8_UINT;
@@ -98,15 +126,20 @@ namespace Prism::Resources {
 
         std::vector<VkImage> swapchainImages = {};
         std::vector<VkImageView> swapchainImagesViews = {};
-        std::vector<VkFence> fences = {};
         std::vector<VkSemaphore> imageAcquiredSemaphores = {};
+        std::vector<VkSemaphore> renderFinishedSemaphores = {};
+        VkSemaphore frameTimelineSemaphore = VK_NULL_HANDLE;
+
+        uint32_t framesInFlight = DEFAULT_FRAMES_IN_FLIGHT;
+        uint64_t frameNumber = 0;
 
         uint32_t imageCount = 0;
         uint32_t currentImageIndex = 0;
-        int32_t currentFrameOffset = 0;
+        uint32_t currentFrameOffset = 0;
 
         uint32_t graphicsQueueFamilyIndex = 0;
         uint32_t presentationQueueFamilyIndex = 0;
+        uint32_t transferQueueFamilyIndex = 0;
 
         Resources::ResourceStorage swapchainBoundResourceStorage = {};
 
@@ -119,6 +152,8 @@ namespace Prism::Resources {
         void createSwapchain(int newWidth, int newHeight);
         void createSwapchainImages();
         void createSwapchainImagesViews();
+
+        void createHeadlessTargets(int newWidth, int newHeight);
     };
 
 } // namespace Prism::Resources
\ No newline at end of file
@@ -20,6 +20,8 @@ namespace Prism::Resources {
 
         GLFWwindow *GetWindow() const { return window; }
 
+        bool IsHeadless() const { return window == nullptr; }
+
         std::pair<int, int> GetWindowExtent() { return std::make_pair(currentWidth, currentHeight); };
 
         void UpdateWindowExtent(int width, int height) {
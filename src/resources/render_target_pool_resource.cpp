@@ -0,0 +1,55 @@
+#include "resources/render_target_pool_resource.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace Prism::Resources {
+    RenderTargetPoolResource::RenderTargetPoolResource(VkDevice device, VmaAllocator allocator, uint32_t framesInFlight)
+        : device(device), allocator(allocator), renderTargets(framesInFlight) {}
+
+    RenderTargetPoolResource::RenderTargetPoolResource(RenderTargetPoolResource &&other) noexcept { swap(*this, other); }
+
+    RenderTargetPoolResource &RenderTargetPoolResource::operator=(RenderTargetPoolResource &&other) noexcept {
+        if (this != &other) {
+            swap(*this, other);
+        }
+        return *this;
+    }
+
+    void swap(RenderTargetPoolResource &first, RenderTargetPoolResource &second) noexcept {
+        using std::swap;
+        swap(first.device, second.device);
+        swap(first.allocator, second.allocator);
+        swap(first.renderTargets, second.renderTargets);
+        swap(first.allocationCount, second.allocationCount);
+    }
+
+    RenderTargetResource &RenderTargetPoolResource::Acquire(uint32_t frameOffset, VkExtent2D extent) {
+        if (frameOffset >= renderTargets.size()) {
+            throw std::runtime_error("Render target pool has no slot for this frame in flight!");
+        }
+
+        auto &renderTarget = renderTargets[frameOffset];
+
+        VkExtent2D allocatedExtent = renderTarget ? renderTarget->GetExtent() : VkExtent2D{0, 0};
+        if (extent.width <= allocatedExtent.width && extent.height <= allocatedExtent.height) {
+            return *renderTarget;
+        }
+
+        // Grows per dimension, so alternating between wide & tall windows settles on one allocation.
+        VkExtent2D newExtent = {std::max(extent.width, allocatedExtent.width), std::max(extent.height, allocatedExtent.height)};
+
+        uint32_t flags = 0;
+        flags |= RenderTargetResource::RenderTargetCreationFlags::COLOR_ATTACHMENT;
+        flags |= RenderTargetResource::RenderTargetCreationFlags::DEPTH_STENCIL_ATTACHMENT;
+        flags |= RenderTargetResource::RenderTargetCreationFlags::TRANSIENT_DEPTH_STENCIL_ATTACHMENT;
+
+        // Old target is destroyed first, so its memory can be reused by the new one.
+        renderTarget.reset();
+        renderTarget.emplace(device, allocator, newExtent, flags);
+        allocationCount++;
+
+        return *renderTarget;
+    }
+} // namespace Prism::Resources
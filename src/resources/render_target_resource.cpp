@@ -10,13 +10,20 @@ namespace Prism::Resources {
             VmaAllocation allocation = VK_NULL_HANDLE;
         };
 
-        ImageAllocation createImage(VmaAllocator allocator, const VkImageCreateInfo &imageInfo) {
+        ImageAllocation createImage(VmaAllocator allocator, const VkImageCreateInfo &imageInfo, bool lazilyAllocated = false) {
             ImageAllocation imageAllocation{};
 
             VmaAllocationCreateInfo allocInfo{};
-            allocInfo.usage = VMA_MEMORY_USAGE_AUTO;
+            allocInfo.usage = lazilyAllocated ? VMA_MEMORY_USAGE_GPU_LAZILY_ALLOCATED : VMA_MEMORY_USAGE_AUTO;
 
-            if (vmaCreateImage(allocator, &imageInfo, &allocInfo, &imageAllocation.image, &imageAllocation.allocation, nullptr) != VK_SUCCESS) {
+            auto result = vmaCreateImage(allocator, &imageInfo, &allocInfo, &imageAllocation.image, &imageAllocation.allocation, nullptr);
+            // Desktop GPUs usually have no lazily allocated memory type, transient images are fine in regular device memory.
+            if (result == VK_ERROR_FEATURE_NOT_PRESENT && lazilyAllocated) {
+                allocInfo.usage = VMA_MEMORY_USAGE_AUTO;
+                result = vmaCreateImage(allocator, &imageInfo, &allocInfo, &imageAllocation.image, &imageAllocation.allocation, nullptr);
+            }
+
+            if (result != VK_SUCCESS) {
                 throw std::runtime_error("Couldn't create an image for render target resource!");
             }
 
@@ -101,7 +108,12 @@ namespace Prism::Resources {
             imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
             imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
 
-            auto imageAllocation = createImage(allocator, imageInfo);
+            const bool transient = (flags & RenderTargetCreationFlags::TRANSIENT_DEPTH_STENCIL_ATTACHMENT) != 0;
+            if (transient) {
+                imageInfo.usage |= VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+            }
+
+            auto imageAllocation = createImage(allocator, imageInfo, transient);
 
             depthImage = imageAllocation.image;
             depthImageAllocation = imageAllocation.allocation;
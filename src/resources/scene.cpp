@@ -1,11 +1,28 @@
 #include "resources/scene.hpp"
 
 #include "components/mesh.hpp"
+#include "components/node.hpp"
 #include "components/transform.hpp"
 
+#include <cassert>
+#include <format>
 #include <functional>
+#include <vector>
 
 namespace Prism::Resources {
+    Scene::Scene() : m_spatialIndex(std::make_unique<SceneBvh>(m_registry)) {}
+
+    Scene &Scene::operator=(Scene &&other) noexcept {
+        if (this != &other) {
+            // Index is connected to signals of the current registry.
+            m_spatialIndex.reset();
+            m_registry = std::move(other.m_registry);
+            m_meshes = std::move(other.m_meshes);
+            m_addedModelCount = other.m_addedModelCount;
+            m_spatialIndex = std::move(other.m_spatialIndex);
+        }
+        return *this;
+    }
 
     std::optional<std::reference_wrapper<MeshResource>> Scene::GetMesh(Resources::MeshResource::ID resourceId) {
         auto it = m_meshes.find(resourceId);
@@ -21,9 +38,49 @@ namespace Prism::Resources {
 
         m_registry.emplace<Components::Mesh>(newMeshEntity, id, name);
         m_registry.emplace<Components::Transform>(newMeshEntity, glm::mat4(1.0f));
+        m_registry.emplace<Components::WorldTransform>(newMeshEntity, glm::mat4(1.0f));
+        AddMeshResource(id, std::move(meshResource));
+    }
+
+    void Scene::AddMeshResource(Resources::MeshResource::ID id, std::unique_ptr<Resources::MeshResource> meshResource) {
         m_meshes.insert({id, std::move(meshResource)});
     }
 
+    entt::entity Scene::AddModel(const std::string &name, ModelResource &&model, entt::entity parent) {
+        // Names aren't unique, e.g. the same model loaded twice, the model's index is.
+        const uint64_t modelIndex = m_addedModelCount++;
+
+        std::vector<Resources::MeshResource::ID> meshIds;
+        meshIds.reserve(model.meshes.size());
+        for (size_t i = 0; i < model.meshes.size(); i++) {
+            auto meshId = std::hash<std::string>{}(std::format("MeshResources/{}/{}/{}", modelIndex, name, i));
+            [[maybe_unused]] auto [meshIt, inserted] = m_meshes.insert({meshId, std::move(model.meshes[i])});
+            assert(inserted && "Mesh ID of the model collides with an existing mesh!");
+            meshIds.push_back(meshId);
+        }
+
+        std::vector<entt::entity> nodeEntities;
+        nodeEntities.reserve(model.nodes.size());
+        for (size_t i = 0; i < model.nodes.size(); i++) {
+            const auto &node = model.nodes[i];
+
+            auto nodeEntity = m_registry.create();
+            auto parentEntity = node.parent != ModelResource::NO_PARENT ? nodeEntities[node.parent] : parent;
+
+            m_registry.emplace<Components::Node>(nodeEntity, i == 0 && parent == entt::null ? name : node.name, parentEntity);
+            m_registry.emplace<Components::Transform>(nodeEntity, node.transform);
+            // Computed by TransformSystem, mesh is added afterwards so the spatial index sees the entity once it is complete.
+            m_registry.emplace<Components::WorldTransform>(nodeEntity);
+            if (node.mesh != ModelResource::NO_MESH) {
+                m_registry.emplace<Components::Mesh>(nodeEntity, meshIds[node.mesh], node.name);
+            }
+
+            nodeEntities.push_back(nodeEntity);
+        }
+
+        return nodeEntities.empty() ? entt::entity{entt::null} : nodeEntities.front();
+    }
+
     void Scene::RemoveMesh(Resources::MeshResource::ID meshId) {
         // Remove entities associated with this component
         auto meshView = m_registry.view<Components::Mesh>();
@@ -35,4 +92,9 @@ namespace Prism::Resources {
         m_meshes.erase(meshId);
     }
 
+    SceneBvh &Scene::GetSpatialIndex() {
+        m_spatialIndex->Refresh(*this);
+        return *m_spatialIndex;
+    }
+
 } // namespace Prism::Resources
\ No newline at end of file
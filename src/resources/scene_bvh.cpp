@@ -0,0 +1,475 @@
+#include "resources/scene_bvh.hpp"
+
+#include "resources/scene.hpp"
+
+#include "components/mesh.hpp"
+#include "components/transform.hpp"
+
+#include "utils/profiler.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <future>
+#include <thread>
+
+namespace Prism::Resources {
+    namespace {
+        constexpr uint32_t BIN_COUNT = 16;
+        constexpr uint32_t MAX_LEAF_SIZE = 4;
+        // Leaves up to this size are kept when splitting wouldn't lower SAH cost.
+        constexpr uint32_t MAX_SAH_LEAF_SIZE = 16;
+        // Smaller subtrees are cheaper to build than to hand over to another thread.
+        constexpr uint32_t PARALLEL_BUILD_THRESHOLD = 4096;
+
+        using BoundingBox = SceneBvh::BoundingBox;
+
+        BoundingBox getEmptyBox() { return {glm::vec3(std::numeric_limits<float>::max()), glm::vec3(std::numeric_limits<float>::lowest())}; }
+
+        bool isEmpty(const BoundingBox &box) { return box.min.x > box.max.x; }
+
+        void grow(BoundingBox &box, const BoundingBox &other) {
+            box.min = glm::min(box.min, other.min);
+            box.max = glm::max(box.max, other.max);
+        }
+
+        void grow(BoundingBox &box, const glm::vec3 &point) {
+            box.min = glm::min(box.min, point);
+            box.max = glm::max(box.max, point);
+        }
+
+        bool overlaps(const BoundingBox &lhs, const BoundingBox &rhs) {
+            return glm::all(glm::lessThanEqual(lhs.min, rhs.max)) && glm::all(glm::greaterThanEqual(lhs.max, rhs.min));
+        }
+
+        float getSurfaceArea(const BoundingBox &box) {
+            if (isEmpty(box)) {
+                return 0.0f;
+            }
+
+            glm::vec3 size = box.max - box.min;
+            return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+        }
+
+        glm::vec3 getCentroid(const BoundingBox &box) { return (box.min + box.max) * 0.5f; }
+
+        bool isVisible(const Utils::Culling::Frustum &frustum, const BoundingBox &box) {
+            return !isEmpty(box) && Utils::Culling::IntersectsBox(frustum, getCentroid(box), (box.max - box.min) * 0.5f);
+        }
+
+        // Returns distance to the box along the ray, or infinity when it is missed.
+        float intersectRay(const BoundingBox &box, const glm::vec3 &origin, const glm::vec3 &inverseDirection, float maxDistance) {
+            glm::vec3 t0 = (box.min - origin) * inverseDirection;
+            glm::vec3 t1 = (box.max - origin) * inverseDirection;
+            glm::vec3 tMin = glm::min(t0, t1);
+            glm::vec3 tMax = glm::max(t0, t1);
+
+            float nearDistance = std::max(std::max(tMin.x, tMin.y), std::max(tMin.z, 0.0f));
+            float farDistance = std::min(std::min(tMax.x, tMax.y), std::min(tMax.z, maxDistance));
+
+            return nearDistance <= farDistance ? nearDistance : std::numeric_limits<float>::infinity();
+        }
+
+        // World space box enclosing the transformed object space box.
+        BoundingBox transformBox(const glm::mat4 &model, const BoundingBox &box) {
+            glm::vec3 center = glm::vec3(model * glm::vec4(getCentroid(box), 1.0f));
+            glm::vec3 localExtent = (box.max - box.min) * 0.5f;
+            glm::vec3 extent = glm::abs(glm::vec3(model[0])) * localExtent.x + glm::abs(glm::vec3(model[1])) * localExtent.y +
+                               glm::abs(glm::vec3(model[2])) * localExtent.z;
+            return {center - extent, center + extent};
+        }
+
+        std::optional<BoundingBox> getWorldBounds(Scene &scene, entt::entity entity) {
+            auto &registry = scene.GetRegistry();
+            if (!registry.valid(entity) || !registry.all_of<Components::Mesh, Components::WorldTransform>(entity)) {
+                return std::nullopt;
+            }
+
+            auto meshOpt = scene.GetMesh(registry.get<Components::Mesh>(entity).resourceId);
+            if (!meshOpt) {
+                return std::nullopt;
+            }
+
+            return transformBox(registry.get<Components::WorldTransform>(entity).transform, meshOpt->get().GetBoundingBox());
+        }
+
+        // Every level below it doubles the number of threads building the tree.
+        uint32_t getMaxParallelDepth() {
+            static const uint32_t maxParallelDepth = std::bit_width(std::max(std::thread::hardware_concurrency(), 1u)) - 1;
+            return maxParallelDepth;
+        }
+
+        // Moves nodes of a subtree built on another thread to the end of nodes, returns index of its root.
+        template <typename Node> uint32_t appendSubtree(std::vector<Node> &nodes, const std::vector<Node> &subtree, uint32_t invalidIndex) {
+            const auto offset = static_cast<uint32_t>(nodes.size());
+            for (auto node : subtree) {
+                if (!node.IsLeaf()) {
+                    node.left += offset;
+                    node.right += offset;
+                }
+                if (node.parent != invalidIndex) {
+                    node.parent += offset;
+                }
+                nodes.push_back(node);
+            }
+            return offset;
+        }
+    } // namespace
+
+    SceneBvh::SceneBvh(entt::registry &registry) {
+        m_connections.reserve(6);
+        m_connections.emplace_back(registry.on_construct<Components::Mesh>().connect<&SceneBvh::onChanged>(*this));
+        m_connections.emplace_back(registry.on_update<Components::Mesh>().connect<&SceneBvh::onChanged>(*this));
+        m_connections.emplace_back(registry.on_construct<Components::WorldTransform>().connect<&SceneBvh::onChanged>(*this));
+        m_connections.emplace_back(registry.on_update<Components::WorldTransform>().connect<&SceneBvh::onChanged>(*this));
+        m_connections.emplace_back(registry.on_destroy<Components::Mesh>().connect<&SceneBvh::onRemoved>(*this));
+        m_connections.emplace_back(registry.on_destroy<Components::WorldTransform>().connect<&SceneBvh::onRemoved>(*this));
+    }
+
+    void SceneBvh::Refresh(Scene &scene) {
+        PRISM_PROFILE_SCOPE("SceneBvh::Refresh");
+
+        if (!m_rebuildRequired) {
+            for (auto entity : m_dirtyEntities) {
+                auto bounds = getWorldBounds(scene, entity);
+
+                auto it = m_primitiveIndices.find(entity);
+                if (it == m_primitiveIndices.end()) {
+                    // New entities don't have a leaf to be refitted into.
+                    if (bounds) {
+                        m_rebuildRequired = true;
+                        break;
+                    }
+                    continue;
+                }
+
+                auto &primitive = m_primitives[it->second];
+                if (bounds) {
+                    primitive.bounds = *bounds;
+                } else {
+                    // Mesh resource is gone, slot keeps empty bounds until the next rebuild.
+                    primitive.bounds = getEmptyBox();
+                }
+
+                refit(primitive.leaf);
+                m_changesSinceBuild++;
+            }
+        }
+
+        m_dirtyEntities.clear();
+
+        if (m_rebuildRequired || m_changesSinceBuild > m_primitives.size()) {
+            rebuild(scene);
+        }
+    }
+
+    void SceneBvh::QueryFrustum(const Utils::Culling::Frustum &frustum, std::vector<entt::entity> &entities) const {
+        if (m_nodes.empty()) {
+            return;
+        }
+
+        std::vector<uint32_t> stack = {0};
+        while (!stack.empty()) {
+            const auto &node = m_nodes[stack.back()];
+            stack.pop_back();
+
+            if (!isVisible(frustum, node.bounds)) {
+                continue;
+            }
+
+            if (!node.IsLeaf()) {
+                stack.push_back(node.left);
+                stack.push_back(node.right);
+                continue;
+            }
+
+            for (uint32_t i = node.firstPrimitive; i < node.firstPrimitive + node.primitiveCount; i++) {
+                const auto &primitive = m_primitives[i];
+                if (primitive.entity != entt::null && isVisible(frustum, primitive.bounds)) {
+                    entities.push_back(primitive.entity);
+                }
+            }
+        }
+    }
+
+    void SceneBvh::QueryBox(const BoundingBox &box, std::vector<entt::entity> &entities) const {
+        if (m_nodes.empty()) {
+            return;
+        }
+
+        std::vector<uint32_t> stack = {0};
+        while (!stack.empty()) {
+            const auto &node = m_nodes[stack.back()];
+            stack.pop_back();
+
+            if (!overlaps(node.bounds, box)) {
+                continue;
+            }
+
+            if (!node.IsLeaf()) {
+                stack.push_back(node.left);
+                stack.push_back(node.right);
+                continue;
+            }
+
+            for (uint32_t i = node.firstPrimitive; i < node.firstPrimitive + node.primitiveCount; i++) {
+                const auto &primitive = m_primitives[i];
+                if (primitive.entity != entt::null && overlaps(primitive.bounds, box)) {
+                    entities.push_back(primitive.entity);
+                }
+            }
+        }
+    }
+
+    std::optional<SceneBvh::RayHit> SceneBvh::Raycast(const glm::vec3 &origin, const glm::vec3 &direction, float maxDistance) const {
+        if (m_nodes.empty() || glm::dot(direction, direction) == 0.0f) {
+            return std::nullopt;
+        }
+
+        const glm::vec3 inverseDirection = 1.0f / glm::normalize(direction);
+
+        RayHit closestHit{};
+        closestHit.distance = maxDistance;
+
+        std::vector<uint32_t> stack = {0};
+        while (!stack.empty()) {
+            const auto &node = m_nodes[stack.back()];
+            stack.pop_back();
+
+            if (intersectRay(node.bounds, origin, inverseDirection, closestHit.distance) > closestHit.distance) {
+                continue;
+            }
+
+            if (node.IsLeaf()) {
+                for (uint32_t i = node.firstPrimitive; i < node.firstPrimitive + node.primitiveCount; i++) {
+                    const auto &primitive = m_primitives[i];
+                    if (primitive.entity == entt::null) {
+                        continue;
+                    }
+
+                    float distance = intersectRay(primitive.bounds, origin, inverseDirection, closestHit.distance);
+                    if (distance < closestHit.distance || (closestHit.entity == entt::null && distance <= closestHit.distance)) {
+                        closestHit = {primitive.entity, distance};
+                    }
+                }
+                continue;
+            }
+
+            // Nearer child is visited first, so it can shorten the ray for the farther one.
+            float leftDistance = intersectRay(m_nodes[node.left].bounds, origin, inverseDirection, closestHit.distance);
+            float rightDistance = intersectRay(m_nodes[node.right].bounds, origin, inverseDirection, closestHit.distance);
+            if (leftDistance < rightDistance) {
+                stack.push_back(node.right);
+                stack.push_back(node.left);
+            } else {
+                stack.push_back(node.left);
+                stack.push_back(node.right);
+            }
+        }
+
+        if (closestHit.entity == entt::null) {
+            return std::nullopt;
+        }
+
+        return closestHit;
+    }
+
+    void SceneBvh::onChanged(entt::registry &, entt::entity entity) {
+        if (!m_dirtyEntities.contains(entity)) {
+            m_dirtyEntities.push(entity);
+        }
+    }
+
+    void SceneBvh::onRemoved(entt::registry &, entt::entity entity) {
+        if (m_dirtyEntities.contains(entity)) {
+            m_dirtyEntities.remove(entity);
+        }
+
+        auto it = m_primitiveIndices.find(entity);
+        if (it == m_primitiveIndices.end()) {
+            return;
+        }
+
+        // Slot is kept until the next rebuild, so leaf ranges stay valid.
+        auto &primitive = m_primitives[it->second];
+        primitive.entity = entt::null;
+        primitive.bounds = getEmptyBox();
+        refit(primitive.leaf);
+
+        m_primitiveIndices.erase(it);
+        m_changesSinceBuild++;
+    }
+
+    void SceneBvh::rebuild(Scene &scene) {
+        PRISM_PROFILE_SCOPE("SceneBvh::Rebuild");
+
+        m_nodes.clear();
+        m_primitives.clear();
+        m_primitiveIndices.clear();
+
+        auto meshTransformView = scene.GetRegistry().view<Components::Mesh, Components::WorldTransform>();
+        for (auto entity : meshTransformView) {
+            if (auto bounds = getWorldBounds(scene, entity)) {
+                m_primitives.push_back({.entity = entity, .bounds = *bounds});
+            }
+        }
+
+        if (!m_primitives.empty()) {
+            m_nodes.reserve(2 * m_primitives.size());
+            buildNode(m_nodes, 0, static_cast<uint32_t>(m_primitives.size()), 0);
+        }
+
+        for (uint32_t nodeIndex = 0; nodeIndex < m_nodes.size(); nodeIndex++) {
+            const auto &node = m_nodes[nodeIndex];
+            for (uint32_t i = node.firstPrimitive; i < node.firstPrimitive + node.primitiveCount; i++) {
+                m_primitives[i].leaf = nodeIndex;
+                m_primitiveIndices.emplace(m_primitives[i].entity, i);
+            }
+        }
+
+        m_rebuildRequired = false;
+        m_changesSinceBuild = 0;
+    }
+
+    uint32_t SceneBvh::buildNode(std::vector<Node> &nodes, uint32_t begin, uint32_t end, uint32_t depth) {
+        const auto nodeIndex = static_cast<uint32_t>(nodes.size());
+        nodes.emplace_back();
+
+        BoundingBox bounds = getEmptyBox();
+        BoundingBox centroidBounds = getEmptyBox();
+        for (uint32_t i = begin; i < end; i++) {
+            grow(bounds, m_primitives[i].bounds);
+            grow(centroidBounds, getCentroid(m_primitives[i].bounds));
+        }
+        nodes[nodeIndex].bounds = bounds;
+
+        const uint32_t count = end - begin;
+        auto makeLeaf = [&]() {
+            nodes[nodeIndex].firstPrimitive = begin;
+            nodes[nodeIndex].primitiveCount = count;
+            return nodeIndex;
+        };
+
+        if (count <= MAX_LEAF_SIZE) {
+            return makeLeaf();
+        }
+
+        struct Bin {
+            BoundingBox bounds = getEmptyBox();
+            uint32_t count = 0;
+        };
+
+        auto getBin = [&](const Primitive &primitive, int axis) {
+            float scale = BIN_COUNT / (centroidBounds.max[axis] - centroidBounds.min[axis]);
+            auto bin = static_cast<uint32_t>((getCentroid(primitive.bounds)[axis] - centroidBounds.min[axis]) * scale);
+            return std::min(bin, BIN_COUNT - 1);
+        };
+
+        // Split cost is the surface area heuristic without constant traversal & intersection costs.
+        float bestCost = std::numeric_limits<float>::max();
+        int bestAxis = -1;
+        uint32_t bestSplit = 0;
+
+        for (int axis = 0; axis < 3; axis++) {
+            if (centroidBounds.max[axis] <= centroidBounds.min[axis]) {
+                continue;
+            }
+
+            std::array<Bin, BIN_COUNT> bins{};
+            for (uint32_t i = begin; i < end; i++) {
+                auto &bin = bins[getBin(m_primitives[i], axis)];
+                grow(bin.bounds, m_primitives[i].bounds);
+                bin.count++;
+            }
+
+            // Area & count of everything to the right of each split.
+            std::array<float, BIN_COUNT> rightAreas{};
+            std::array<uint32_t, BIN_COUNT> rightCounts{};
+            BoundingBox rightBounds = getEmptyBox();
+            uint32_t rightCount = 0;
+            for (uint32_t split = BIN_COUNT - 1; split > 0; split--) {
+                grow(rightBounds, bins[split].bounds);
+                rightCount += bins[split].count;
+                rightAreas[split] = getSurfaceArea(rightBounds);
+                rightCounts[split] = rightCount;
+            }
+
+            BoundingBox leftBounds = getEmptyBox();
+            uint32_t leftCount = 0;
+            for (uint32_t split = 1; split < BIN_COUNT; split++) {
+                grow(leftBounds, bins[split - 1].bounds);
+                leftCount += bins[split - 1].count;
+
+                float cost = leftCount * getSurfaceArea(leftBounds) + rightCounts[split] * rightAreas[split];
+                if (leftCount > 0 && rightCounts[split] > 0 && cost < bestCost) {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestSplit = split;
+                }
+            }
+        }
+
+        uint32_t middle = begin + count / 2;
+        if (bestAxis >= 0) {
+            if (bestCost >= count * getSurfaceArea(bounds) && count <= MAX_SAH_LEAF_SIZE) {
+                return makeLeaf();
+            }
+
+            auto middleIt = std::partition(m_primitives.begin() + begin, m_primitives.begin() + end,
+                                           [&](const Primitive &primitive) { return getBin(primitive, bestAxis) < bestSplit; });
+            middle = static_cast<uint32_t>(middleIt - m_primitives.begin());
+        } else if (count <= MAX_SAH_LEAF_SIZE) {
+            // All centroids are the same, no split can separate them.
+            return makeLeaf();
+        }
+
+        uint32_t left = INVALID_INDEX;
+        uint32_t right = INVALID_INDEX;
+
+        // Subtrees work on disjoint primitive ranges, so the right one can be built into its own node list meanwhile.
+        if (count >= PARALLEL_BUILD_THRESHOLD && depth < getMaxParallelDepth()) {
+            std::vector<Node> rightNodes;
+            rightNodes.reserve(2 * (end - middle));
+
+            auto rightBuild = std::async(std::launch::async, [&]() { buildNode(rightNodes, middle, end, depth + 1); });
+            left = buildNode(nodes, begin, middle, depth + 1);
+            rightBuild.get();
+
+            right = appendSubtree(nodes, rightNodes, INVALID_INDEX);
+        } else {
+            left = buildNode(nodes, begin, middle, depth + 1);
+            right = buildNode(nodes, middle, end, depth + 1);
+        }
+
+        nodes[left].parent = nodeIndex;
+        nodes[right].parent = nodeIndex;
+        nodes[nodeIndex].left = left;
+        nodes[nodeIndex].right = right;
+
+        return nodeIndex;
+    }
+
+    void SceneBvh::refit(uint32_t nodeIndex) {
+        while (nodeIndex != INVALID_INDEX) {
+            auto &node = m_nodes[nodeIndex];
+
+            BoundingBox bounds = getEmptyBox();
+            if (node.IsLeaf()) {
+                for (uint32_t i = node.firstPrimitive; i < node.firstPrimitive + node.primitiveCount; i++) {
+                    grow(bounds, m_primitives[i].bounds);
+                }
+            } else {
+                grow(bounds, m_nodes[node.left].bounds);
+                grow(bounds, m_nodes[node.right].bounds);
+            }
+
+            // Ancestors can only change when this node did.
+            if (bounds.min == node.bounds.min && bounds.max == node.bounds.max) {
+                break;
+            }
+
+            node.bounds = bounds;
+            nodeIndex = node.parent;
+        }
+    }
+} // namespace Prism::Resources
@@ -0,0 +1,85 @@
+#include "resources/uniform_ring_resource.hpp"
+#include "utils/vulkan/common.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace Prism::Resources {
+    namespace {
+        VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment) { return (value + alignment - 1) / alignment * alignment; }
+    } // namespace
+
+    UniformRingResource::UniformRingResource(VmaAllocator allocator, VkPhysicalDevice physicalDevice, uint32_t framesInFlight, VkDeviceSize frameCapacity)
+        : allocator(allocator) {
+        alignment = Utils::Vulkan::Common::getBufferOffsetAlignment(physicalDevice);
+        this->frameCapacity = alignUp(frameCapacity, alignment);
+
+        // Systems allocate before the fence of their frame slot is waited on, so one more region than frames in flight is
+        // needed - by the time a region comes around again, the frame that used it is guaranteed to have finished.
+        regionCount = framesInFlight + 1;
+
+        buffer = VkBufferResource<>(allocator, this->frameCapacity * regionCount, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                                    VMA_MEMORY_USAGE_CPU_TO_GPU);
+
+        void *data = nullptr;
+        if (vmaMapMemory(allocator, buffer.GetAllocation(), &data) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to map uniform ring buffer!");
+        }
+        mappedData = static_cast<std::byte *>(data);
+    }
+
+    UniformRingResource::~UniformRingResource() {
+        if (mappedData != nullptr) {
+            vmaUnmapMemory(allocator, buffer.GetAllocation());
+            mappedData = nullptr;
+        }
+    }
+
+    UniformRingResource::UniformRingResource(UniformRingResource &&other) noexcept { swap(*this, other); }
+
+    UniformRingResource &UniformRingResource::operator=(UniformRingResource &&other) noexcept {
+        if (this != &other) {
+            swap(*this, other);
+        }
+        return *this;
+    }
+
+    void swap(UniformRingResource &first, UniformRingResource &second) noexcept {
+        using std::swap;
+        swap(first.allocator, second.allocator);
+        swap(first.buffer, second.buffer);
+        swap(first.mappedData, second.mappedData);
+        swap(first.alignment, second.alignment);
+        swap(first.frameCapacity, second.frameCapacity);
+        swap(first.regionCount, second.regionCount);
+        swap(first.currentRegion, second.currentRegion);
+        swap(first.head, second.head);
+    }
+
+    void UniformRingResource::BeginFrame() {
+        currentRegion = (currentRegion + 1) % regionCount;
+        head = currentRegion * frameCapacity;
+    }
+
+    void UniformRingResource::Flush() {
+        VkDeviceSize regionStart = currentRegion * frameCapacity;
+        if (head == regionStart) {
+            return;
+        }
+
+        // Memory isn't guaranteed to be host coherent. Region start is aligned to the atom already, the end is rounded up within the region.
+        VkDeviceSize size = std::min(alignUp(head - regionStart, alignment), frameCapacity);
+        vmaFlushAllocation(allocator, buffer.GetAllocation(), regionStart, size);
+    }
+
+    std::optional<UniformRingResource::Allocation> UniformRingResource::Allocate(VkDeviceSize size) {
+        VkDeviceSize offset = alignUp(head, alignment);
+        if (size == 0 || offset + size > (currentRegion + 1) * frameCapacity) {
+            return std::nullopt;
+        }
+
+        head = offset + size;
+        return Allocation{.offset = static_cast<uint32_t>(offset), .data = mappedData + offset};
+    }
+} // namespace Prism::Resources
@@ -1,13 +1,37 @@
 #include "resources/vulkan/vk_staging_buffer_resource.hpp"
 
+#include "utils/profiler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <stdexcept>
 #include <utility>
 
 namespace Prism::Resources {
-    VkStagingBufferResource::VkStagingBufferResource(VmaAllocator allocator) : allocator(allocator) {
-        stagingBuffer =
-            VkBufferResource<>(allocator, INITIAL_SIZE, VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU);
-        currentlyUtilized = 0;
+    VkStagingBufferResource::VkStagingBufferResource(VmaAllocator allocator, VkDevice device, VkSemaphore frameTimelineSemaphore, VkDeviceSize budget)
+        : allocator(allocator), device(device), frameTimelineSemaphore(frameTimelineSemaphore) {
+        chunkSize = budget / CHUNK_COUNT;
+        if (chunkSize == 0) {
+            throw std::runtime_error("Staging buffer budget is smaller than its chunk count!");
+        }
+
+        stagingBuffer = VkBufferResource<>(allocator, chunkSize * CHUNK_COUNT, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU);
+
+        void *data = nullptr;
+        if (vmaMapMemory(allocator, stagingBuffer.GetAllocation(), &data) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to map staging buffer!");
+        }
+        mappedData = static_cast<std::byte *>(data);
+
+        chunks.resize(CHUNK_COUNT);
+    }
+
+    VkStagingBufferResource::~VkStagingBufferResource() {
+        if (mappedData != nullptr) {
+            vmaUnmapMemory(allocator, stagingBuffer.GetAllocation());
+            mappedData = nullptr;
+        }
     }
 
     VkStagingBufferResource::VkStagingBufferResource(VkStagingBufferResource &&other) noexcept { swap(*this, other); }
@@ -19,70 +43,175 @@ namespace Prism::Resources {
         return *this;
     }
 
-    void VkStagingBufferResource::Copy(VkBuffer destination, void *data, size_t size) {
-        if (size + currentlyUtilized > stagingBuffer.GetBufferSize()) {
-            size_t newSize = std::max(stagingBuffer.GetBufferSize() * 2, static_cast<VkDeviceSize>(size + currentlyUtilized));
-
-            VkBufferResource<> newBuffer(allocator, newSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU);
+    uint64_t VkStagingBufferResource::Copy(VkBuffer destination, const void *data, size_t size, VkDeviceSize destinationOffset) {
+        const uint64_t id = ++lastCopyId;
+        const auto *bytes = static_cast<const std::byte *>(data);
+
+        // Earlier copies are still waiting, this one is queued behind them so copies are staged in order.
+        size_t written = 0;
+        if (deferredCopies.empty()) {
+            written = write(destination, bytes, size, destinationOffset, true);
+            if (written == size) {
+                stagedCopyId = id;
+                return id;
+            }
+        }
 
-            // Copy old contents & replace previous buffer with the new one.
-            if (currentlyUtilized > 0) {
-                void *oldData = nullptr;
-                vmaMapMemory(allocator, stagingBuffer.GetAllocation(), &oldData);
+        deferredCopies.push_back({.id = id,
+                                  .destination = destination,
+                                  .destinationOffset = destinationOffset + written,
+                                  .data = std::vector<std::byte>(bytes + written, bytes + size)});
+        return id;
+    }
 
-                void *newData = nullptr;
-                vmaMapMemory(allocator, newBuffer.GetAllocation(), &newData);
+    void VkStagingBufferResource::BeginFrame(uint64_t completedFrameNumber) {
+        completedFrame = std::max(completedFrame, completedFrameNumber);
 
-                std::memcpy(newData, oldData, currentlyUtilized);
+        // Waiting here would serialize the frame with the GPU, what doesn't fit in retired chunks waits for the next frame.
+        while (!deferredCopies.empty()) {
+            auto &deferred = deferredCopies.front();
 
-                vmaUnmapMemory(allocator, newBuffer.GetAllocation());
-                vmaUnmapMemory(allocator, stagingBuffer.GetAllocation());
+            size_t remaining = deferred.data.size() - deferred.written;
+            deferred.written += write(deferred.destination, deferred.data.data() + deferred.written, remaining,
+                                      deferred.destinationOffset + deferred.written, false);
+            if (deferred.written < deferred.data.size()) {
+                break;
             }
 
-            stagingBuffer = std::move(newBuffer);
+            stagedCopyId = deferred.id;
+            deferredCopies.pop_front();
         }
-
-        void *mappedData;
-        vmaMapMemory(allocator, stagingBuffer.GetAllocation(), &mappedData);
-        std::memcpy(static_cast<char *>(mappedData) + currentlyUtilized, data, size);
-        vmaUnmapMemory(allocator, stagingBuffer.GetAllocation());
-
-        VkBufferCopy copyRegion{};
-        copyRegion.srcOffset = currentlyUtilized;
-        copyRegion.dstOffset = 0;
-        copyRegion.size = size;
-
-        pendingCopies.push_back({destination, copyRegion});
-
-        currentlyUtilized += size;
     }
 
-    void VkStagingBufferResource::Commit(VkCommandBuffer commandBuffer) {
-        VkCommandBufferBeginInfo beginInfo{};
-        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-        vkBeginCommandBuffer(commandBuffer, &beginInfo);
+    bool VkStagingBufferResource::Commit(VkCommandBuffer commandBuffer, uint64_t frameNumber) {
+        lastFrameStats = {};
+        lastFrameStats.stallTimeMs = std::exchange(stallTimeMs, 0.0);
+        for (const auto &deferred : deferredCopies) {
+            lastFrameStats.deferredBytes += deferred.data.size() - deferred.written;
+        }
 
         if (pendingCopies.empty()) {
-            vkEndCommandBuffer(commandBuffer);
-            return;
+            return false;
         }
 
+        // No-op on coherent memory.
+        vmaFlushAllocation(allocator, stagingBuffer.GetAllocation(), 0, VK_WHOLE_SIZE);
+
         for (const auto &pending : pendingCopies) {
             vkCmdCopyBuffer(commandBuffer, stagingBuffer.GetBuffer(), pending.destination, 1, &pending.region);
+            lastFrameStats.uploadedBytes += pending.region.size;
+        }
+
+        // Current chunk keeps being filled by the next frames, each commit moves its retirement further.
+        for (uint32_t i = 0; i < batchChunkCount; i++) {
+            chunks[(currentChunk + CHUNK_COUNT - i) % CHUNK_COUNT].retireFrame = frameNumber;
         }
+        batchChunkCount = 1;
 
         pendingCopies.clear();
-        currentlyUtilized = 0;
 
-        vkEndCommandBuffer(commandBuffer);
+        return true;
+    }
+
+    size_t VkStagingBufferResource::write(VkBuffer destination, const std::byte *data, size_t size, VkDeviceSize destinationOffset, bool allowStall) {
+        size_t written = 0;
+        while (written < size) {
+            auto *chunk = &chunks[currentChunk];
+            if (chunk->used == chunkSize) {
+                if (!acquireNextChunk(allowStall)) {
+                    break;
+                }
+                chunk = &chunks[currentChunk];
+            }
+
+            // Copies are split at chunk boundaries, every piece is copied on its own.
+            size_t pieceSize = std::min<size_t>(size - written, chunkSize - chunk->used);
+            VkDeviceSize offset = currentChunk * chunkSize + chunk->used;
+            std::memcpy(mappedData + offset, data + written, pieceSize);
+
+            VkBufferCopy copyRegion{};
+            copyRegion.srcOffset = offset;
+            copyRegion.dstOffset = destinationOffset + written;
+            copyRegion.size = pieceSize;
+
+            // Consecutive pieces of one destination, e.g. vertices of several meshes, are merged into one region.
+            bool merged = false;
+            if (!pendingCopies.empty() && pendingCopies.back().destination == destination) {
+                auto &last = pendingCopies.back().region;
+                if (last.srcOffset + last.size == copyRegion.srcOffset && last.dstOffset + last.size == copyRegion.dstOffset) {
+                    last.size += pieceSize;
+                    merged = true;
+                }
+            }
+
+            if (!merged) {
+                pendingCopies.push_back({destination, copyRegion});
+            }
+
+            chunk->used += pieceSize;
+            written += pieceSize;
+        }
+
+        return written;
+    }
+
+    bool VkStagingBufferResource::acquireNextChunk(bool allowStall) {
+        // Every chunk holds copies of the frame being recorded.
+        if (batchChunkCount == CHUNK_COUNT) {
+            return false;
+        }
+
+        // Chunks are handed out in ring order, so the next one is the one retired first.
+        uint32_t nextChunk = (currentChunk + 1) % CHUNK_COUNT;
+        uint64_t retireFrame = chunks[nextChunk].retireFrame;
+
+        if (retireFrame > completedFrame) {
+            vkGetSemaphoreCounterValue(device, frameTimelineSemaphore, &completedFrame);
+        }
+
+        if (retireFrame > completedFrame) {
+            if (!allowStall) {
+                return false;
+            }
+
+            PRISM_PROFILE_SCOPE("VkStagingBufferResource::Stall");
+            auto stallStart = std::chrono::steady_clock::now();
+
+            VkSemaphoreWaitInfo waitInfo{};
+            waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+            waitInfo.semaphoreCount = 1;
+            waitInfo.pSemaphores = &frameTimelineSemaphore;
+            waitInfo.pValues = &retireFrame;
+            vkWaitSemaphores(device, &waitInfo, UINT64_MAX);
+
+            completedFrame = retireFrame;
+            stallTimeMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - stallStart).count();
+        }
+
+        chunks[nextChunk].used = 0;
+        currentChunk = nextChunk;
+        batchChunkCount++;
+
+        return true;
     }
 
     void swap(VkStagingBufferResource &first, VkStagingBufferResource &second) noexcept {
         using std::swap;
         swap(first.allocator, second.allocator);
+        swap(first.device, second.device);
+        swap(first.frameTimelineSemaphore, second.frameTimelineSemaphore);
         swap(first.stagingBuffer, second.stagingBuffer);
-        swap(first.currentlyUtilized, second.currentlyUtilized);
+        swap(first.mappedData, second.mappedData);
+        swap(first.chunkSize, second.chunkSize);
+        swap(first.chunks, second.chunks);
+        swap(first.currentChunk, second.currentChunk);
+        swap(first.batchChunkCount, second.batchChunkCount);
+        swap(first.completedFrame, second.completedFrame);
         swap(first.pendingCopies, second.pendingCopies);
+        swap(first.deferredCopies, second.deferredCopies);
+        swap(first.lastCopyId, second.lastCopyId);
+        swap(first.stagedCopyId, second.stagedCopyId);
+        swap(first.lastFrameStats, second.lastFrameStats);
+        swap(first.stallTimeMs, second.stallTimeMs);
     }
-} // namespace Prism::Resources
\ No newline at end of file
+} // namespace Prism::Resources
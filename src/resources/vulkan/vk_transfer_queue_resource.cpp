@@ -0,0 +1,137 @@
+#include "resources/vulkan/vk_transfer_queue_resource.hpp"
+
+#include "utils/profiler.hpp"
+#include "utils/vulkan/common.hpp"
+
+#include <utility>
+
+namespace Prism::Resources {
+    VkTransferQueueResource::VkTransferQueueResource(VkDevice device, VkQueue transferQueue, uint32_t transferQueueFamilyIndex,
+                                                     uint32_t graphicsQueueFamilyIndex, uint32_t framesInFlight)
+        : device(device), queue(transferQueue), transferQueueFamilyIndex(transferQueueFamilyIndex), graphicsQueueFamilyIndex(graphicsQueueFamilyIndex) {
+        if (!IsAvailable()) {
+            return;
+        }
+
+        commandPools.reserve(framesInFlight);
+        for (uint32_t i = 0; i < framesInFlight; i++) {
+            commandPools.emplace_back(device, transferQueueFamilyIndex);
+        }
+
+        timelineSemaphore = Utils::Vulkan::Common::createTimelineSemaphore(device);
+    }
+
+    VkTransferQueueResource::~VkTransferQueueResource() {
+        // Pools wait for the device to be idle, so the semaphore is no longer used.
+        commandPools.clear();
+
+        if (timelineSemaphore != VK_NULL_HANDLE) {
+            vkDestroySemaphore(device, timelineSemaphore, nullptr);
+        }
+    }
+
+    VkTransferQueueResource::VkTransferQueueResource(VkTransferQueueResource &&other) noexcept { swap(*this, other); }
+
+    VkTransferQueueResource &VkTransferQueueResource::operator=(VkTransferQueueResource &&other) noexcept {
+        if (this != &other) {
+            swap(*this, other);
+        }
+        return *this;
+    }
+
+    std::optional<uint64_t> VkTransferQueueResource::Submit(VkStagingBufferResource &stagingBuffer, VkCommandBuffer graphicsCommandBuffer,
+                                                            uint32_t frameOffset, uint64_t frameNumber) {
+        PRISM_PROFILE_SCOPE("VkTransferQueueResource::Submit");
+
+        const auto &pendingCopies = stagingBuffer.GetPendingCopies();
+        if (pendingCopies.empty()) {
+            return std::nullopt;
+        }
+
+        // Exactly the written ranges change owner. Previous contents are overwritten, so they are not released by the graphics queue first.
+        barriers.clear();
+        for (const auto &pending : pendingCopies) {
+            VkBufferMemoryBarrier2 barrier{};
+            barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+            barrier.srcQueueFamilyIndex = transferQueueFamilyIndex;
+            barrier.dstQueueFamilyIndex = graphicsQueueFamilyIndex;
+            barrier.buffer = pending.destination;
+            barrier.offset = pending.region.dstOffset;
+            barrier.size = pending.region.size;
+            barriers.push_back(barrier);
+        }
+
+        auto &commandPool = commandPools.at(frameOffset);
+        commandPool.Reset();
+
+        auto commandBuffersScope = commandPool.BeginScope();
+        auto commandBuffer = commandBuffersScope.GetNextCommandBuffer();
+
+        VkCommandBufferBeginInfo beginInfo{};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        vkBeginCommandBuffer(commandBuffer, &beginInfo);
+
+        stagingBuffer.Commit(commandBuffer, frameNumber);
+
+        // Release, destination half of the barrier is ignored on this queue.
+        for (auto &barrier : barriers) {
+            barrier.srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+            barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+            barrier.dstStageMask = VK_PIPELINE_STAGE_2_NONE;
+            barrier.dstAccessMask = VK_ACCESS_2_NONE;
+        }
+
+        VkDependencyInfo dependencyInfo{};
+        dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+        dependencyInfo.bufferMemoryBarrierCount = static_cast<uint32_t>(barriers.size());
+        dependencyInfo.pBufferMemoryBarriers = barriers.data();
+        vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+
+        vkEndCommandBuffer(commandBuffer);
+
+        submittedValue++;
+
+        VkCommandBufferSubmitInfo commandBufferInfo{};
+        commandBufferInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
+        commandBufferInfo.commandBuffer = commandBuffer;
+
+        VkSemaphoreSubmitInfo signalSemaphoreInfo{};
+        signalSemaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+        signalSemaphoreInfo.semaphore = timelineSemaphore;
+        signalSemaphoreInfo.value = submittedValue;
+        signalSemaphoreInfo.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+
+        VkSubmitInfo2 submitInfo{};
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
+        submitInfo.commandBufferInfoCount = 1;
+        submitInfo.pCommandBufferInfos = &commandBufferInfo;
+        submitInfo.signalSemaphoreInfoCount = 1;
+        submitInfo.pSignalSemaphoreInfos = &signalSemaphoreInfo;
+
+        vkQueueSubmit2(queue, 1, &submitInfo, VK_NULL_HANDLE);
+
+        // Acquire, chained to the semaphore wait of the graphics submit through the same stage.
+        for (auto &barrier : barriers) {
+            barrier.srcStageMask = ACQUIRE_STAGE_MASK;
+            barrier.srcAccessMask = VK_ACCESS_2_NONE;
+            barrier.dstStageMask = ACQUIRE_STAGE_MASK;
+            barrier.dstAccessMask = VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_2_INDEX_READ_BIT;
+        }
+        vkCmdPipelineBarrier2(graphicsCommandBuffer, &dependencyInfo);
+
+        return submittedValue;
+    }
+
+    void swap(VkTransferQueueResource &first, VkTransferQueueResource &second) noexcept {
+        using std::swap;
+        swap(first.device, second.device);
+        swap(first.queue, second.queue);
+        swap(first.transferQueueFamilyIndex, second.transferQueueFamilyIndex);
+        swap(first.graphicsQueueFamilyIndex, second.graphicsQueueFamilyIndex);
+        swap(first.commandPools, second.commandPools);
+        swap(first.timelineSemaphore, second.timelineSemaphore);
+        swap(first.submittedValue, second.submittedValue);
+        swap(first.barriers, second.barriers);
+    }
+} // namespace Prism::Resources
@@ -3,6 +3,7 @@
 #define VMA_IMPLEMENTATION
 #include "vk_mem_alloc.h"
 
+#include "utils/profiler.hpp"
 #include "utils/vulkan/common.hpp"
 
 #include <set>
@@ -40,34 +41,16 @@ namespace Prism::Resources {
             return details;
         }
 
-        std::vector<VkFence> createFences(VkDevice device) {
-            std::vector<VkFence> fences;
-
-            for (size_t i = 0; i < Resources::VulkanResource::FRAMES_IN_FLIGHT; i++) {
-                VkFence fence = VK_NULL_HANDLE;
-
-                VkFenceCreateInfo createInfo{.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO, .flags = VK_FENCE_CREATE_SIGNALED_BIT};
-
-                if (vkCreateFence(device, &createInfo, nullptr, &fence) != VK_SUCCESS) {
-                    throw std::runtime_error("Failed to create fence!");
-                }
-
-                fences.push_back(fence);
-            }
-
-            return fences;
-        }
-
-        std::vector<VkSemaphore> createSemaphores(VkDevice device) {
+        std::vector<VkSemaphore> createSemaphores(VkDevice device, uint32_t count) {
             std::vector<VkSemaphore> semaphores;
-            semaphores.reserve(Resources::VulkanResource::FRAMES_IN_FLIGHT);
+            semaphores.reserve(count);
 
             VkSemaphoreCreateInfo semaphoreInfo{};
             semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
             semaphoreInfo.pNext = nullptr;
             semaphoreInfo.flags = 0;
 
-            for (uint32_t i = 0; i < Resources::VulkanResource::FRAMES_IN_FLIGHT; ++i) {
+            for (uint32_t i = 0; i < count; ++i) {
                 VkSemaphore semaphore = VK_NULL_HANDLE;
                 if (vkCreateSemaphore(device, &semaphoreInfo, nullptr, &semaphore) != VK_SUCCESS) {
                     // Cleanup any semaphores that succeeded before throwing.
@@ -87,10 +70,19 @@ namespace Prism::Resources {
 
     VulkanResource::VulkanResource(VkInstance instance, std::unique_ptr<Utils::Vulkan::DebugMessenger> debugMessenger, VkSurfaceKHR surface,
                                    VkPhysicalDevice physicalDevice, VkDevice device, VmaAllocator allocator, VkQueue graphicsQueue, VkQueue presentationQueue,
-                                   VkExtent2D swapchainExtent)
+                                   VkQueue transferQueue, Utils::Vulkan::Common::QueueFamilyIndices queueFamilyIndices, VkExtent2D swapchainExtent,
+                                   uint32_t framesInFlight)
         : instance(instance), debugMessenger(std::move(debugMessenger)), surface(surface), physicalDevice(physicalDevice), device(device),
-          vmaAllocator(allocator), graphicsQueue(graphicsQueue), presentationQueue(presentationQueue), fences(createFences(device)),
-          imageAcquiredSemaphores(createSemaphores(device)) {
+          vmaAllocator(allocator), graphicsQueue(graphicsQueue), presentationQueue(presentationQueue), transferQueue(transferQueue),
+          framesInFlight(framesInFlight), graphicsQueueFamilyIndex(queueFamilyIndices.graphicsFamily.value()),
+          presentationQueueFamilyIndex(queueFamilyIndices.presentFamily.value()),
+          transferQueueFamilyIndex(queueFamilyIndices.transferFamily.value_or(queueFamilyIndices.graphicsFamily.value())) {
+        if (framesInFlight < MIN_FRAMES_IN_FLIGHT || framesInFlight > MAX_FRAMES_IN_FLIGHT) {
+            throw std::runtime_error("Frames in flight have to be between 1 and 4!");
+        }
+
+        imageAcquiredSemaphores = createSemaphores(device, framesInFlight);
+        frameTimelineSemaphore = Utils::Vulkan::Common::createTimelineSemaphore(device);
 
         RecreateSwapchain(swapchainExtent.width, swapchainExtent.height);
     }
@@ -108,9 +100,7 @@ namespace Prism::Resources {
 
             cleanupSwapchain();
 
-            for (auto fence : fences) {
-                vkDestroyFence(device, fence, nullptr);
-            }
+            vkDestroySemaphore(device, frameTimelineSemaphore, nullptr);
 
             vmaDestroyAllocator(vmaAllocator);
 
@@ -143,9 +133,11 @@ namespace Prism::Resources {
         swap(first.vmaAllocator, second.vmaAllocator);
         swap(first.graphicsQueue, second.graphicsQueue);
         swap(first.presentationQueue, second.presentationQueue);
+        swap(first.transferQueue, second.transferQueue);
 
         swap(first.graphicsQueueFamilyIndex, second.graphicsQueueFamilyIndex);
         swap(first.presentationQueueFamilyIndex, second.presentationQueueFamilyIndex);
+        swap(first.transferQueueFamilyIndex, second.transferQueueFamilyIndex);
 
         swap(first.swapchainImageFormat, second.swapchainImageFormat);
         swap(first.swapchainExtent, second.swapchainExtent);
@@ -153,8 +145,12 @@ namespace Prism::Resources {
 
         swap(first.swapchainImages, second.swapchainImages);
         swap(first.swapchainImagesViews, second.swapchainImagesViews);
-        swap(first.fences, second.fences);
         swap(first.imageAcquiredSemaphores, second.imageAcquiredSemaphores);
+        swap(first.renderFinishedSemaphores, second.renderFinishedSemaphores);
+        swap(first.frameTimelineSemaphore, second.frameTimelineSemaphore);
+
+        swap(first.framesInFlight, second.framesInFlight);
+        swap(first.frameNumber, second.frameNumber);
 
         swap(first.imageCount, second.imageCount);
         swap(first.currentImageIndex, second.currentImageIndex);
@@ -168,22 +164,58 @@ namespace Prism::Resources {
         vkDeviceWaitIdle(device);
 
         cleanupSwapchain();
+
+        if (IsHeadless()) {
+            createHeadlessTargets(newWidth, newHeight);
+            return;
+        }
+
         createSwapchain(newWidth, newHeight);
         createSwapchainImages();
         createSwapchainImagesViews();
     }
 
     void VulkanResource::AdvanceFrame() {
-        vkWaitForFences(device, 1, &fences[currentFrameOffset], true, UINT64_MAX);
-        vkAcquireNextImageKHR(device, swapchain, UINT64_MAX, imageAcquiredSemaphores[currentFrameOffset], VK_NULL_HANDLE, &currentImageIndex);
-        vkResetFences(device, 1, &fences[currentFrameOffset]);
+        frameNumber++;
+        currentFrameOffset = static_cast<uint32_t>(frameNumber % framesInFlight);
+
+        // Slot was last used by the frame framesInFlight frames ago, the first frames have nothing to wait for.
+        if (frameNumber > framesInFlight) {
+            PRISM_PROFILE_SCOPE("VulkanResource::WaitForFrame");
+
+            uint64_t waitValue = frameNumber - framesInFlight;
 
-        currentFrameOffset = (currentFrameOffset + 1) % FRAMES_IN_FLIGHT;
+            VkSemaphoreWaitInfo waitInfo{};
+            waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+            waitInfo.semaphoreCount = 1;
+            waitInfo.pSemaphores = &frameTimelineSemaphore;
+            waitInfo.pValues = &waitValue;
+            vkWaitSemaphores(device, &waitInfo, UINT64_MAX);
+        }
+
+        if (IsHeadless()) {
+            // There is nothing to acquire - each frame in flight owns its own offscreen target.
+            currentImageIndex = currentFrameOffset;
+        } else {
+            PRISM_PROFILE_SCOPE("VulkanResource::AcquireNextImage");
+            vkAcquireNextImageKHR(device, swapchain, UINT64_MAX, imageAcquiredSemaphores[currentFrameOffset], VK_NULL_HANDLE, &currentImageIndex);
+        }
+    }
+
+    uint64_t VulkanResource::GetCompletedFrameNumber() const {
+        uint64_t value = 0;
+        vkGetSemaphoreCounterValue(device, frameTimelineSemaphore, &value);
+        return value;
     }
 
     void VulkanResource::cleanupSwapchain() {
         swapchainBoundResourceStorage.Clear();
 
+        for (auto semaphore : renderFinishedSemaphores) {
+            vkDestroySemaphore(device, semaphore, nullptr);
+        }
+        renderFinishedSemaphores.clear();
+
         for (auto imageView : swapchainImagesViews) {
             vkDestroyImageView(device, imageView, nullptr);
         }
@@ -257,6 +289,18 @@ namespace Prism::Resources {
         swapchainExtent = {static_cast<uint32_t>(newWidth), static_cast<uint32_t>(newHeight)};
     }
 
+    void VulkanResource::createHeadlessTargets(int newWidth, int newHeight) {
+        Utils::Vulkan::Common::QueueFamilyIndices indices = Utils::Vulkan::Common::findQueueFamilies(surface, physicalDevice);
+
+        graphicsQueueFamilyIndex = indices.graphicsFamily.value();
+        presentationQueueFamilyIndex = indices.presentFamily.value();
+
+        // Without a swapchain image index is the frame offset, so per image resources exist once per frame in flight.
+        imageCount = framesInFlight;
+
+        swapchainExtent = {static_cast<uint32_t>(newWidth), static_cast<uint32_t>(newHeight)};
+    }
+
     void VulkanResource::createSwapchainImages() {
         uint32_t imageCount;
         vkGetSwapchainImagesKHR(device, swapchain, &imageCount, nullptr);
@@ -264,6 +308,8 @@ namespace Prism::Resources {
         swapchainImages.resize(imageCount);
 
         vkGetSwapchainImagesKHR(device, swapchain, &imageCount, swapchainImages.data());
+
+        renderFinishedSemaphores = createSemaphores(device, imageCount);
     }
 
     void VulkanResource::createSwapchainImagesViews() {
@@ -6,9 +6,22 @@ layout(set = 0, binding = 0) uniform CommonUniforms {
     vec4 cameraPosition;
 } commonUniforms;
 
-layout(push_constant) uniform PushConstants {
+struct InstanceData {
     mat4 model;
-} pushConstants;
+    mat3 normalMatrix;
+    vec4 positionScale;
+    vec4 positionOffset;
+};
+
+layout(std430, set = 0, binding = 1) readonly buffer InstanceBuffer {
+    InstanceData instances[];
+} instanceBuffer;
+
+// Set for MeshResource::VertexFormat::Quantized, whose normals are octahedral encoded in the first two components.
+layout(constant_id = 0) const bool OCTAHEDRAL_NORMALS = false;
+
+// Inverts the model matrix for every vertex instead of using the precomputed normal matrix, only kept to benchmark against.
+layout(constant_id = 1) const bool PER_VERTEX_NORMAL_MATRIX = false;
 
 layout(location = 0) in vec3 inPosition;
 layout(location = 1) in vec3 inNormal;
@@ -18,8 +31,24 @@ layout(location = 0) out vec3 outPosition;
 
 layout(location = 1) out vec3 outNormal;
 
+vec3 decodeOctahedral(vec2 encoded) {
+    vec3 normal = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+    if (normal.z < 0.0) {
+        normal.xy = (1.0 - abs(normal.yx)) * vec2(normal.x >= 0.0 ? 1.0 : -1.0, normal.y >= 0.0 ? 1.0 : -1.0);
+    }
+    return normalize(normal);
+}
+
 void main() {
-    gl_Position = commonUniforms.projection * commonUniforms.view * pushConstants.model * vec4(inPosition, 1.0);
-    outNormal = normalize(mat3(transpose(inverse(pushConstants.model))) * inNormal);
-    outPosition = vec3(pushConstants.model * vec4(inPosition, 1.0));
+    // gl_InstanceIndex already includes firstInstance of the draw.
+    InstanceData instance = instanceBuffer.instances[gl_InstanceIndex];
+    mat4 model = instance.model;
+
+    vec3 position = inPosition * instance.positionScale.xyz + instance.positionOffset.xyz;
+    vec3 normal = OCTAHEDRAL_NORMALS ? decodeOctahedral(inNormal.xy) : inNormal;
+
+    gl_Position = commonUniforms.projection * commonUniforms.view * model * vec4(position, 1.0);
+    mat3 normalMatrix = PER_VERTEX_NORMAL_MATRIX ? mat3(transpose(inverse(model))) : instance.normalMatrix;
+    outNormal = normalize(normalMatrix * normal);
+    outPosition = vec3(model * vec4(position, 1.0));
 }
\ No newline at end of file
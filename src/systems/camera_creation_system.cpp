@@ -1,5 +1,7 @@
 #include "systems/camera_creation_system.hpp"
 
+#include "utils/profiler.hpp"
+
 #include "components/camera.hpp"
 #include "components/fps_camera_control.hpp"
 #include "components/tags.hpp"
@@ -25,6 +27,8 @@ namespace Prism::Systems {
 
     void CameraCreationSystem::Update(float deltaTime,
                                       Resources::Scene &scene) {
+        PRISM_PROFILE_SCOPE("CameraCreationSystem::Update");
+
         // In the future there will be more camera types.
 
         auto &registry = scene.GetRegistry();
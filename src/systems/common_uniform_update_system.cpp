@@ -1,26 +1,40 @@
 #include "systems/common_uniform_update_system.hpp"
 
+#include "utils/profiler.hpp"
+
 #include "components/camera.hpp"
 #include "components/fps_camera_control.hpp"
 #include "components/tags.hpp"
 #include "components/transform.hpp"
 
 #include "resources/common_resource.hpp"
-#include "resources/vulkan/vk_buffer_resource.hpp"
 
 #include <glm/gtc/matrix_transform.hpp>
 
+#include <stdexcept>
+
 namespace Prism::Systems {
     namespace {} // namespace
 
-    CommonUniformUpdateSystem::CommonUniformUpdateSystem(Resources::ContextResources &contextResources) : m_contextResources(contextResources) {};
+    CommonUniformUpdateSystem::CommonUniformUpdateSystem(Resources::ContextResources &contextResources)
+        : m_contextResources(contextResources),
+          m_commonUniformHandle(contextResources.GetResourceStorage().Emplace(Resources::CommonUniformResource::COMMON_UNIFORM_ID,
+                                                                              Resources::CommonUniformResource{})) {};
 
     void CommonUniformUpdateSystem::Initialize() {
 
     };
 
     void CommonUniformUpdateSystem::Update(float deltaTime, Resources::Scene &scene) {
-        auto window = m_contextResources.GetWindowResource().GetWindow();
+        PRISM_PROFILE_SCOPE("CommonUniformUpdateSystem::Update");
+
+        auto *commonUniform = m_contextResources.GetResourceStorage().Get(m_commonUniformHandle);
+        if (commonUniform == nullptr) {
+            throw std::runtime_error("Common uniform resource was removed!");
+        }
+
+        // Offset of the previous frame points into a region that is being reused.
+        commonUniform->offset = std::nullopt;
 
         auto &registry = scene.GetRegistry();
 
@@ -42,29 +56,7 @@ namespace Prism::Systems {
         shaderData.projection = glm::scale(camera.projection, glm::vec3(1.0f, -1.0f, 1.0f)); // Flip Y in the projection matrix - VULKAN
         shaderData.cameraPosition = glm::vec4(transform.transform[3]);
 
-        auto &vulkanResource = m_contextResources.GetVulkanResource();
-        auto &resourceStorage = m_contextResources.GetResourceStorage();
-        auto currentFrame = vulkanResource.GetCurrentFrameOffset();
-        auto uniformBufferOpt =
-            resourceStorage.Get<Resources::VkBufferResource<Resources::CommonResource>>(Resources::CommonResource::UNIFORM_BUFFER_ID, currentFrame);
-        if (!uniformBufferOpt) {
-            auto uniformBuffer = std::make_unique<Resources::VkBufferResource<Resources::CommonResource>>(
-                vulkanResource.GetVmaAllocator(), sizeof(Resources::CommonResource), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU);
-
-            resourceStorage.Insert<Resources::VkBufferResource<Resources::CommonResource>>(Resources::CommonResource::UNIFORM_BUFFER_ID,
-                                                                                           std::move(uniformBuffer), currentFrame);
-            uniformBufferOpt =
-                resourceStorage.Get<Resources::VkBufferResource<Resources::CommonResource>>(Resources::CommonResource::UNIFORM_BUFFER_ID, currentFrame);
-        }
-        auto &uniformBuffer = uniformBufferOpt->get();
-
-        void *data = nullptr;
-        VmaAllocator allocator = vulkanResource.GetVmaAllocator();
-        VmaAllocation allocation = uniformBuffer.GetAllocation();
-
-        if (vmaMapMemory(allocator, allocation, &data) == VK_SUCCESS) {
-            std::memcpy(data, &shaderData, uniformBuffer.GetBufferSize());
-            vmaUnmapMemory(allocator, allocation);
-        }
+        // Persistently mapped, so this is a plain copy. Running out of ring space leaves the frame without camera, same as no camera at all.
+        commonUniform->offset = m_contextResources.GetUniformRingResource().Write(shaderData);
     };
 } // namespace Prism::Systems
\ No newline at end of file
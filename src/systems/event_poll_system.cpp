@@ -1,5 +1,7 @@
 #include "systems/event_poll_system.hpp"
 
+#include "utils/profiler.hpp"
+
 #include "imgui.h"
 
 #include "events/move_events.hpp"
@@ -14,7 +16,11 @@ namespace Prism::Systems {
     };
 
     void EventPollSystem::Update(float deltaTime) {
-        glfwPollEvents();
+        PRISM_PROFILE_SCOPE("EventPollSystem::Update");
+
+        if (!m_contextResources.GetWindowResource().IsHeadless()) {
+            glfwPollEvents();
+        }
 
         auto &dispatcher = m_contextResources.GetDispatcher();
 
@@ -1,5 +1,7 @@
 #include "systems/fps_motion_control_system.hpp"
 
+#include "utils/profiler.hpp"
+
 #include "components/camera.hpp"
 #include "components/fps_camera_control.hpp"
 #include "components/tags.hpp"
@@ -38,6 +40,8 @@ namespace Prism::Systems {
     };
 
     void FpsMotionControlSystem::Update(float deltaTime, Resources::Scene &scene) {
+        PRISM_PROFILE_SCOPE("FpsMotionControlSystem::Update");
+
         auto &registry = scene.GetRegistry();
 
         auto activeCameraView = registry.view<Components::Tags::ActiveCamera>();
@@ -1,8 +1,11 @@
 #include "systems/gizmo_drawing_system.hpp"
 
+#include "utils/profiler.hpp"
+
 #include "components/camera.hpp"
 #include "components/fps_camera_control.hpp"
 #include "components/mesh.hpp"
+#include "components/node.hpp"
 #include "components/tags.hpp"
 #include "components/transform.hpp"
 
@@ -18,7 +21,10 @@
 #include <vector>
 
 namespace Prism::Systems {
-    namespace {}
+    namespace {
+        // In pixels, further drags rotate the camera instead of selecting.
+        constexpr float PICKING_DRAG_THRESHOLD = 4.0f;
+    } // namespace
 
     GizmoDrawingSystem::GizmoDrawingSystem(Resources::ContextResources &contextResources) : m_contextResources(contextResources) {
 
@@ -29,41 +35,42 @@ namespace Prism::Systems {
 
     };
 
-    void GizmoDrawingSystem::Update(float deltaTime, VkCommandBuffer commandBuffer, Resources::Scene &scene) {
-        VkCommandBufferBeginInfo beginInfo{};
-        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-        vkBeginCommandBuffer(commandBuffer, &beginInfo);
+    bool GizmoDrawingSystem::Update(float deltaTime, VkCommandBuffer commandBuffer, Resources::Scene &scene) {
+        PRISM_PROFILE_SCOPE("GizmoDrawingSystem::Update");
 
         auto &registry = scene.GetRegistry();
 
         auto activeCameraView = registry.view<Components::Tags::ActiveCamera>();
         if (activeCameraView.empty()) {
-            vkEndCommandBuffer(commandBuffer);
-            return;
+            return false;
         }
         auto cameraEntity = activeCameraView.front();
 
         if (!registry.all_of<Components::Camera>(cameraEntity)) {
-            vkEndCommandBuffer(commandBuffer);
-            return;
+            return false;
         }
 
+        auto &camera = registry.get<Components::Camera>(cameraEntity);
+
+        pickSelectedNode(scene, camera);
+
         auto selectedNodeView = registry.view<Components::Tags::SelectedNode>();
         if (selectedNodeView.empty()) {
-            vkEndCommandBuffer(commandBuffer);
-            return;
+            return false;
         }
         auto selectedNodeEntity = selectedNodeView.front();
 
-        if (!registry.all_of<Components::Transform>(selectedNodeEntity)) {
-            vkEndCommandBuffer(commandBuffer);
-            return;
+        if (!registry.all_of<Components::Transform, Components::WorldTransform>(selectedNodeEntity)) {
+            return false;
         }
 
-        auto &camera = registry.get<Components::Camera>(cameraEntity);
-
-        auto &selectedNodeTransform = registry.get<Components::Transform>(selectedNodeEntity);
+        // Gizmo works in world space, edits are converted back relative to the parent.
+        glm::mat4 worldTransform = registry.get<Components::WorldTransform>(selectedNodeEntity).transform;
+        glm::mat4 parentWorldTransform = glm::mat4(1.0f);
+        if (const auto *node = registry.try_get<Components::Node>(selectedNodeEntity);
+            node != nullptr && registry.valid(node->parent) && registry.all_of<Components::WorldTransform>(node->parent)) {
+            parentWorldTransform = registry.get<Components::WorldTransform>(node->parent).transform;
+        }
 
         auto [width, height] = m_contextResources.GetVulkanResource().GetSwapchainExtent();
 
@@ -87,26 +94,62 @@ namespace Prism::Systems {
         ImGuizmo::SetRect(viewport->Pos.x, viewport->Pos.y, viewport->Size.x, viewport->Size.y);
 
         glm::vec3 translation, rotation, scale;
-        ImGuizmo::DecomposeMatrixToComponents(glm::value_ptr(selectedNodeTransform.transform), glm::value_ptr(translation), glm::value_ptr(rotation),
+        ImGuizmo::DecomposeMatrixToComponents(glm::value_ptr(worldTransform), glm::value_ptr(translation), glm::value_ptr(rotation),
                                               glm::value_ptr(scale));
 
-        ImGuizmo::Manipulate(glm::value_ptr(camera.view), glm::value_ptr(camera.projection), imGuizmoOperation, ImGuizmo::MODE::WORLD,
-                             glm::value_ptr(selectedNodeTransform.transform));
+        // Patch lets TransformSystem propagate the change to the subtree of the node.
+        if (ImGuizmo::Manipulate(glm::value_ptr(camera.view), glm::value_ptr(camera.projection), imGuizmoOperation, ImGuizmo::MODE::WORLD,
+                                 glm::value_ptr(worldTransform))) {
+            registry.patch<Components::Transform>(selectedNodeEntity,
+                                                  [&](auto &transform) { transform.transform = glm::inverse(parentWorldTransform) * worldTransform; });
+        }
 
         ImGui::End();
 
         m_keyToStateMap.clear();
 
-        vkEndCommandBuffer(commandBuffer);
+        return false;
     };
 
-    void GizmoDrawingSystem::Render(float deltaTime, VkCommandBuffer commandBuffer, Resources::Scene &scene, Resources::RenderTargetResource &renderTarget) {
-        VkCommandBufferBeginInfo beginInfo{};
-        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-        vkBeginCommandBuffer(commandBuffer, &beginInfo);
+    bool GizmoDrawingSystem::Render(float deltaTime, VkCommandBuffer commandBuffer, Resources::Scene &scene, Resources::RenderTargetResource &renderTarget) {
+        PRISM_PROFILE_SCOPE("GizmoDrawingSystem::Render");
+
+        // Gizmo is an ImGui window, it is drawn with the rest of the UI.
+        return false;
+    }
+
+    void GizmoDrawingSystem::pickSelectedNode(Resources::Scene &scene, const Components::Camera &camera) {
+        auto &io = ImGui::GetIO();
+
+        // Left button also rotates the camera, so only clicks without a drag select. Clicks on UI & gizmo handles are theirs.
+        if (!ImGui::IsMouseReleased(ImGuiMouseButton_Left) || io.WantCaptureMouse || ImGuizmo::IsOver() ||
+            io.MouseDragMaxDistanceSqr[ImGuiMouseButton_Left] > PICKING_DRAG_THRESHOLD * PICKING_DRAG_THRESHOLD) {
+            return;
+        }
+
+        ImGuiViewport *viewport = ImGui::GetMainViewport();
+        if (viewport->Size.x <= 0.0f || viewport->Size.y <= 0.0f) {
+            return;
+        }
+
+        // Projection isn't flipped and neither is the viewport, so NDC y points down like window coordinates.
+        glm::vec2 ndc = glm::vec2((io.MousePos.x - viewport->Pos.x) / viewport->Size.x, (io.MousePos.y - viewport->Pos.y) / viewport->Size.y) * 2.0f - 1.0f;
+
+        glm::mat4 inverseViewProjection = glm::inverse(camera.projection * camera.view);
+        glm::vec4 nearPoint = inverseViewProjection * glm::vec4(ndc, -1.0f, 1.0f);
+        glm::vec4 farPoint = inverseViewProjection * glm::vec4(ndc, 1.0f, 1.0f);
+        glm::vec3 origin = glm::vec3(nearPoint) / nearPoint.w;
+        glm::vec3 direction = glm::vec3(farPoint) / farPoint.w - origin;
+
+        auto &registry = scene.GetRegistry();
+
+        auto hit = scene.GetSpatialIndex().Raycast(origin, direction);
+        if (!hit) {
+            return;
+        }
 
-        vkEndCommandBuffer(commandBuffer);
+        registry.clear<Components::Tags::SelectedNode>();
+        registry.emplace<Components::Tags::SelectedNode>(hit->entity);
     }
 
     void GizmoDrawingSystem::onKeyPressed(const Events::KeyPressEvent &event) { m_keyToStateMap[event.key] = event.action; }
@@ -1,5 +1,7 @@
 #include "systems/input_control_system.hpp"
 
+#include "utils/profiler.hpp"
+
 #include "events/app_events.hpp"
 #include "events/move_events.hpp"
 
@@ -92,10 +94,17 @@ namespace Prism::Systems {
     void InputControlSystem::Initialize() {};
 
     void InputControlSystem::Update(float deltaTime) {
+        PRISM_PROFILE_SCOPE("InputControlSystem::Update");
+
         auto &dispatcher = m_contextResources.GetDispatcher();
         auto &window = m_contextResources.GetWindowResource();
         auto windowPtr = window.GetWindow();
 
+        // Headless mode has no window, so there is no input to poll.
+        if (window.IsHeadless()) {
+            return;
+        }
+
         handleWindowClose(dispatcher, window);
         handleWindowResize(dispatcher, window);
 
@@ -0,0 +1,749 @@
+#include "systems/mesh_culling_system.hpp"
+
+#include "utils/profiler.hpp"
+
+#include "components/camera.hpp"
+#include "components/mesh.hpp"
+#include "components/mesh_lod.hpp"
+#include "components/tags.hpp"
+#include "components/transform.hpp"
+
+#include "utils/vulkan/common.hpp"
+
+#include "resources/common_resource.hpp"
+#include "resources/mesh_culling_statistics_resource.hpp"
+#include "resources/vulkan/vk_buffer_resource.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#ifndef MESH_CULLING_COMP_SHADER_PATH
+#error "MESH_CULLING_COMP_SHADER_PATH is not defined!"
+#endif
+
+#ifndef MESH_DRAW_COMPACTION_COMP_SHADER_PATH
+#error "MESH_DRAW_COMPACTION_COMP_SHADER_PATH is not defined!"
+#endif
+
+namespace Prism::Systems {
+    namespace {
+        // Has to match local_size_x of culling shaders.
+        constexpr uint32_t WORKGROUP_SIZE = 64;
+
+        constexpr uint32_t STORAGE_BUFFER_BINDING_COUNT = MeshCullingSystem::STORAGE_BUFFER_BINDING_COUNT;
+        using StorageBuffers = MeshCullingSystem::StorageBuffers;
+
+        // Culling pass reads only count.
+        struct PushConstants {
+            uint32_t count;
+            uint32_t firstDraws[Resources::MeshResource::VERTEX_FORMAT_COUNT];
+        };
+
+        VkDescriptorPool createDescriptorPool(VkDevice device, uint32_t framesInFlight) {
+            VkDescriptorPool descriptorPool;
+
+            std::array<VkDescriptorPoolSize, 2> poolSizes{};
+            poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+            poolSizes[0].descriptorCount = framesInFlight;
+            poolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            poolSizes[1].descriptorCount = framesInFlight * STORAGE_BUFFER_BINDING_COUNT;
+
+            VkDescriptorPoolCreateInfo poolInfo{};
+            poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+            poolInfo.maxSets = framesInFlight;
+            poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+            poolInfo.pPoolSizes = poolSizes.data();
+
+            if (vkCreateDescriptorPool(device, &poolInfo, nullptr, &descriptorPool) != VK_SUCCESS) {
+                throw std::runtime_error("Failed to create descriptor pool!");
+            }
+
+            return descriptorPool;
+        }
+
+        // 0 - common uniforms, 1 - cull instances, 2 - draw groups, 3 - visible instances, 4 - statistics, 5 - compacted draws.
+        VkDescriptorSetLayout createDescriptorSetLayout(VkDevice device) {
+            VkDescriptorSetLayout descriptorSetLayout;
+
+            std::array<VkDescriptorSetLayoutBinding, STORAGE_BUFFER_BINDING_COUNT + 1> bindings{};
+            for (uint32_t i = 0; i < bindings.size(); i++) {
+                bindings[i].binding = i;
+                bindings[i].descriptorType = i == 0 ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+                bindings[i].descriptorCount = 1;
+                bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+                bindings[i].pImmutableSamplers = nullptr;
+            }
+
+            VkDescriptorSetLayoutCreateInfo layoutInfo{};
+            layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+            layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+            layoutInfo.pBindings = bindings.data();
+
+            if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &descriptorSetLayout) != VK_SUCCESS) {
+                throw std::runtime_error("failed to create descriptor set layout");
+            }
+
+            return descriptorSetLayout;
+        }
+
+        std::vector<VkDescriptorSet> createDescriptorSets(VkDevice device, VkDescriptorPool descriptorPool, VkDescriptorSetLayout descriptorSetLayout,
+                                                  uint32_t framesInFlight) {
+            std::vector<VkDescriptorSet> descriptorSets;
+
+            descriptorSets.resize(framesInFlight);
+
+            std::vector<VkDescriptorSetLayout> layouts(framesInFlight, descriptorSetLayout);
+
+            VkDescriptorSetAllocateInfo allocInfo{};
+            allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+            allocInfo.descriptorPool = descriptorPool;
+            allocInfo.descriptorSetCount = static_cast<uint32_t>(layouts.size());
+            allocInfo.pSetLayouts = layouts.data();
+
+            if (vkAllocateDescriptorSets(device, &allocInfo, descriptorSets.data()) != VK_SUCCESS) {
+                throw std::runtime_error("Failed to allocate descriptor sets!");
+            }
+
+            return descriptorSets;
+        }
+
+        VkPipelineLayout createPipelineLayout(VkDevice device, VkDescriptorSetLayout descriptorSetLayout) {
+            VkPipelineLayout pipelineLayout;
+
+            VkPushConstantRange pushConstantRange{};
+            pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+            pushConstantRange.offset = 0;
+            pushConstantRange.size = sizeof(PushConstants);
+
+            VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+            pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+            pipelineLayoutInfo.setLayoutCount = 1;
+            pipelineLayoutInfo.pSetLayouts = &descriptorSetLayout;
+            pipelineLayoutInfo.pushConstantRangeCount = 1;
+            pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+
+            if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) {
+                throw std::runtime_error("Failed to create pipeline layout!");
+            }
+
+            return pipelineLayout;
+        }
+
+        VkPipeline createComputePipeline(VkDevice device, VkPipelineLayout pipelineLayout, const char *shaderPath) {
+            VkShaderModule shaderModule = Utils::Vulkan::Common::loadShaderModule(device, shaderPath);
+
+            VkComputePipelineCreateInfo pipelineCreateInfo{};
+            pipelineCreateInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+            pipelineCreateInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+            pipelineCreateInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+            pipelineCreateInfo.stage.module = shaderModule;
+            pipelineCreateInfo.stage.pName = "main";
+            pipelineCreateInfo.layout = pipelineLayout;
+
+            VkPipeline pipeline{};
+            if (vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pipelineCreateInfo, nullptr, &pipeline) != VK_SUCCESS) {
+                vkDestroyShaderModule(device, shaderModule, nullptr);
+                throw std::runtime_error("vkCreateComputePipelines failed");
+            }
+
+            vkDestroyShaderModule(device, shaderModule, nullptr);
+
+            return pipeline;
+        }
+
+        // Common uniforms are selected from the uniform ring with a dynamic offset, so they are written once.
+        void writeCommonUniformDescriptor(VkDevice device, VkDescriptorSet descriptorSet, VkBuffer uniformRingBuffer) {
+            VkDescriptorBufferInfo bufferInfo{};
+            bufferInfo.buffer = uniformRingBuffer;
+            bufferInfo.offset = 0;
+            bufferInfo.range = sizeof(Resources::CommonResource);
+
+            VkWriteDescriptorSet descriptorWrite{};
+            descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            descriptorWrite.dstSet = descriptorSet;
+            descriptorWrite.dstBinding = 0;
+            descriptorWrite.dstArrayElement = 0;
+            descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+            descriptorWrite.descriptorCount = 1;
+            descriptorWrite.pBufferInfo = &bufferInfo;
+
+            vkUpdateDescriptorSets(device, 1, &descriptorWrite, 0, nullptr);
+        }
+
+        StorageBuffers getStorageBuffers(const Resources::MeshDrawListResource &drawList) {
+            return {
+                drawList.cullInstanceBuffer.GetRange(), drawList.drawGroupBuffer.GetRange(),   drawList.instanceBuffer.GetRange(),
+                drawList.statisticsBuffer.GetRange(),   drawList.drawCommandBuffer.GetRange(),
+            };
+        }
+
+        void writeStorageDescriptors(VkDevice device, VkDescriptorSet descriptorSet, const StorageBuffers &buffers) {
+            std::array<VkDescriptorBufferInfo, STORAGE_BUFFER_BINDING_COUNT> bufferInfos{};
+            std::array<VkWriteDescriptorSet, STORAGE_BUFFER_BINDING_COUNT> descriptorWrites{};
+
+            for (uint32_t i = 0; i < buffers.size(); i++) {
+                bufferInfos[i].buffer = buffers[i].buffer;
+                bufferInfos[i].offset = buffers[i].offset;
+                bufferInfos[i].range = buffers[i].size;
+
+                descriptorWrites[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                descriptorWrites[i].dstSet = descriptorSet;
+                descriptorWrites[i].dstBinding = i + 1;
+                descriptorWrites[i].dstArrayElement = 0;
+                descriptorWrites[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+                descriptorWrites[i].descriptorCount = 1;
+                descriptorWrites[i].pBufferInfo = &bufferInfos[i];
+            }
+
+            vkUpdateDescriptorSets(device, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);
+        }
+
+        // Reallocates buffer from the arena when it can't hold elementCount elements. Buffers of a draw list are only used by its own
+        // frame in flight, whose fence was already waited on - so old range can be released right away.
+        template <typename T> void reserveBuffer(Resources::VkBufferResource<T> &buffer, Resources::BufferArenaResource &arena, size_t elementCount) {
+            // Empty scene still needs a valid buffer to bind.
+            elementCount = std::max<size_t>(elementCount, 1);
+
+            if (buffer.GetBuffer() != VK_NULL_HANDLE && buffer.GetElementCount() >= elementCount) {
+                return;
+            }
+
+            // Grow to the next power of two, so buffer isn't recreated every time a single entity is added.
+            size_t capacity = 64;
+            while (capacity < elementCount) {
+                capacity *= 2;
+            }
+
+            // Old range is released before the new one is allocated, so a grown buffer can take its place.
+            buffer = {};
+            buffer = arena.Allocate<T>(sizeof(T) * capacity);
+        }
+
+        template <typename T> void writeBuffer(Resources::VkBufferResource<T> &buffer, const T *data, size_t elementCount) {
+            void *mappedData = nullptr;
+            if (elementCount == 0 || (mappedData = buffer.Map()) == nullptr) {
+                return;
+            }
+
+            std::memcpy(mappedData, data, sizeof(T) * elementCount);
+            buffer.Flush(0, sizeof(T) * elementCount);
+            buffer.Unmap();
+        }
+
+        std::optional<Resources::MeshDrawListResource::Statistics> readStatistics(Resources::MeshDrawListResource &drawList) {
+            void *mappedData = nullptr;
+            if (drawList.statisticsBuffer.GetBuffer() == VK_NULL_HANDLE || (mappedData = drawList.statisticsBuffer.Map()) == nullptr) {
+                return std::nullopt;
+            }
+
+            // Written by the culling shader, GPU_TO_CPU memory isn't always coherent.
+            drawList.statisticsBuffer.Invalidate(0, sizeof(Resources::MeshDrawListResource::Statistics));
+
+            Resources::MeshDrawListResource::Statistics statistics{};
+            std::memcpy(&statistics, mappedData, sizeof(statistics));
+            drawList.statisticsBuffer.Unmap();
+
+            return statistics;
+        }
+
+        // Draw lists are also published by ID & frame for MeshDrawingSystem, handles spare the lookup on this side.
+        Resources::MeshDrawListResource &getDrawList(Resources::ResourceStorage &resourceStorage,
+                                                     Resources::ResourceHandle<Resources::MeshDrawListResource> &handle, size_t frame) {
+            auto *drawList = resourceStorage.Get(handle);
+            if (drawList == nullptr) {
+                handle = resourceStorage.Emplace(Resources::MeshDrawListResource::DRAW_LIST_ID, Resources::MeshDrawListResource{}, frame);
+                drawList = resourceStorage.Get(handle);
+            }
+
+            return *drawList;
+        }
+
+        uint32_t getDispatchSize(uint32_t count) { return (count + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE; }
+
+        // Coarsest LOD is picked whose simplification error projects to at most this many pixels.
+        constexpr float LOD_ERROR_THRESHOLD = 1.0f;
+        // Switching to a coarser LOD requires the error to get this much below the threshold, so instances at the boundary don't pop every frame.
+        constexpr float LOD_HYSTERESIS = 0.25f;
+
+        uint32_t selectLod(const Resources::MeshResource &mesh, const glm::mat4 &model, const glm::vec3 &cameraPosition, float pixelsPerUnit,
+                           uint32_t previousLevel) {
+            const auto &lodErrors = mesh.GetLodErrors();
+            if (lodErrors.size() <= 1) {
+                return 0;
+            }
+            previousLevel = std::min(previousLevel, static_cast<uint32_t>(lodErrors.size() - 1));
+
+            const auto &boundingSphere = mesh.GetBoundingSphere();
+            float scale = std::max({glm::length(glm::vec3(model[0])), glm::length(glm::vec3(model[1])), glm::length(glm::vec3(model[2]))});
+            glm::vec3 center = glm::vec3(model * glm::vec4(boundingSphere.center, 1.0f));
+
+            // Distance to the closest point of bounds, camera inside of them always gets full detail.
+            float distance = glm::length(center - cameraPosition) - boundingSphere.radius * scale;
+            if (distance <= 0.0f) {
+                return 0;
+            }
+
+            float pixelsPerObjectUnit = scale * pixelsPerUnit / distance;
+            auto getCoarsestLevel = [&](float threshold) {
+                uint32_t level = 0;
+                while (level + 1 < lodErrors.size() && lodErrors[level + 1] * pixelsPerObjectUnit <= threshold) {
+                    level++;
+                }
+                return level;
+            };
+
+            uint32_t level = getCoarsestLevel(LOD_ERROR_THRESHOLD);
+            if (level <= previousLevel) {
+                return level;
+            }
+
+            return std::max(previousLevel, getCoarsestLevel(LOD_ERROR_THRESHOLD * (1.0f - LOD_HYSTERESIS)));
+        }
+    } // namespace
+
+    MeshCullingSystem::MeshCullingSystem(Resources::ContextResources &contextResources) : m_contextResources(contextResources) {
+        auto &vulkanResource = m_contextResources.GetVulkanResource();
+        VkDevice device = vulkanResource.GetDevice();
+
+        VkPhysicalDeviceVulkan12Features vulkan12Features{};
+        vulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+
+        VkPhysicalDeviceFeatures2 features{};
+        features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        features.pNext = &vulkan12Features;
+        vkGetPhysicalDeviceFeatures2(vulkanResource.GetPhysicalDevice(), &features);
+
+        // All of them are enabled on device creation whenever they are available.
+        gpuCullingSupported = features.features.multiDrawIndirect == VK_TRUE && features.features.drawIndirectFirstInstance == VK_TRUE &&
+                              vulkan12Features.drawIndirectCount == VK_TRUE;
+
+        Resources::MeshCullingStatisticsResource statistics{};
+        statistics.gpuCulling = gpuCullingSupported;
+        statisticsHandle = m_contextResources.GetResourceStorage().Emplace(Resources::MeshCullingStatisticsResource::STATISTICS_ID, std::move(statistics));
+
+        if (!gpuCullingSupported) {
+            return;
+        }
+
+        descriptorPool = createDescriptorPool(device, vulkanResource.GetFramesInFlight());
+        descriptorSetLayout = createDescriptorSetLayout(device);
+        descriptorSets = createDescriptorSets(device, descriptorPool, descriptorSetLayout, vulkanResource.GetFramesInFlight());
+        for (auto descriptorSet : descriptorSets) {
+            writeCommonUniformDescriptor(device, descriptorSet, m_contextResources.GetUniformRingResource().GetBuffer());
+        }
+        boundStorageBuffers.assign(descriptorSets.size(), {});
+        pipelineLayout = createPipelineLayout(device, descriptorSetLayout);
+        cullingPipeline = createComputePipeline(device, pipelineLayout, MESH_CULLING_COMP_SHADER_PATH);
+        compactionPipeline = createComputePipeline(device, pipelineLayout, MESH_DRAW_COMPACTION_COMP_SHADER_PATH);
+    };
+
+    MeshCullingSystem::~MeshCullingSystem() {
+        auto &vulkanResource = m_contextResources.GetVulkanResource();
+        VkDevice device = vulkanResource.GetDevice();
+
+        if (compactionPipeline != VK_NULL_HANDLE) {
+            vkDestroyPipeline(device, compactionPipeline, nullptr);
+            compactionPipeline = VK_NULL_HANDLE;
+        }
+        if (cullingPipeline != VK_NULL_HANDLE) {
+            vkDestroyPipeline(device, cullingPipeline, nullptr);
+            cullingPipeline = VK_NULL_HANDLE;
+        }
+        if (pipelineLayout != VK_NULL_HANDLE) {
+            vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
+            pipelineLayout = VK_NULL_HANDLE;
+        }
+        if (descriptorSetLayout != VK_NULL_HANDLE) {
+            vkDestroyDescriptorSetLayout(device, descriptorSetLayout, nullptr);
+            descriptorSetLayout = VK_NULL_HANDLE;
+        }
+        if (descriptorPool != VK_NULL_HANDLE) {
+            vkDestroyDescriptorPool(device, descriptorPool, nullptr);
+            descriptorPool = VK_NULL_HANDLE;
+        }
+    }
+
+    void MeshCullingSystem::Initialize() {
+
+    };
+
+    bool MeshCullingSystem::Update(float deltaTime, VkCommandBuffer commandBuffer, Resources::Scene &scene) {
+        PRISM_PROFILE_SCOPE("MeshCullingSystem::Update");
+
+        auto &resourceStorage = m_contextResources.GetResourceStorage();
+        auto &vulkanResource = m_contextResources.GetVulkanResource();
+
+        auto currentFrame = vulkanResource.GetCurrentFrameOffset();
+        auto &drawList = getDrawList(resourceStorage, drawListHandles[currentFrame], currentFrame);
+
+        // Previous frame that used this draw list has finished, so its GPU written statistics are complete.
+        if (drawList.gpuCulled) {
+            if (auto statistics = readStatistics(drawList)) {
+                getStatistics().statistics = *statistics;
+            }
+        }
+
+        buildDrawGroups(scene, getLodProjection(scene));
+
+        auto commonUniformOpt = resourceStorage.Get<Resources::CommonUniformResource>(Resources::CommonUniformResource::COMMON_UNIFORM_ID);
+
+        if (!gpuCullingSupported) {
+            writeCpuDrawList(drawList, getCameraFrustum(scene));
+        } else if (commonUniformOpt && commonUniformOpt->get().offset) {
+            prepareGpuCulling(drawList, currentFrame);
+        } else {
+            // Nothing is drawn without camera uniforms anyway.
+            drawList.maxDrawCount = 0;
+            drawList.formatDrawRanges = {};
+            drawList.gpuCulled = false;
+        }
+
+        // Only host memory is written here, dispatches are recorded by Render.
+        return false;
+    };
+
+    bool MeshCullingSystem::Render(float deltaTime, VkCommandBuffer commandBuffer, Resources::Scene &scene, Resources::RenderTargetResource &renderTarget) {
+        PRISM_PROFILE_SCOPE("MeshCullingSystem::Render");
+
+        auto &resourceStorage = m_contextResources.GetResourceStorage();
+        auto &vulkanResource = m_contextResources.GetVulkanResource();
+
+        auto currentFrame = vulkanResource.GetCurrentFrameOffset();
+        auto &drawList = getDrawList(resourceStorage, drawListHandles[currentFrame], currentFrame);
+
+        // Prepared by Update only when camera uniforms were there.
+        auto commonUniformOpt = resourceStorage.Get<Resources::CommonUniformResource>(Resources::CommonUniformResource::COMMON_UNIFORM_ID);
+        if (!drawList.gpuCulled || drawList.maxDrawCount == 0 || !commonUniformOpt || !commonUniformOpt->get().offset) {
+            return drawList.gpuCulled;
+        }
+
+        auto &gpuProfiler = m_contextResources.GetGpuProfilerResource();
+        auto gpuZone = gpuProfiler.BeginZone(commandBuffer, "MeshCullingSystem");
+
+        recordGpuCulling(commandBuffer, drawList, *commonUniformOpt->get().offset, currentFrame);
+
+        gpuProfiler.EndZone(commandBuffer, gpuZone);
+
+        return true;
+    }
+
+    Resources::MeshDrawListResource &MeshCullingSystem::GetDrawList() {
+        auto currentFrame = m_contextResources.GetVulkanResource().GetCurrentFrameOffset();
+        return getDrawList(m_contextResources.GetResourceStorage(), drawListHandles[currentFrame], currentFrame);
+    }
+
+    Resources::MeshCullingStatisticsResource &MeshCullingSystem::getStatistics() {
+        auto *statistics = m_contextResources.GetResourceStorage().Get(statisticsHandle);
+        if (statistics == nullptr) {
+            throw std::runtime_error("Mesh culling statistics were removed!");
+        }
+
+        return *statistics;
+    }
+
+    void MeshCullingSystem::buildDrawGroups(Resources::Scene &scene, const std::optional<LodProjection> &lodProjection) {
+        auto &registry = scene.GetRegistry();
+
+        // Group submeshes of entities by mesh, submesh & LOD, so every unique triple is drawn as a single instanced indirect command
+        // and culled on its own bounds. Groups are ordered by vertex format, so draws of every format form a single range drawn with
+        // its pipeline. Entities of missing meshes are skipped, so firstInstance of draws points into compacted instance data.
+        auto meshTransformView = registry.view<Components::Mesh, Components::WorldTransform>();
+
+        drawInstances.clear();
+        for (const auto &meshEntity : meshTransformView) {
+            const auto meshResourceId = meshTransformView.get<Components::Mesh>(meshEntity).resourceId;
+
+            auto meshOpt = scene.GetMesh(meshResourceId);
+            if (!meshOpt) {
+                continue;
+            }
+            const auto &mesh = meshOpt->get();
+
+            uint32_t lod = 0;
+            if (lodProjection) {
+                auto &meshLod = registry.get_or_emplace<Components::MeshLod>(meshEntity);
+                const auto &worldTransform = meshTransformView.get<Components::WorldTransform>(meshEntity).transform;
+                meshLod.level = selectLod(mesh, worldTransform, lodProjection->cameraPosition, lodProjection->pixelsPerUnit, meshLod.level);
+                lod = meshLod.level;
+            }
+
+            const auto &submeshes = mesh.GetSubmeshes();
+            for (uint32_t submesh = 0; submesh < submeshes.size(); submesh++) {
+                // Submeshes with fewer levels stay at their coarsest one, so they still share draws with other entities.
+                const auto submeshLod = std::min(lod, static_cast<uint32_t>(submeshes[submesh].lods.size()) - 1);
+                drawInstances.push_back({mesh.GetVertexFormat(), meshResourceId, submesh, submeshLod, meshEntity});
+            }
+        }
+
+        std::sort(drawInstances.begin(), drawInstances.end(), [](const DrawInstance &lhs, const DrawInstance &rhs) {
+            return std::tie(lhs.vertexFormat, lhs.meshId, lhs.submesh, lhs.lod) < std::tie(rhs.vertexFormat, rhs.meshId, rhs.submesh, rhs.lod);
+        });
+
+        cullInstances.clear();
+        drawGroups.clear();
+        drawGroupBounds.clear();
+        drawGroupRanges = {};
+
+        size_t firstInstance = 0;
+        while (firstInstance < drawInstances.size()) {
+            const auto &groupInstance = drawInstances[firstInstance];
+
+            size_t instanceCount = 0;
+            while (firstInstance + instanceCount < drawInstances.size()) {
+                const auto &drawInstance = drawInstances[firstInstance + instanceCount];
+                if (drawInstance.meshId != groupInstance.meshId || drawInstance.submesh != groupInstance.submesh || drawInstance.lod != groupInstance.lod) {
+                    break;
+                }
+                instanceCount++;
+            }
+
+            const auto &mesh = scene.GetMesh(groupInstance.meshId)->get();
+            const auto &geometryRange = mesh.GetGeometryRange();
+            const auto &submesh = mesh.GetSubmeshes()[groupInstance.submesh];
+            const auto &lod = submesh.lods[groupInstance.lod];
+            const auto &boundingSphere = submesh.boundingSphere;
+
+            VkDrawIndexedIndirectCommand drawGroup{};
+            drawGroup.indexCount = lod.indexCount;
+            drawGroup.instanceCount = static_cast<uint32_t>(instanceCount);
+            drawGroup.firstIndex = geometryRange.firstIndex + lod.firstIndex;
+            drawGroup.vertexOffset = static_cast<int32_t>(geometryRange.vertexOffset + submesh.vertexOffset);
+            drawGroup.firstInstance = static_cast<uint32_t>(cullInstances.size());
+
+            const auto drawIndex = static_cast<uint32_t>(drawGroups.size());
+            drawGroups.push_back(drawGroup);
+            drawGroupBounds.push_back(submesh.boundingBox);
+
+            auto &drawGroupRange = drawGroupRanges[static_cast<uint32_t>(mesh.GetVertexFormat())];
+            if (drawGroupRange.maxDrawCount == 0) {
+                drawGroupRange.firstDraw = drawIndex;
+            }
+            drawGroupRange.maxDrawCount++;
+
+            const auto &vertexDequantization = mesh.GetVertexDequantization();
+
+            for (size_t i = firstInstance; i < firstInstance + instanceCount; i++) {
+                Resources::MeshDrawListResource::CullInstance cullInstance{};
+                cullInstance.model = meshTransformView.get<Components::WorldTransform>(drawInstances[i].entity).transform;
+                cullInstance.boundingSphere = glm::vec4(boundingSphere.center, boundingSphere.radius);
+                cullInstance.positionScale = glm::vec4(vertexDequantization.scale, 1.0f);
+                cullInstance.positionOffset = glm::vec4(vertexDequantization.offset, 0.0f);
+                cullInstance.drawIndex = drawIndex;
+                cullInstances.push_back(cullInstance);
+            }
+
+            firstInstance += instanceCount;
+        }
+
+        // Normal matrices of all instances in a single SIMD batch, instead of inverting the model matrix for every vertex.
+        instanceTransforms.clear();
+        instanceTransforms.reserve(cullInstances.size());
+        for (const auto &cullInstance : cullInstances) {
+            instanceTransforms.push_back(cullInstance.model);
+        }
+
+        instanceNormalMatrices.resize(instanceTransforms.size());
+        Utils::NormalMatrices::ComputeNormalMatrices(instanceTransforms.data(), instanceNormalMatrices.data(), instanceTransforms.size());
+
+        for (size_t i = 0; i < cullInstances.size(); i++) {
+            cullInstances[i].normalMatrix = instanceNormalMatrices[i];
+        }
+    }
+
+    void MeshCullingSystem::prepareGpuCulling(Resources::MeshDrawListResource &drawList, size_t frame) {
+        auto &vulkanResource = m_contextResources.GetVulkanResource();
+        auto &hostArena = m_contextResources.GetHostBufferArenaResource();
+        auto &deviceArena = m_contextResources.GetDeviceBufferArenaResource();
+
+        const auto instanceCount = static_cast<uint32_t>(cullInstances.size());
+        const auto drawGroupCount = static_cast<uint32_t>(drawGroups.size());
+
+        // Culling pass appends visible instances, so every draw starts empty.
+        for (auto &drawGroup : drawGroups) {
+            drawGroup.instanceCount = 0;
+        }
+
+        reserveBuffer(drawList.cullInstanceBuffer, hostArena, instanceCount);
+        reserveBuffer(drawList.drawGroupBuffer, hostArena, drawGroupCount);
+        reserveBuffer(drawList.instanceBuffer, deviceArena, instanceCount);
+        reserveBuffer(drawList.drawCommandBuffer, deviceArena, drawGroupCount);
+        // Stays a dedicated buffer in cached host memory, so statistics can be read back once the frame has finished.
+        if (drawList.statisticsBuffer.GetBuffer() == VK_NULL_HANDLE) {
+            using Statistics = Resources::MeshDrawListResource::Statistics;
+            drawList.statisticsBuffer = Resources::VkBufferResource<Statistics>(vulkanResource.GetVmaAllocator(), sizeof(Statistics),
+                                                                                VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+                                                                                VMA_MEMORY_USAGE_GPU_TO_CPU);
+        }
+
+        Resources::MeshDrawListResource::Statistics statistics{};
+
+        writeBuffer(drawList.cullInstanceBuffer, cullInstances.data(), cullInstances.size());
+        writeBuffer(drawList.drawGroupBuffer, drawGroups.data(), drawGroups.size());
+        writeBuffer(drawList.statisticsBuffer, &statistics, 1);
+
+        drawList.drawCommands.clear();
+        drawList.maxDrawCount = drawGroupCount;
+        drawList.formatDrawRanges = drawGroupRanges;
+        drawList.gpuCulled = true;
+
+        if (drawGroupCount == 0) {
+            return;
+        }
+
+        // Draw list buffers are only recreated when they have to grow, so descriptors are rarely rewritten.
+        auto storageBuffers = getStorageBuffers(drawList);
+        if (boundStorageBuffers[frame] != storageBuffers) {
+            writeStorageDescriptors(vulkanResource.GetDevice(), descriptorSets[frame], storageBuffers);
+            boundStorageBuffers[frame] = storageBuffers;
+        }
+    }
+
+    void MeshCullingSystem::recordGpuCulling(VkCommandBuffer commandBuffer, Resources::MeshDrawListResource &drawList, uint32_t commonUniformOffset,
+                                             size_t frame) {
+        const auto instanceCount = static_cast<uint32_t>(cullInstances.size());
+        const auto drawGroupCount = drawList.maxDrawCount;
+
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 0, 1, &descriptorSets[frame], 1, &commonUniformOffset);
+
+        PushConstants pushConstants{.count = instanceCount, .firstDraws = {}};
+        for (uint32_t format = 0; format < Resources::MeshResource::VERTEX_FORMAT_COUNT; format++) {
+            // Empty formats still need a boundary above every draw of the preceding ones.
+            const auto &drawGroupRange = drawGroupRanges[format];
+            pushConstants.firstDraws[format] = drawGroupRange.maxDrawCount > 0 ? drawGroupRange.firstDraw : drawGroupCount;
+        }
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, cullingPipeline);
+        vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(PushConstants), &pushConstants);
+        vkCmdDispatch(commandBuffer, getDispatchSize(instanceCount), 1, 1);
+
+        // Compaction reads instance counts appended by the culling pass. Both dispatches are one render graph pass, so this barrier
+        // stays within it.
+        VkMemoryBarrier2 cullingBarrier{};
+        cullingBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+        cullingBarrier.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+        cullingBarrier.srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+        cullingBarrier.dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+        cullingBarrier.dstAccessMask = VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+
+        VkDependencyInfo dependencyInfo{};
+        dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+        dependencyInfo.memoryBarrierCount = 1;
+        dependencyInfo.pMemoryBarriers = &cullingBarrier;
+        vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+
+        pushConstants.count = drawGroupCount;
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, compactionPipeline);
+        vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(PushConstants), &pushConstants);
+        vkCmdDispatch(commandBuffer, getDispatchSize(drawGroupCount), 1, 1);
+
+        // Draws & instances consumed by MeshDrawingSystem and statistics read back by the host are synchronized by the render graph.
+    }
+
+    std::optional<Utils::Culling::Frustum> MeshCullingSystem::getCameraFrustum(Resources::Scene &scene) {
+        auto &registry = scene.GetRegistry();
+
+        auto activeCameraView = registry.view<Components::Tags::ActiveCamera>();
+        if (activeCameraView.empty()) {
+            return std::nullopt;
+        }
+        auto cameraEntity = activeCameraView.front();
+
+        if (!registry.all_of<Components::Camera>(cameraEntity)) {
+            return std::nullopt;
+        }
+
+        auto &camera = registry.get<Components::Camera>(cameraEntity);
+        return Utils::Culling::ExtractFrustum(camera.projection * camera.view);
+    }
+
+    std::optional<MeshCullingSystem::LodProjection> MeshCullingSystem::getLodProjection(Resources::Scene &scene) {
+        auto &registry = scene.GetRegistry();
+
+        auto activeCameraView = registry.view<Components::Tags::ActiveCamera>();
+        if (activeCameraView.empty()) {
+            return std::nullopt;
+        }
+        auto cameraEntity = activeCameraView.front();
+
+        if (!registry.all_of<Components::Camera>(cameraEntity)) {
+            return std::nullopt;
+        }
+
+        auto &camera = registry.get<Components::Camera>(cameraEntity);
+        auto [width, height] = m_contextResources.GetVulkanResource().GetSwapchainExtent();
+
+        LodProjection lodProjection{};
+        lodProjection.cameraPosition = glm::vec3(glm::inverse(camera.view)[3]);
+        lodProjection.pixelsPerUnit = camera.projection[1][1] * static_cast<float>(height) * 0.5f;
+        return lodProjection;
+    }
+
+    void MeshCullingSystem::writeCpuDrawList(Resources::MeshDrawListResource &drawList, const std::optional<Utils::Culling::Frustum> &frustum) {
+        PRISM_PROFILE_SCOPE("MeshCullingSystem::CpuCulling");
+
+        visibility.assign(cullInstances.size(), 1);
+
+        // Without a camera everything is kept - same as the GPU path, which draws nothing only when uniforms are missing.
+        if (frustum) {
+            boxBatch.Clear();
+            boxBatch.Reserve(cullInstances.size());
+            for (const auto &cullInstance : cullInstances) {
+                const auto &bounds = drawGroupBounds[cullInstance.drawIndex];
+                boxBatch.PushTransformed(cullInstance.model, bounds.min, bounds.max);
+            }
+
+            Utils::Culling::CullBoxes(*frustum, boxBatch, visibility.data());
+        }
+
+        // Instances are sorted by draw, so compaction keeps them contiguous and firstInstance only has to be shifted.
+        instanceModels.clear();
+        visibleDraws.clear();
+        drawList.formatDrawRanges = {};
+        for (uint32_t format = 0; format < Resources::MeshResource::VERTEX_FORMAT_COUNT; format++) {
+            const auto &drawGroupRange = drawGroupRanges[format];
+            const auto firstVisibleDraw = static_cast<uint32_t>(visibleDraws.size());
+
+            for (uint32_t drawIndex = drawGroupRange.firstDraw; drawIndex < drawGroupRange.firstDraw + drawGroupRange.maxDrawCount; drawIndex++) {
+                auto draw = drawGroups[drawIndex];
+                const auto firstVisibleInstance = static_cast<uint32_t>(instanceModels.size());
+
+                for (uint32_t i = draw.firstInstance; i < draw.firstInstance + draw.instanceCount; i++) {
+                    if (visibility[i] != 0) {
+                        const auto &cullInstance = cullInstances[i];
+                        instanceModels.push_back({cullInstance.model, cullInstance.normalMatrix, cullInstance.positionScale, cullInstance.positionOffset});
+                    }
+                }
+
+                draw.firstInstance = firstVisibleInstance;
+                draw.instanceCount = static_cast<uint32_t>(instanceModels.size()) - firstVisibleInstance;
+                if (draw.instanceCount > 0) {
+                    visibleDraws.push_back(draw);
+                }
+            }
+
+            drawList.formatDrawRanges[format] = {firstVisibleDraw, static_cast<uint32_t>(visibleDraws.size()) - firstVisibleDraw};
+        }
+
+        auto &hostArena = m_contextResources.GetHostBufferArenaResource();
+        reserveBuffer(drawList.instanceBuffer, hostArena, instanceModels.size());
+        reserveBuffer(drawList.drawCommandBuffer, hostArena, visibleDraws.size());
+
+        writeBuffer(drawList.instanceBuffer, instanceModels.data(), instanceModels.size());
+        writeBuffer(drawList.drawCommandBuffer, visibleDraws.data(), visibleDraws.size());
+
+        drawList.drawCommands = visibleDraws;
+        drawList.maxDrawCount = static_cast<uint32_t>(visibleDraws.size());
+        drawList.gpuCulled = false;
+
+        auto &statistics = getStatistics().statistics;
+        for (uint32_t format = 0; format < Resources::MeshResource::VERTEX_FORMAT_COUNT; format++) {
+            statistics.drawCounts[format] = drawList.formatDrawRanges[format].maxDrawCount;
+        }
+        statistics.visibleInstanceCount = static_cast<uint32_t>(instanceModels.size());
+        statistics.culledInstanceCount = static_cast<uint32_t>(cullInstances.size() - instanceModels.size());
+    }
+} // namespace Prism::Systems
@@ -1,17 +1,22 @@
 #include "systems/mesh_drawing_system.hpp"
 
+#include "utils/profiler.hpp"
+
 #include "components/mesh.hpp"
 #include "components/transform.hpp"
 
 #include "utils/vulkan/common.hpp"
 
 #include "resources/common_resource.hpp"
+#include "resources/mesh_draw_list_resource.hpp"
 #include "resources/vulkan/vk_buffer_resource.hpp"
 
 #include <GLFW/glfw3.h>
 
 #include <glm/gtc/type_ptr.hpp>
 
+#include <algorithm>
+#include <cstddef>
 #include <filesystem>
 #include <iostream>
 #include <vector>
@@ -26,16 +31,18 @@
 
 namespace Prism::Systems {
     namespace {
-        VkDescriptorPool createDescriptorPool(VkDevice device) {
+        VkDescriptorPool createDescriptorPool(VkDevice device, uint32_t framesInFlight) {
             VkDescriptorPool descriptorPool;
 
-            std::array<VkDescriptorPoolSize, 1> poolSizes{};
-            poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-            poolSizes[0].descriptorCount = Resources::VulkanResource::FRAMES_IN_FLIGHT;
+            std::array<VkDescriptorPoolSize, 2> poolSizes{};
+            poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+            poolSizes[0].descriptorCount = framesInFlight;
+            poolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            poolSizes[1].descriptorCount = framesInFlight;
 
             VkDescriptorPoolCreateInfo poolInfo{};
             poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-            poolInfo.maxSets = Resources::VulkanResource::FRAMES_IN_FLIGHT;
+            poolInfo.maxSets = framesInFlight;
             poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
             poolInfo.pPoolSizes = poolSizes.data();
 
@@ -51,12 +58,19 @@ namespace Prism::Systems {
 
             VkDescriptorSetLayoutBinding uboBinding{};
             uboBinding.binding = 0;
-            uboBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            uboBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
             uboBinding.descriptorCount = 1;
             uboBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
             uboBinding.pImmutableSamplers = nullptr;
 
-            std::array<VkDescriptorSetLayoutBinding, 1> bindings = {uboBinding};
+            VkDescriptorSetLayoutBinding instanceBinding{};
+            instanceBinding.binding = 1;
+            instanceBinding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            instanceBinding.descriptorCount = 1;
+            instanceBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+            instanceBinding.pImmutableSamplers = nullptr;
+
+            std::array<VkDescriptorSetLayoutBinding, 2> bindings = {uboBinding, instanceBinding};
 
             VkDescriptorSetLayoutCreateInfo layoutInfo{};
             layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
@@ -70,12 +84,13 @@ namespace Prism::Systems {
             return descriptorSetLayout;
         }
 
-        std::vector<VkDescriptorSet> createDescriptorSets(VkDevice device, VkDescriptorPool descriptorPool, VkDescriptorSetLayout descriptorSetLayout) {
+        std::vector<VkDescriptorSet> createDescriptorSets(VkDevice device, VkDescriptorPool descriptorPool, VkDescriptorSetLayout descriptorSetLayout,
+                                                  uint32_t framesInFlight) {
             std::vector<VkDescriptorSet> descriptorSets;
 
-            descriptorSets.resize(Resources::VulkanResource::FRAMES_IN_FLIGHT);
+            descriptorSets.resize(framesInFlight);
 
-            std::vector<VkDescriptorSetLayout> layouts(Resources::VulkanResource::FRAMES_IN_FLIGHT, descriptorSetLayout);
+            std::vector<VkDescriptorSetLayout> layouts(framesInFlight, descriptorSetLayout);
 
             VkDescriptorSetAllocateInfo allocInfo{};
             allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
@@ -93,17 +108,12 @@ namespace Prism::Systems {
         VkPipelineLayout createPipelineLayout(VkDevice device, VkDescriptorSetLayout descriptorSetLayout) {
             VkPipelineLayout pipelineLayout;
 
-            VkPushConstantRange pushRange{};
-            pushRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
-            pushRange.offset = 0;
-            pushRange.size = sizeof(glm::mat4);
-
             VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
             pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
             pipelineLayoutInfo.setLayoutCount = 1;
             pipelineLayoutInfo.pSetLayouts = &descriptorSetLayout;
-            pipelineLayoutInfo.pushConstantRangeCount = 1;
-            pipelineLayoutInfo.pPushConstantRanges = &pushRange;
+            pipelineLayoutInfo.pushConstantRangeCount = 0;
+            pipelineLayoutInfo.pPushConstantRanges = nullptr;
 
             if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) {
                 throw std::runtime_error("Failed to create pipeline layout!");
@@ -112,11 +122,39 @@ namespace Prism::Systems {
             return pipelineLayout;
         }
 
-        VkPipeline createPipeline(VkDevice device, VkPipelineLayout pipelineLayout) {
+        // Specialization constants of basic.vert.
+        struct BasicVertexSpecialization {
+            VkBool32 octahedralNormals;
+            VkBool32 perVertexNormalMatrix;
+        };
+
+        VkPipeline createPipeline(VkDevice device, VkPipelineLayout pipelineLayout, Resources::MeshResource::VertexFormat vertexFormat,
+                                  bool perVertexNormalMatrix) {
             // Load shader modules
             VkShaderModule vertexShaderModule = Utils::Vulkan::Common::loadShaderModule(device, BASIC_VERT_SHADER_PATH);
             VkShaderModule fragmentShaderModule = Utils::Vulkan::Common::loadShaderModule(device, BASIC_FRAG_SHADER_PATH);
 
+            const bool quantized = vertexFormat == Resources::MeshResource::VertexFormat::Quantized;
+
+            BasicVertexSpecialization specialization{};
+            specialization.octahedralNormals = quantized ? VK_TRUE : VK_FALSE;
+            specialization.perVertexNormalMatrix = perVertexNormalMatrix ? VK_TRUE : VK_FALSE;
+
+            VkSpecializationMapEntry specializationEntries[2]{};
+            specializationEntries[0].constantID = 0;
+            specializationEntries[0].offset = offsetof(BasicVertexSpecialization, octahedralNormals);
+            specializationEntries[0].size = sizeof(VkBool32);
+
+            specializationEntries[1].constantID = 1;
+            specializationEntries[1].offset = offsetof(BasicVertexSpecialization, perVertexNormalMatrix);
+            specializationEntries[1].size = sizeof(VkBool32);
+
+            VkSpecializationInfo specializationInfo{};
+            specializationInfo.mapEntryCount = 2;
+            specializationInfo.pMapEntries = specializationEntries;
+            specializationInfo.dataSize = sizeof(BasicVertexSpecialization);
+            specializationInfo.pData = &specialization;
+
             // Shader stages
             VkPipelineShaderStageCreateInfo shaderStages[2]{};
 
@@ -124,6 +162,7 @@ namespace Prism::Systems {
             shaderStages[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
             shaderStages[0].module = vertexShaderModule;
             shaderStages[0].pName = "main";
+            shaderStages[0].pSpecializationInfo = &specializationInfo;
 
             shaderStages[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
             shaderStages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
@@ -136,24 +175,42 @@ namespace Prism::Systems {
 
             VkVertexInputBindingDescription binding{};
             binding.binding = 0;
-            binding.stride = sizeof(Resources::MeshResource::Vertex);
             binding.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
 
             VkVertexInputAttributeDescription attributes[3]{};
-            attributes[0].binding = 0;
-            attributes[0].location = 0;
-            attributes[0].format = VK_FORMAT_R32G32B32_SFLOAT;
-            attributes[0].offset = offsetof(Resources::MeshResource::Vertex, position);
+            for (uint32_t location = 0; location < 3; location++) {
+                attributes[location].binding = 0;
+                attributes[location].location = location;
+            }
+
+            // Attribute formats convert quantized vertices to floats on fetch, only octahedral normals are decoded by basic.vert.
+            if (quantized) {
+                using QuantizedVertex = Resources::MeshResource::QuantizedVertex;
 
-            attributes[1].binding = 0;
-            attributes[1].location = 1;
-            attributes[1].format = VK_FORMAT_R32G32B32_SFLOAT;
-            attributes[1].offset = offsetof(Resources::MeshResource::Vertex, normal);
+                binding.stride = sizeof(QuantizedVertex);
 
-            attributes[2].binding = 0;
-            attributes[2].location = 2;
-            attributes[2].format = VK_FORMAT_R32G32_SFLOAT;
-            attributes[2].offset = offsetof(Resources::MeshResource::Vertex, textureUV);
+                attributes[0].format = VK_FORMAT_R16G16B16A16_UNORM;
+                attributes[0].offset = offsetof(QuantizedVertex, position);
+
+                attributes[1].format = VK_FORMAT_R16G16_SNORM;
+                attributes[1].offset = offsetof(QuantizedVertex, normal);
+
+                attributes[2].format = VK_FORMAT_R16G16_SFLOAT;
+                attributes[2].offset = offsetof(QuantizedVertex, textureUV);
+            } else {
+                using Vertex = Resources::MeshResource::Vertex;
+
+                binding.stride = sizeof(Vertex);
+
+                attributes[0].format = VK_FORMAT_R32G32B32_SFLOAT;
+                attributes[0].offset = offsetof(Vertex, position);
+
+                attributes[1].format = VK_FORMAT_R32G32B32_SFLOAT;
+                attributes[1].offset = offsetof(Vertex, normal);
+
+                attributes[2].format = VK_FORMAT_R32G32_SFLOAT;
+                attributes[2].offset = offsetof(Vertex, textureUV);
+            }
 
             vertexInputState.vertexBindingDescriptionCount = 1;
             vertexInputState.pVertexBindingDescriptions = &binding;
@@ -252,43 +309,76 @@ namespace Prism::Systems {
             return pipeline;
         }
 
-        void updateDescriptorSet(VkDevice device, VkDescriptorSet descriptorSet, VkBuffer commonUniformBuffer) {
+        // Common uniforms are selected from the uniform ring with a dynamic offset, so they are written once.
+        void writeCommonUniformDescriptor(VkDevice device, VkDescriptorSet descriptorSet, VkBuffer uniformRingBuffer) {
             VkDescriptorBufferInfo bufferInfo{};
-            bufferInfo.buffer = commonUniformBuffer;
+            bufferInfo.buffer = uniformRingBuffer;
             bufferInfo.offset = 0;
-            bufferInfo.range = VK_WHOLE_SIZE;
+            bufferInfo.range = sizeof(Resources::CommonResource);
 
             VkWriteDescriptorSet descriptorWrite{};
             descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
             descriptorWrite.dstSet = descriptorSet;
             descriptorWrite.dstBinding = 0;
             descriptorWrite.dstArrayElement = 0;
-            descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
             descriptorWrite.descriptorCount = 1;
             descriptorWrite.pBufferInfo = &bufferInfo;
 
             vkUpdateDescriptorSets(device, 1, &descriptorWrite, 0, nullptr);
-        };
+        }
+
+        void writeInstanceDescriptor(VkDevice device, VkDescriptorSet descriptorSet, const Resources::BufferRange &instanceBuffer) {
+            VkDescriptorBufferInfo instanceBufferInfo{};
+            instanceBufferInfo.buffer = instanceBuffer.buffer;
+            instanceBufferInfo.offset = instanceBuffer.offset;
+            instanceBufferInfo.range = instanceBuffer.size;
+
+            VkWriteDescriptorSet descriptorWrite{};
+            descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            descriptorWrite.dstSet = descriptorSet;
+            descriptorWrite.dstBinding = 1;
+            descriptorWrite.dstArrayElement = 0;
+            descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            descriptorWrite.descriptorCount = 1;
+            descriptorWrite.pBufferInfo = &instanceBufferInfo;
+
+            vkUpdateDescriptorSets(device, 1, &descriptorWrite, 0, nullptr);
+        }
     } // namespace
 
-    MeshDrawingSystem::MeshDrawingSystem(Resources::ContextResources &contextResources) : m_contextResources(contextResources) {
+    MeshDrawingSystem::MeshDrawingSystem(Resources::ContextResources &contextResources, bool perVertexNormalMatrix) : m_contextResources(contextResources) {
         auto &vulkanResource = m_contextResources.GetVulkanResource();
         VkDevice device = vulkanResource.GetDevice();
 
-        descriptorPool = createDescriptorPool(device);
+        descriptorPool = createDescriptorPool(device, vulkanResource.GetFramesInFlight());
         descriptorSetLayout = createDescriptorSetLayout(device);
-        descriptorSets = createDescriptorSets(device, descriptorPool, descriptorSetLayout);
+        descriptorSets = createDescriptorSets(device, descriptorPool, descriptorSetLayout, vulkanResource.GetFramesInFlight());
+        for (auto descriptorSet : descriptorSets) {
+            writeCommonUniformDescriptor(device, descriptorSet, m_contextResources.GetUniformRingResource().GetBuffer());
+        }
+        boundInstanceBuffers.assign(descriptorSets.size(), {});
         pipelineLayout = createPipelineLayout(device, descriptorSetLayout);
-        pipeline = createPipeline(device, pipelineLayout);
+        for (uint32_t format = 0; format < Resources::MeshResource::VERTEX_FORMAT_COUNT; format++) {
+            pipelines[format] = createPipeline(device, pipelineLayout, static_cast<Resources::MeshResource::VertexFormat>(format), perVertexNormalMatrix);
+        }
+
+        VkPhysicalDeviceFeatures features;
+        vkGetPhysicalDeviceFeatures(vulkanResource.GetPhysicalDevice(), &features);
+
+        // Both features are enabled on device creation whenever they are available.
+        multiDrawIndirectSupported = features.multiDrawIndirect == VK_TRUE && features.drawIndirectFirstInstance == VK_TRUE;
     };
 
     MeshDrawingSystem::~MeshDrawingSystem() {
         auto &vulkanResource = m_contextResources.GetVulkanResource();
         VkDevice device = vulkanResource.GetDevice();
 
-        if (pipeline != VK_NULL_HANDLE) {
-            vkDestroyPipeline(device, pipeline, nullptr);
-            pipeline = VK_NULL_HANDLE;
+        for (auto &pipeline : pipelines) {
+            if (pipeline != VK_NULL_HANDLE) {
+                vkDestroyPipeline(device, pipeline, nullptr);
+                pipeline = VK_NULL_HANDLE;
+            }
         }
         if (pipelineLayout != VK_NULL_HANDLE) {
             vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
@@ -308,21 +398,17 @@ namespace Prism::Systems {
 
     };
 
-    void MeshDrawingSystem::Update(float deltaTime, VkCommandBuffer commandBuffer, Resources::Scene &scene) {
-        VkCommandBufferBeginInfo beginInfo{};
-        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-        vkBeginCommandBuffer(commandBuffer, &beginInfo);
-        vkEndCommandBuffer(commandBuffer);
+    bool MeshDrawingSystem::Update(float deltaTime, VkCommandBuffer commandBuffer, Resources::Scene &scene) {
+        PRISM_PROFILE_SCOPE("MeshDrawingSystem::Update");
+
+        return false;
     };
 
     void MeshDrawingSystem::Render(float deltaTime, VkCommandBuffer commandBuffer, Resources::Scene &scene, Resources::RenderTargetResource &renderTarget) {
-        VkCommandBufferBeginInfo beginInfo{};
-        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-        vkBeginCommandBuffer(commandBuffer, &beginInfo);
+        PRISM_PROFILE_SCOPE("MeshDrawingSystem::Render");
 
-        auto &registry = scene.GetRegistry();
+        auto &gpuProfiler = m_contextResources.GetGpuProfilerResource();
+        auto gpuZone = gpuProfiler.BeginZone(commandBuffer, "MeshDrawingSystem");
 
         auto &resourceStorage = m_contextResources.GetResourceStorage();
         auto &vulkanResource = m_contextResources.GetVulkanResource();
@@ -330,16 +416,18 @@ namespace Prism::Systems {
         VkRenderingAttachmentInfo colorAttachment{};
         colorAttachment.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
         colorAttachment.imageView = renderTarget.GetColorImageView();
-        colorAttachment.imageLayout = VK_IMAGE_LAYOUT_ATTACHMENT_OPTIMAL;
+        colorAttachment.imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
         colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
         colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
 
         VkRenderingAttachmentInfo depthAttachment{};
         depthAttachment.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
         depthAttachment.imageView = renderTarget.GetDepthImageView();
-        depthAttachment.imageLayout = VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL;
-        depthAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
-        depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+        depthAttachment.imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+        // Only use of depth in the frame, transient attachment is cleared here and never written back - so it can stay in tile memory.
+        depthAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        depthAttachment.clearValue.depthStencil = {1.0f, 0};
 
         auto currentSwapchainExtent = vulkanResource.GetSwapchainExtent();
 
@@ -354,17 +442,29 @@ namespace Prism::Systems {
 
         auto currentFrame = vulkanResource.GetCurrentFrameOffset();
 
-        auto commonUniformBufferOpt =
-            resourceStorage.Get<Resources::VkBufferResource<Resources::CommonResource>>(Resources::CommonResource::UNIFORM_BUFFER_ID, currentFrame);
-        if (!commonUniformBufferOpt) {
-            // this needs a fix
-            // throw std::runtime_error("Couldn't get common uniform buffer!");
-            vkEndCommandBuffer(commandBuffer);
+        // Nothing can be drawn without a camera.
+        auto commonUniformOpt = resourceStorage.Get<Resources::CommonUniformResource>(Resources::CommonUniformResource::COMMON_UNIFORM_ID);
+        if (!commonUniformOpt || !commonUniformOpt->get().offset) {
+            gpuProfiler.EndZone(commandBuffer, gpuZone);
             return;
         }
-        auto &commonUniformBuffer = commonUniformBufferOpt->get();
+        const uint32_t commonUniformOffset = *commonUniformOpt->get().offset;
 
-        updateDescriptorSet(vulkanResource.GetDevice(), descriptorSets[currentFrame], commonUniformBuffer.GetBuffer());
+        // Draw list of this frame was just filled by MeshCullingSystem.
+        auto drawListOpt = resourceStorage.Get<Resources::MeshDrawListResource>(Resources::MeshDrawListResource::DRAW_LIST_ID, currentFrame);
+        if (!drawListOpt || drawListOpt->get().maxDrawCount == 0) {
+            gpuProfiler.EndZone(commandBuffer, gpuZone);
+            return;
+        }
+        auto &drawList = drawListOpt->get();
+
+        // Instance buffer of a draw list is only reallocated when it has to grow, so its descriptor is rarely rewritten. Ranges of one arena
+        // block share the VkBuffer, so the offset is compared too.
+        const auto instanceBuffer = drawList.instanceBuffer.GetRange();
+        if (boundInstanceBuffers[currentFrame] != instanceBuffer) {
+            writeInstanceDescriptor(vulkanResource.GetDevice(), descriptorSets[currentFrame], instanceBuffer);
+            boundInstanceBuffers[currentFrame] = instanceBuffer;
+        }
 
         vkCmdBeginRendering(commandBuffer, &renderingInfo);
 
@@ -382,35 +482,50 @@ namespace Prism::Systems {
         scissor.extent = {currentSwapchainExtent.width, currentSwapchainExtent.height};
         vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
 
-        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
-        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &descriptorSets[currentFrame], 0, nullptr);
+        // Pipelines of all vertex formats share the layout, so descriptors stay bound across them.
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &descriptorSets[currentFrame], 1,
+                                &commonUniformOffset);
 
-        auto meshTransformView = registry.view<Components::Mesh, Components::Transform>();
+        // All meshes live in the geometry pool, so buffers are bound once for the whole scene. Vertex offsets of draws
+        // are in the stride of their format, so the same binding serves every pipeline.
+        auto &geometryPool = m_contextResources.GetGeometryPoolResource();
 
-        for (const auto &meshEntity : meshTransformView) {
+        VkBuffer vertexBuffers[] = {geometryPool.GetVertexBuffer().GetBuffer()};
+        VkDeviceSize offsets[] = {0};
+        vkCmdBindVertexBuffers(commandBuffer, 0, 1, vertexBuffers, offsets);
+        vkCmdBindIndexBuffer(commandBuffer, geometryPool.GetIndexBuffer().GetBuffer(), 0, VK_INDEX_TYPE_UINT32);
 
-            const auto &meshResourceId = meshTransformView.get<Components::Mesh>(meshEntity).resourceId;
-
-            const auto &transform = meshTransformView.get<Components::Transform>(meshEntity).transform;
-
-            auto meshOpt = scene.GetMesh(meshResourceId);
-            if (!meshOpt) {
+        for (uint32_t format = 0; format < Resources::MeshResource::VERTEX_FORMAT_COUNT; format++) {
+            const auto &drawRange = drawList.formatDrawRanges[format];
+            if (drawRange.maxDrawCount == 0) {
                 continue;
             }
-            auto &mesh = meshOpt->get();
-
-            VkBuffer vertexBuffers[] = {mesh.GetVertexBuffer().GetBuffer()};
-            VkDeviceSize offsets[] = {0};
-            vkCmdBindVertexBuffers(commandBuffer, 0, 1, vertexBuffers, offsets);
-            vkCmdBindIndexBuffer(commandBuffer, mesh.GetIndexBuffer().GetBuffer(), 0, VK_INDEX_TYPE_UINT32);
 
-            vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(glm::mat4), glm::value_ptr(transform));
-
-            vkCmdDrawIndexed(commandBuffer, mesh.GetIndexBuffer().GetElementCount(), 1, 0, 0, 0);
+            vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelines[format]);
+
+            const VkDeviceSize drawOffset =
+                drawList.drawCommandBuffer.GetOffset() + static_cast<VkDeviceSize>(drawRange.firstDraw) * sizeof(VkDrawIndexedIndirectCommand);
+
+            if (drawList.gpuCulled) {
+                // Number of draws left after culling is only known to the GPU.
+                vkCmdDrawIndexedIndirectCount(commandBuffer, drawList.drawCommandBuffer.GetBuffer(), drawOffset, drawList.statisticsBuffer.GetBuffer(),
+                                              drawList.statisticsBuffer.GetOffset() +
+                                                  offsetof(Resources::MeshDrawListResource::Statistics, drawCounts) + format * sizeof(uint32_t),
+                                              drawRange.maxDrawCount, sizeof(VkDrawIndexedIndirectCommand));
+            } else if (multiDrawIndirectSupported) {
+                vkCmdDrawIndexedIndirect(commandBuffer, drawList.drawCommandBuffer.GetBuffer(), drawOffset, drawRange.maxDrawCount,
+                                         sizeof(VkDrawIndexedIndirectCommand));
+            } else {
+                for (uint32_t i = drawRange.firstDraw; i < drawRange.firstDraw + drawRange.maxDrawCount; i++) {
+                    const auto &drawCommand = drawList.drawCommands[i];
+                    vkCmdDrawIndexed(commandBuffer, drawCommand.indexCount, drawCommand.instanceCount, drawCommand.firstIndex, drawCommand.vertexOffset,
+                                     drawCommand.firstInstance);
+                }
+            }
         }
 
         vkCmdEndRendering(commandBuffer);
 
-        vkEndCommandBuffer(commandBuffer);
+        gpuProfiler.EndZone(commandBuffer, gpuZone);
     }
 } // namespace Prism::Systems
\ No newline at end of file
@@ -5,10 +5,13 @@
 
 #include <glm/glm.hpp>
 
+#include "resources/common_resource.hpp"
 #include "resources/context_resources.hpp"
 #include "resources/scene.hpp"
 
 namespace Prism::Systems {
+    // Writes camera uniforms of every frame into UniformRingResource, MeshCullingSystem & MeshDrawingSystem bind them with
+    // the offset published in CommonUniformResource.
     class CommonUniformUpdateSystem {
       public:
         CommonUniformUpdateSystem(Resources::ContextResources &contextResources);
@@ -27,5 +30,6 @@ namespace Prism::Systems {
 
       private:
         Resources::ContextResources &m_contextResources;
+        Resources::ResourceHandle<Resources::CommonUniformResource> m_commonUniformHandle;
     };
 }; // namespace Prism::Systems
\ No newline at end of file
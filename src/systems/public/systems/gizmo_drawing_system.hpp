@@ -4,6 +4,8 @@
 #include "resources/render_target_resource.hpp"
 #include "resources/scene.hpp"
 
+#include "components/camera.hpp"
+
 #include "events/move_events.hpp"
 
 namespace Prism::Systems {
@@ -20,11 +22,14 @@ namespace Prism::Systems {
 
         void Initialize();
 
-        void Update(float deltaTime, VkCommandBuffer commandBuffer, Resources::Scene &scene);
+        bool Update(float deltaTime, VkCommandBuffer commandBuffer, Resources::Scene &scene);
 
-        void Render(float deltaTime, VkCommandBuffer commandBuffer, Resources::Scene &scene, Resources::RenderTargetResource &renderTarget);
+        bool Render(float deltaTime, VkCommandBuffer commandBuffer, Resources::Scene &scene, Resources::RenderTargetResource &renderTarget);
 
       private:
+        // Selects mesh entity under the cursor on left click.
+        void pickSelectedNode(Resources::Scene &scene, const Components::Camera &camera);
+
         void onKeyPressed(const Events::KeyPressEvent &event);
 
         Resources::ContextResources &m_contextResources;
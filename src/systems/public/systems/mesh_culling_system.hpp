@@ -0,0 +1,105 @@
+#pragma once
+
+#include "resources/context_resources.hpp"
+#include "resources/mesh_culling_statistics_resource.hpp"
+#include "resources/mesh_draw_list_resource.hpp"
+#include "resources/render_target_resource.hpp"
+#include "resources/scene.hpp"
+
+#include "utils/frustum_culling.hpp"
+#include "utils/normal_matrix.hpp"
+
+#include <array>
+#include <optional>
+
+namespace Prism::Systems {
+    // Builds draw list of visible submesh instances for MeshDrawingSystem, LOD of every instance is picked from its projected size.
+    // Culling runs in a compute pass that compacts visible instances & draws on the GPU, devices without indirect count support
+    // cull bounding boxes with SIMD on the CPU instead.
+    class MeshCullingSystem {
+      public:
+        MeshCullingSystem(Resources::ContextResources &contextResources);
+        ~MeshCullingSystem();
+
+        MeshCullingSystem(MeshCullingSystem &other) = delete;
+        MeshCullingSystem &operator=(MeshCullingSystem &other) = delete;
+
+        MeshCullingSystem(MeshCullingSystem &&other) = delete;
+        MeshCullingSystem &operator=(MeshCullingSystem &&other) = delete;
+
+        void Initialize();
+
+        // Fills the draw list of the frame - on the CPU, or with culling inputs & buffers of the GPU passes. Records nothing.
+        bool Update(float deltaTime, VkCommandBuffer commandBuffer, Resources::Scene &scene);
+
+        // Returns whether culling was recorded for the GPU, otherwise the draw list was written on the CPU. Buffers it writes are
+        // synchronized with their readers by the render graph pass that runs it.
+        bool Render(float deltaTime, VkCommandBuffer commandBuffer, Resources::Scene &scene, Resources::RenderTargetResource &renderTarget);
+
+        // Of the current frame in flight, valid once Update ran.
+        Resources::MeshDrawListResource &GetDrawList();
+
+        // Bindings 1 to 5 of the culling passes, see createDescriptorSetLayout.
+        static constexpr uint32_t STORAGE_BUFFER_BINDING_COUNT = 5;
+        using StorageBuffers = std::array<Resources::BufferRange, STORAGE_BUFFER_BINDING_COUNT>;
+
+      private:
+        Resources::ContextResources &m_contextResources;
+
+        bool gpuCullingSupported = false;
+
+        std::array<Resources::ResourceHandle<Resources::MeshDrawListResource>, Resources::VulkanResource::MAX_FRAMES_IN_FLIGHT> drawListHandles = {};
+        Resources::ResourceHandle<Resources::MeshCullingStatisticsResource> statisticsHandle = {};
+
+        VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+        VkDescriptorSetLayout descriptorSetLayout = VK_NULL_HANDLE;
+        std::vector<VkDescriptorSet> descriptorSets = {};
+        // Draw list buffers every descriptor set currently points at.
+        std::vector<StorageBuffers> boundStorageBuffers = {};
+        VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+        VkPipeline cullingPipeline = VK_NULL_HANDLE;
+        VkPipeline compactionPipeline = VK_NULL_HANDLE;
+
+        struct DrawInstance {
+            Resources::MeshResource::VertexFormat vertexFormat;
+            Resources::MeshResource::ID meshId;
+            uint32_t submesh;
+            uint32_t lod;
+            entt::entity entity;
+        };
+
+        // Camera parameters needed to project simplification errors of LODs to pixels.
+        struct LodProjection {
+            glm::vec3 cameraPosition;
+            // Pixels covered by a unit long segment one unit in front of the camera.
+            float pixelsPerUnit;
+        };
+
+        // Reused between frames to avoid allocations.
+        std::vector<DrawInstance> drawInstances = {};
+        std::vector<Resources::MeshDrawListResource::CullInstance> cullInstances = {};
+        std::vector<Resources::MeshInstanceResource> instanceModels = {};
+        std::vector<glm::mat4> instanceTransforms = {};
+        std::vector<Utils::NormalMatrices::NormalMatrix> instanceNormalMatrices = {};
+        std::vector<VkDrawIndexedIndirectCommand> drawGroups = {};
+        std::vector<Resources::MeshResource::BoundingBox> drawGroupBounds = {};
+        std::array<Resources::MeshDrawListResource::DrawRange, Resources::MeshResource::VERTEX_FORMAT_COUNT> drawGroupRanges = {};
+        std::vector<VkDrawIndexedIndirectCommand> visibleDraws = {};
+        Utils::Culling::BoxBatch boxBatch = {};
+        std::vector<uint8_t> visibility = {};
+
+        Resources::MeshCullingStatisticsResource &getStatistics();
+
+        void buildDrawGroups(Resources::Scene &scene, const std::optional<LodProjection> &lodProjection);
+
+        std::optional<Utils::Culling::Frustum> getCameraFrustum(Resources::Scene &scene);
+
+        std::optional<LodProjection> getLodProjection(Resources::Scene &scene);
+
+        void prepareGpuCulling(Resources::MeshDrawListResource &drawList, size_t frame);
+
+        void recordGpuCulling(VkCommandBuffer commandBuffer, Resources::MeshDrawListResource &drawList, uint32_t commonUniformOffset, size_t frame);
+
+        void writeCpuDrawList(Resources::MeshDrawListResource &drawList, const std::optional<Utils::Culling::Frustum> &frustum);
+    };
+}; // namespace Prism::Systems
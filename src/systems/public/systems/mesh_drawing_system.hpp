@@ -4,10 +4,14 @@
 #include "resources/render_target_resource.hpp"
 #include "resources/scene.hpp"
 
+#include <array>
+#include <vector>
+
 namespace Prism::Systems {
     class MeshDrawingSystem {
       public:
-        MeshDrawingSystem(Resources::ContextResources &contextResources);
+        // Per vertex normal matrix makes basic.vert invert the model matrix for every vertex again, to benchmark the precomputed one against.
+        MeshDrawingSystem(Resources::ContextResources &contextResources, bool perVertexNormalMatrix = false);
         ~MeshDrawingSystem();
 
         MeshDrawingSystem(MeshDrawingSystem &other) = delete;
@@ -18,8 +22,9 @@ namespace Prism::Systems {
 
         void Initialize();
 
-        void Update(float deltaTime, VkCommandBuffer commandBuffer, Resources::Scene &scene);
+        bool Update(float deltaTime, VkCommandBuffer commandBuffer, Resources::Scene &scene);
 
+        // Recorded as a render graph pass, after the clear it loads attachments from.
         void Render(float deltaTime, VkCommandBuffer commandBuffer, Resources::Scene &scene, Resources::RenderTargetResource &renderTarget);
 
       private:
@@ -28,7 +33,13 @@ namespace Prism::Systems {
         VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
         VkDescriptorSetLayout descriptorSetLayout = VK_NULL_HANDLE;
         std::vector<VkDescriptorSet> descriptorSets = {};
+        // Instance buffer every descriptor set currently points at.
+        std::vector<Resources::BufferRange> boundInstanceBuffers = {};
         VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
-        VkPipeline pipeline = VK_NULL_HANDLE;
+        // One per MeshResource::VertexFormat.
+        std::array<VkPipeline, Resources::MeshResource::VERTEX_FORMAT_COUNT> pipelines = {};
+
+        // Draw lists built on the CPU are drawn with a single vkCmdDrawIndexedIndirect when supported, otherwise draws are issued one by one.
+        bool multiDrawIndirectSupported = false;
     };
 }; // namespace Prism::Systems
\ No newline at end of file
@@ -21,8 +21,9 @@ namespace Prism::Systems {
 
         void Initialize();
 
-        void Update(float deltaTime, VkCommandBuffer commandBuffer, Resources::Scene &scene);
+        bool Update(float deltaTime, VkCommandBuffer commandBuffer, Resources::Scene &scene);
 
+        // Copies the render target into the acquired swapchain image, the render graph transitions both around it.
         void Render(float deltaTime, VkCommandBuffer commandBuffer, Resources::Scene &scene, Resources::RenderTargetResource &renderTarget);
 
       private:
@@ -18,8 +18,9 @@ namespace Prism::Systems {
 
         void Initialize();
 
-        void Update(float deltaTime, VkCommandBuffer commandBuffer, Resources::Scene &scene);
+        bool Update(float deltaTime, VkCommandBuffer commandBuffer, Resources::Scene &scene);
 
+        // Recorded as a render graph pass, which moves both attachments to their attachment layouts beforehand.
         void Render(float deltaTime, VkCommandBuffer commandBuffer, Resources::Scene &scene, Resources::RenderTargetResource &renderTarget);
 
       private:
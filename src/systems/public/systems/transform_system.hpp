@@ -0,0 +1,64 @@
+#pragma once
+
+#include "resources/context_resources.hpp"
+#include "resources/scene.hpp"
+
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+
+#include <limits>
+#include <vector>
+
+namespace Prism::Systems {
+    // Propagates Components::Transform down Components::Node hierarchies into Components::WorldTransform. Only subtrees below
+    // patched transforms are recomputed. Entities are kept in breadth first order in contiguous arrays, so every level depends
+    // only on the one above it and could be split across threads.
+    class TransformSystem {
+      public:
+        TransformSystem(Resources::ContextResources &contextResources);
+        ~TransformSystem() = default;
+
+        TransformSystem(TransformSystem &other) = delete;
+        TransformSystem &operator=(TransformSystem &other) = delete;
+
+        // Signals are connected to this instance.
+        TransformSystem(TransformSystem &&other) = delete;
+        TransformSystem &operator=(TransformSystem &&other) = delete;
+
+        void Initialize();
+
+        void Update(float deltaTime, Resources::Scene &scene);
+
+      private:
+        static constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+
+        Resources::ContextResources &m_contextResources;
+
+        entt::registry *m_registry = nullptr;
+        std::vector<entt::scoped_connection> m_connections;
+
+        // Patched since the last update.
+        entt::sparse_set m_dirtyEntities;
+        // Set when entities or their parents change, order is rebuilt from scratch then.
+        bool m_rebuildRequired = true;
+
+        // Breadth first order, level i spans [m_levelOffsets[i], m_levelOffsets[i + 1]).
+        std::vector<entt::entity> m_entities;
+        std::vector<uint32_t> m_levelOffsets;
+        // Index of the parent in m_entities, INVALID_INDEX for roots.
+        std::vector<uint32_t> m_parents;
+        std::vector<glm::mat4> m_worldTransforms;
+        std::vector<uint8_t> m_dirty;
+
+        // Position in m_entities, indexed by entity without its version.
+        std::vector<uint32_t> m_entityIndices;
+
+        void connect(entt::registry &registry);
+
+        void rebuild(entt::registry &registry);
+
+        void onTransformChanged(entt::registry &registry, entt::entity entity);
+
+        void onHierarchyChanged(entt::registry &registry, entt::entity entity);
+    };
+}; // namespace Prism::Systems
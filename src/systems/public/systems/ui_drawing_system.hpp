@@ -5,6 +5,7 @@
 #include "resources/scene.hpp"
 
 #include "ui/camera_settings_ui.hpp"
+#include "ui/gpu_stats_ui.hpp"
 #include "ui/main_dock_ui.hpp"
 #include "ui/menu_bar_ui.hpp"
 #include "ui/scene_hierarchy_ui.hpp"
@@ -23,8 +24,9 @@ namespace Prism::Systems {
 
         void Initialize();
 
-        void Update(float deltaTime, VkCommandBuffer commandBuffer, Resources::Scene &scene);
+        bool Update(float deltaTime, VkCommandBuffer commandBuffer, Resources::Scene &scene);
 
+        // Recorded as a render graph pass on top of the color attachment.
         void Render(float deltaTime, VkCommandBuffer commandBuffer, Resources::Scene &scene, Resources::RenderTargetResource &renderTarget);
 
       private:
@@ -36,5 +38,6 @@ namespace Prism::Systems {
         UI::MenuBarUI m_menuBarUI;
         UI::SceneHierarchyUI m_sceneHierarchyUI;
         UI::CameraSettingsUI m_cameraSettingsUI;
+        UI::GpuStatsUI m_gpuStatsUI;
     };
 } // namespace Prism::Systems
\ No newline at end of file
@@ -0,0 +1,176 @@
+#include "systems/transform_system.hpp"
+
+#include "utils/profiler.hpp"
+
+#include "components/node.hpp"
+#include "components/transform.hpp"
+
+#include <algorithm>
+
+namespace Prism::Systems {
+    namespace {
+        constexpr uint32_t UNKNOWN_DEPTH = std::numeric_limits<uint32_t>::max();
+
+        size_t getEntityIndex(entt::entity entity) { return static_cast<size_t>(entt::to_entity(entity)); }
+
+        // Parent whose transform the entity is relative to, null for roots. Dangling parents make their children roots.
+        entt::entity getParent(entt::registry &registry, entt::entity entity) {
+            const auto *node = registry.try_get<Components::Node>(entity);
+            if (node == nullptr || !registry.valid(node->parent) || !registry.all_of<Components::Transform>(node->parent)) {
+                return entt::null;
+            }
+            return node->parent;
+        }
+    } // namespace
+
+    TransformSystem::TransformSystem(Resources::ContextResources &contextResources) : m_contextResources(contextResources) {};
+
+    void TransformSystem::Initialize() {
+
+    };
+
+    void TransformSystem::Update(float deltaTime, Resources::Scene &scene) {
+        PRISM_PROFILE_SCOPE("TransformSystem::Update");
+
+        auto &registry = scene.GetRegistry();
+        if (m_registry != &registry) {
+            connect(registry);
+        }
+
+        if (m_rebuildRequired) {
+            rebuild(registry);
+        } else {
+            for (auto entity : m_dirtyEntities) {
+                const auto entityIndex = getEntityIndex(entity);
+                if (entityIndex < m_entityIndices.size() && m_entityIndices[entityIndex] != INVALID_INDEX) {
+                    m_dirty[m_entityIndices[entityIndex]] = 1;
+                }
+            }
+        }
+        m_dirtyEntities.clear();
+
+        // Parents are always on an earlier level, so a single pass carries dirtiness down whole subtrees.
+        for (size_t level = 0; level + 1 < m_levelOffsets.size(); level++) {
+            for (uint32_t i = m_levelOffsets[level]; i < m_levelOffsets[level + 1]; i++) {
+                const auto parent = m_parents[i];
+                if (parent != INVALID_INDEX) {
+                    m_dirty[i] |= m_dirty[parent];
+                }
+
+                if (m_dirty[i] == 0) {
+                    continue;
+                }
+
+                const auto &transform = registry.get<Components::Transform>(m_entities[i]).transform;
+                m_worldTransforms[i] = parent != INVALID_INDEX ? m_worldTransforms[parent] * transform : transform;
+            }
+        }
+
+        // Replacing signals the spatial index, which refits only what moved.
+        for (uint32_t i = 0; i < m_entities.size(); i++) {
+            if (m_dirty[i] != 0) {
+                registry.emplace_or_replace<Components::WorldTransform>(m_entities[i], m_worldTransforms[i]);
+                m_dirty[i] = 0;
+            }
+        }
+    };
+
+    void TransformSystem::connect(entt::registry &registry) {
+        m_connections.clear();
+        m_connections.reserve(6);
+        m_connections.emplace_back(registry.on_update<Components::Transform>().connect<&TransformSystem::onTransformChanged>(*this));
+        m_connections.emplace_back(registry.on_construct<Components::Transform>().connect<&TransformSystem::onHierarchyChanged>(*this));
+        m_connections.emplace_back(registry.on_destroy<Components::Transform>().connect<&TransformSystem::onHierarchyChanged>(*this));
+        m_connections.emplace_back(registry.on_construct<Components::Node>().connect<&TransformSystem::onHierarchyChanged>(*this));
+        m_connections.emplace_back(registry.on_update<Components::Node>().connect<&TransformSystem::onHierarchyChanged>(*this));
+        m_connections.emplace_back(registry.on_destroy<Components::Node>().connect<&TransformSystem::onHierarchyChanged>(*this));
+
+        m_registry = &registry;
+        m_dirtyEntities.clear();
+        m_rebuildRequired = true;
+    }
+
+    void TransformSystem::rebuild(entt::registry &registry) {
+        PRISM_PROFILE_SCOPE("TransformSystem::Rebuild");
+
+        auto transformView = registry.view<Components::Transform>();
+
+        // Depth of every entity, computed by walking up to the first entity with a known depth.
+        std::vector<uint32_t> depths;
+        std::vector<entt::entity> path;
+        uint32_t levelCount = 0;
+
+        for (auto entity : transformView) {
+            path.clear();
+
+            auto current = entity;
+            uint32_t depth = 0;
+            while (true) {
+                const auto currentIndex = getEntityIndex(current);
+                if (currentIndex >= depths.size()) {
+                    depths.resize(currentIndex + 1, UNKNOWN_DEPTH);
+                }
+                if (depths[currentIndex] != UNKNOWN_DEPTH) {
+                    depth = depths[currentIndex] + 1;
+                    break;
+                }
+
+                path.push_back(current);
+
+                auto parent = getParent(registry, current);
+                // Parent cycles are broken by treating the entity closing the cycle as a root.
+                if (parent == entt::null || std::find(path.begin(), path.end(), parent) != path.end()) {
+                    depth = 0;
+                    break;
+                }
+
+                current = parent;
+            }
+
+            // Path goes from the entity up, its last element gets the depth found above.
+            for (auto it = path.rbegin(); it != path.rend(); ++it) {
+                depths[getEntityIndex(*it)] = depth++;
+            }
+            levelCount = std::max(levelCount, depth);
+        }
+
+        // Counting sort by depth.
+        m_levelOffsets.assign(levelCount + 1, 0);
+        for (auto entity : transformView) {
+            m_levelOffsets[depths[getEntityIndex(entity)] + 1]++;
+        }
+        for (uint32_t level = 0; level < levelCount; level++) {
+            m_levelOffsets[level + 1] += m_levelOffsets[level];
+        }
+
+        m_entities.resize(transformView.size());
+        m_entityIndices.assign(depths.size(), INVALID_INDEX);
+
+        std::vector<uint32_t> cursors(m_levelOffsets.begin(), m_levelOffsets.end() - 1);
+        for (auto entity : transformView) {
+            const auto index = cursors[depths[getEntityIndex(entity)]]++;
+            m_entities[index] = entity;
+            m_entityIndices[getEntityIndex(entity)] = index;
+        }
+
+        m_parents.resize(m_entities.size());
+        for (uint32_t i = 0; i < m_entities.size(); i++) {
+            auto parent = getParent(registry, m_entities[i]);
+            // Roots closing a parent cycle are on level 0 too.
+            m_parents[i] = parent != entt::null && i >= m_levelOffsets[1] ? m_entityIndices[getEntityIndex(parent)] : INVALID_INDEX;
+        }
+
+        m_worldTransforms.resize(m_entities.size());
+        m_dirty.assign(m_entities.size(), 1);
+
+        m_rebuildRequired = false;
+    }
+
+    void TransformSystem::onTransformChanged(entt::registry &registry, entt::entity entity) {
+        if (!m_dirtyEntities.contains(entity)) {
+            m_dirtyEntities.push(entity);
+        }
+    }
+
+    void TransformSystem::onHierarchyChanged(entt::registry &registry, entt::entity entity) { m_rebuildRequired = true; }
+} // namespace Prism::Systems
@@ -1,5 +1,7 @@
 #include "systems/ui_drawing_system.hpp"
 
+#include "utils/profiler.hpp"
+
 #include "events/move_events.hpp"
 
 #include <imgui.h>
@@ -16,18 +18,23 @@ namespace Prism::Systems {
 
     UIDrawingSystem::UIDrawingSystem(Resources::ContextResources &contextResources)
         : m_contextResources(contextResources), m_mainDockUI{contextResources}, m_menuBarUI{contextResources}, m_sceneHierarchyUI{contextResources},
-          m_cameraSettingsUI{contextResources} {}
+          m_cameraSettingsUI{contextResources}, m_gpuStatsUI{contextResources} {}
 
     void UIDrawingSystem::Initialize() {}
 
-    void UIDrawingSystem::Update(float deltaTime, VkCommandBuffer commandBuffer, Resources::Scene &scene) {
-        VkCommandBufferBeginInfo beginInfo{};
-        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-        vkBeginCommandBuffer(commandBuffer, &beginInfo);
+    bool UIDrawingSystem::Update(float deltaTime, VkCommandBuffer commandBuffer, Resources::Scene &scene) {
+        PRISM_PROFILE_SCOPE("UIDrawingSystem::Update");
 
         ImGui_ImplVulkan_NewFrame();
-        ImGui_ImplGlfw_NewFrame();
+        if (m_contextResources.GetImGuiResource().HasPlatformBackend()) {
+            ImGui_ImplGlfw_NewFrame();
+        } else {
+            auto extent = m_contextResources.GetVulkanResource().GetSwapchainExtent();
+
+            ImGuiIO &io = ImGui::GetIO();
+            io.DisplaySize = ImVec2(static_cast<float>(extent.width), static_cast<float>(extent.height));
+            io.DeltaTime = deltaTime > 0.0f ? deltaTime : 1.0f / 60.0f;
+        }
         ImGui::NewFrame();
 
         if (ImGui::GetIO().WantCaptureMouse) {
@@ -38,24 +45,27 @@ namespace Prism::Systems {
         m_menuBarUI.Update(deltaTime, scene);
         m_sceneHierarchyUI.Update(deltaTime, scene);
         m_cameraSettingsUI.Update(deltaTime, scene);
+        m_gpuStatsUI.Update(deltaTime, scene);
 
-        vkEndCommandBuffer(commandBuffer);
+        // Widgets are only built here, draw data is recorded in Render.
+        return false;
     }
 
     void UIDrawingSystem::Render(float deltaTime, VkCommandBuffer commandBuffer, Resources::Scene &scene, Resources::RenderTargetResource &renderTarget) {
-        VkCommandBufferBeginInfo beginInfo{};
-        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-        vkBeginCommandBuffer(commandBuffer, &beginInfo);
+        PRISM_PROFILE_SCOPE("UIDrawingSystem::Render");
 
-        // Get frame buffer
+        auto &gpuProfiler = m_contextResources.GetGpuProfilerResource();
+        auto gpuZone = gpuProfiler.BeginZone(commandBuffer, "UIDrawingSystem");
+
+        // Get frame buffer. Render targets are pooled per frame in flight & only reallocated when the swapchain grows, whose
+        // recreation clears swapchain bound storage - framebuffers there never outlive the views they were created from.
         auto &vulkanResource = m_contextResources.GetVulkanResource();
         auto &swapchainBoundStorage = vulkanResource.GetSwapchainBoundStorage();
-        auto currentImageIndex = vulkanResource.GetCurrentImageIndex();
+        auto currentFrameOffset = static_cast<size_t>(vulkanResource.GetCurrentFrameOffset());
 
         auto renderPass = m_contextResources.GetImGuiResource().GetRenderPass();
 
-        auto framebufferOpt = swapchainBoundStorage.Get<Resources::VkFramebufferResource>(FRAMEBUFFER_RESOURCE_ID, currentImageIndex);
+        auto framebufferOpt = swapchainBoundStorage.Get<Resources::VkFramebufferResource>(FRAMEBUFFER_RESOURCE_ID, currentFrameOffset);
         if (!framebufferOpt) {
             VkDevice device = vulkanResource.GetDevice();
             VkExtent2D extent = vulkanResource.GetSwapchainExtent();
@@ -78,10 +88,8 @@ namespace Prism::Systems {
 
             auto framebufferResource = std::make_unique<Resources::VkFramebufferResource>(device, framebuffer);
 
-            // Insert into ResourceStorage at frame index i
-            swapchainBoundStorage.Insert<Resources::VkFramebufferResource>(FRAMEBUFFER_RESOURCE_ID, std::move(framebufferResource),
-                                                                           static_cast<size_t>(currentImageIndex));
-            framebufferOpt = swapchainBoundStorage.Get<Resources::VkFramebufferResource>(FRAMEBUFFER_RESOURCE_ID, currentImageIndex);
+            swapchainBoundStorage.Insert<Resources::VkFramebufferResource>(FRAMEBUFFER_RESOURCE_ID, std::move(framebufferResource), currentFrameOffset);
+            framebufferOpt = swapchainBoundStorage.Get<Resources::VkFramebufferResource>(FRAMEBUFFER_RESOURCE_ID, currentFrameOffset);
         }
         Resources::VkFramebufferResource &framebuffer = framebufferOpt->get();
 
@@ -99,11 +107,13 @@ namespace Prism::Systems {
         ImGui::Render();
         ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), commandBuffer);
 
-        ImGui::UpdatePlatformWindows();
-        ImGui::RenderPlatformWindowsDefault(nullptr);
+        if (ImGui::GetIO().ConfigFlags & ImGuiConfigFlags_ViewportsEnable) {
+            ImGui::UpdatePlatformWindows();
+            ImGui::RenderPlatformWindowsDefault(nullptr);
+        }
 
         vkCmdEndRenderPass(commandBuffer);
 
-        vkEndCommandBuffer(commandBuffer);
+        gpuProfiler.EndZone(commandBuffer, gpuZone);
     }
 } // namespace Prism::Systems
\ No newline at end of file
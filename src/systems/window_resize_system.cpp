@@ -1,5 +1,7 @@
 #include "systems/window_resize_system.hpp"
 
+#include "utils/profiler.hpp"
+
 namespace Prism::Systems {
     namespace {} // namespace
 
@@ -11,6 +13,8 @@ namespace Prism::Systems {
     void WindowResizeSystem::Initialize() {};
 
     void WindowResizeSystem::Update(float deltaTime) {
+        PRISM_PROFILE_SCOPE("WindowResizeSystem::Update");
+
         if (newWindowExtentOpt != std::nullopt) {
             auto &vulkanResource = m_contextResources.GetVulkanResource();
             auto &newWindowExtent = *newWindowExtentOpt;
@@ -2,6 +2,7 @@
 #include <imgui_internal.h>
 
 #include "ui/camera_settings_ui.hpp"
+#include "utils/profiler.hpp"
 
 #include "components/fps_camera_control.hpp"
 #include "components/tags.hpp"
@@ -10,6 +11,8 @@ namespace Prism::UI {
     CameraSettingsUI::CameraSettingsUI(Resources::ContextResources &contextResources) : m_contextResources(contextResources) {};
 
     void CameraSettingsUI::Update(float deltaTime, Resources::Scene &scene) {
+        PRISM_PROFILE_SCOPE("CameraSettingsUI::Update");
+
         ImGui::Begin("Camera settings");
 
         auto &registry = scene.GetRegistry();
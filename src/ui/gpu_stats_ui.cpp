@@ -0,0 +1,83 @@
+#include <imgui.h>
+#include <imgui_internal.h>
+
+#include "ui/gpu_stats_ui.hpp"
+
+#include "resources/mesh_culling_statistics_resource.hpp"
+#include "utils/profiler.hpp"
+
+namespace Prism::UI {
+    GpuStatsUI::GpuStatsUI(Resources::ContextResources &contextResources) : m_contextResources(contextResources) {};
+
+    void GpuStatsUI::Update(float deltaTime, Resources::Scene &scene) {
+        PRISM_PROFILE_SCOPE("GpuStatsUI::Update");
+
+        ImGui::Begin("GPU stats");
+
+        auto cullingStatisticsOpt = m_contextResources.GetResourceStorage().Get<Resources::MeshCullingStatisticsResource>(
+            Resources::MeshCullingStatisticsResource::STATISTICS_ID);
+        if (cullingStatisticsOpt) {
+            const auto &cullingStatistics = cullingStatisticsOpt->get();
+            ImGui::Text("Culling (%s): %u visible, %u culled, %u draws", cullingStatistics.gpuCulling ? "GPU" : "CPU",
+                        cullingStatistics.statistics.visibleInstanceCount, cullingStatistics.statistics.culledInstanceCount,
+                        cullingStatistics.statistics.GetDrawCount());
+        }
+
+        auto &gpuProfiler = m_contextResources.GetGpuProfilerResource();
+        if (!gpuProfiler.IsSupported()) {
+            ImGui::TextUnformatted("Timestamp queries are not supported on this device.");
+            ImGui::End();
+            return;
+        }
+
+        bool enabled = gpuProfiler.IsEnabled();
+        if (ImGui::Checkbox("Enabled", &enabled)) {
+            gpuProfiler.SetEnabled(enabled);
+        }
+
+        if (gpuProfiler.IsPipelineStatisticsSupported()) {
+            bool pipelineStatisticsEnabled = gpuProfiler.IsPipelineStatisticsEnabled();
+            if (ImGui::Checkbox("Pipeline statistics", &pipelineStatisticsEnabled)) {
+                gpuProfiler.SetPipelineStatisticsEnabled(pipelineStatisticsEnabled);
+            }
+        }
+
+        ImGui::Text("GPU frame: %.3f ms", gpuProfiler.GetLastFrameGpuTimeMs());
+
+        const auto &results = gpuProfiler.GetLastResults();
+        const bool showPipelineStatistics = gpuProfiler.IsPipelineStatisticsEnabled();
+
+        if (ImGui::BeginTable("GpuZones", showPipelineStatistics ? 5 : 2, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+            ImGui::TableSetupColumn("System");
+            ImGui::TableSetupColumn("GPU ms");
+            if (showPipelineStatistics) {
+                ImGui::TableSetupColumn("Primitives");
+                ImGui::TableSetupColumn("VS invocations");
+                ImGui::TableSetupColumn("FS invocations");
+            }
+            ImGui::TableHeadersRow();
+
+            for (const auto &zone : results) {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(zone.name);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", zone.gpuTimeMs);
+
+                if (showPipelineStatistics) {
+                    const auto &statistics = zone.pipelineStatistics;
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%llu", static_cast<unsigned long long>(statistics.inputAssemblyPrimitives));
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%llu", static_cast<unsigned long long>(statistics.vertexShaderInvocations));
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%llu", static_cast<unsigned long long>(statistics.fragmentShaderInvocations));
+                }
+            }
+
+            ImGui::EndTable();
+        }
+
+        ImGui::End();
+    }
+} // namespace Prism::UI
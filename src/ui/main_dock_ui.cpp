@@ -2,12 +2,15 @@
 #include <imgui_internal.h>
 
 #include "ui/main_dock_ui.hpp"
+#include "utils/profiler.hpp"
 
 namespace Prism::UI {
     MainDockUI::MainDockUI(Resources::ContextResources &contextResources)
         : m_contextResources(contextResources) {};
 
     void MainDockUI::Update(float deltaTime, Resources::Scene &scene) {
+        PRISM_PROFILE_SCOPE("MainDockUI::Update");
+
         bool dockspaceOpen = true;
 
         ImGuiWindowFlags windowFlags = ImGuiWindowFlags_MenuBar |
@@ -2,12 +2,19 @@
 #include <imgui_internal.h>
 
 #include "ui/menu_bar_ui.hpp"
+#include "utils/profiler.hpp"
 
 namespace Prism::UI {
+    namespace {
+        constexpr const char *CPU_TRACE_FILE_NAME = "prism_cpu_trace.json";
+    } // namespace
+
     MenuBarUI::MenuBarUI(Resources::ContextResources &contextResources)
         : m_contextResources(contextResources) {}
 
     void MenuBarUI::Update(float deltaTime, Resources::Scene &scene) {
+        PRISM_PROFILE_SCOPE("MenuBarUI::Update");
+
         if (ImGui::BeginMainMenuBar()) {
             if (ImGui::BeginMenu("File")) {
                 if (ImGui::MenuItem("Load Model")) {
@@ -21,6 +28,20 @@ namespace Prism::UI {
                 ImGui::EndMenu();
             }
 
+#ifdef PRISM_PROFILER_ENABLED
+            if (ImGui::BeginMenu("Profiler")) {
+                if (!Utils::Profiler::IsCapturing()) {
+                    if (ImGui::MenuItem("Start CPU Capture")) {
+                        Utils::Profiler::BeginCapture();
+                    }
+                } else if (ImGui::MenuItem("Stop CPU Capture")) {
+                    Utils::Profiler::EndCapture();
+                    Utils::Profiler::WriteChromeTrace(CPU_TRACE_FILE_NAME);
+                }
+                ImGui::EndMenu();
+            }
+#endif
+
             ImGui::EndMainMenuBar();
         }
     }
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "resources/context_resources.hpp"
+#include "resources/scene.hpp"
+
+namespace Prism::UI {
+    class GpuStatsUI {
+      public:
+        GpuStatsUI(Resources::ContextResources &contextResources);
+        ~GpuStatsUI() = default;
+
+        GpuStatsUI(const GpuStatsUI &) = delete;
+        GpuStatsUI &operator=(const GpuStatsUI &) = delete;
+
+        GpuStatsUI(GpuStatsUI &&) = delete;
+        GpuStatsUI &operator=(GpuStatsUI &&) = delete;
+
+        void Update(float deltaTime, Resources::Scene &scene);
+
+      private:
+        Resources::ContextResources &m_contextResources;
+    };
+} // namespace Prism::UI
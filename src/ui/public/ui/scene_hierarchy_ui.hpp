@@ -3,6 +3,8 @@
 #include "resources/context_resources.hpp"
 #include "resources/scene.hpp"
 
+#include <vector>
+
 namespace Prism::UI {
     class SceneHierarchyUI {
       public:
@@ -19,5 +21,10 @@ namespace Prism::UI {
 
       private:
         Resources::ContextResources &m_contextResources;
+
+        bool m_onlyInView = false;
+
+        // Reused between frames to avoid allocations.
+        std::vector<entt::entity> m_visibleEntities;
     };
 } // namespace Prism::UI
\ No newline at end of file
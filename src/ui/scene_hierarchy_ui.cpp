@@ -1,12 +1,20 @@
 #include "ui/scene_hierarchy_ui.hpp"
+#include "utils/profiler.hpp"
 
 #include <imgui.h>
 #include <imgui_internal.h>
 
+#include "components/camera.hpp"
 #include "components/mesh.hpp"
+#include "components/node.hpp"
 #include "components/tags.hpp"
 #include "components/transform.hpp"
 
+#include "utils/frustum_culling.hpp"
+
+#include <unordered_map>
+#include <vector>
+
 namespace Prism::UI {
     namespace {
         void renderTransformComponent(entt::registry &registry,
@@ -34,9 +42,13 @@ namespace Prism::UI {
                             ImGui::TableSetColumnIndex(col);
                             std::string label = "##M_" + std::to_string(row) +
                                                 "_" + std::to_string(col);
-                            ImGui::InputFloat(label.c_str(),
-                                              &transform[row][col], 0.1f, 1.0f,
-                                              "%.3f");
+                            // Edited in place, patch lets TransformSystem
+                            // propagate the change to the subtree.
+                            if (ImGui::InputFloat(label.c_str(),
+                                                  &transform[row][col], 0.1f,
+                                                  1.0f, "%.3f")) {
+                                registry.patch<Components::Transform>(entity);
+                            }
                         }
                     }
 
@@ -46,23 +58,32 @@ namespace Prism::UI {
             }
         }
 
-        void renderMeshNode(entt::registry &registry,
-                            const entt::entity &meshNodeEntity) {
+        using ChildrenMap =
+            std::unordered_map<entt::entity, std::vector<entt::entity>>;
 
-            auto &meshComponent =
-                registry.get<Components::Mesh>(meshNodeEntity);
+        const char *getNodeName(entt::registry &registry, entt::entity entity) {
+            if (auto *node = registry.try_get<Components::Node>(entity)) {
+                return node->name.c_str();
+            }
+            if (auto *mesh = registry.try_get<Components::Mesh>(entity)) {
+                return mesh->name.c_str();
+            }
+            return "Entity";
+        }
 
+        // Children are only listed when a map is given, flat lists skip them.
+        void renderNode(entt::registry &registry, const entt::entity &nodeEntity,
+                        const ChildrenMap *children) {
             ImGuiTreeNodeFlags nodeFlags =
                 ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_DefaultOpen;
 
-            if (registry.all_of<Components::Tags::SelectedNode>(
-                    meshNodeEntity)) {
+            if (registry.all_of<Components::Tags::SelectedNode>(nodeEntity)) {
                 nodeFlags |= ImGuiTreeNodeFlags_Selected;
             }
 
             bool isOpened =
-                ImGui::TreeNodeEx((void *)(intptr_t)meshNodeEntity, nodeFlags,
-                                  "%s", meshComponent.name.c_str());
+                ImGui::TreeNodeEx((void *)(intptr_t)nodeEntity, nodeFlags, "%s",
+                                  getNodeName(registry, nodeEntity));
 
             if (ImGui::IsItemClicked()) {
                 auto selectedNodeView =
@@ -73,15 +94,23 @@ namespace Prism::UI {
                         selectedNodeEntity);
                 }
 
-                registry.emplace<Components::Tags::SelectedNode>(
-                    meshNodeEntity);
+                registry.emplace<Components::Tags::SelectedNode>(nodeEntity);
             }
 
             if (isOpened) {
-                renderTransformComponent(registry, meshNodeEntity);
+                renderTransformComponent(registry, nodeEntity);
 
                 // More components in the future...
 
+                if (children != nullptr) {
+                    if (auto it = children->find(nodeEntity);
+                        it != children->end()) {
+                        for (auto childEntity : it->second) {
+                            renderNode(registry, childEntity, children);
+                        }
+                    }
+                }
+
                 ImGui::TreePop();
             }
         }
@@ -92,12 +121,54 @@ namespace Prism::UI {
         : m_contextResources(contextResources) {};
 
     void SceneHierarchyUI::Update(float deltaTime, Resources::Scene &scene) {
+        PRISM_PROFILE_SCOPE("SceneHierarchyUI::Update");
+
         ImGui::Begin("Scene Hierarchy");
 
         auto &registry = scene.GetRegistry();
-        auto meshView = registry.view<Components::Mesh>();
-        for (const auto &meshEntity : meshView) {
-            renderMeshNode(registry, meshEntity);
+
+        // Listing every node of a large scene is slow, spatial index narrows
+        // it down to what the camera sees.
+        ImGui::Checkbox("Only in view", &m_onlyInView);
+
+        auto activeCameraView =
+            registry.view<Components::Tags::ActiveCamera>();
+        if (m_onlyInView && !activeCameraView.empty() &&
+            registry.all_of<Components::Camera>(activeCameraView.front())) {
+            auto &camera =
+                registry.get<Components::Camera>(activeCameraView.front());
+
+            m_visibleEntities.clear();
+            scene.GetSpatialIndex().QueryFrustum(
+                Utils::Culling::ExtractFrustum(camera.projection *
+                                               camera.view),
+                m_visibleEntities);
+
+            for (const auto &meshEntity : m_visibleEntities) {
+                renderNode(registry, meshEntity, nullptr);
+            }
+        } else {
+            ChildrenMap children;
+            std::vector<entt::entity> roots;
+
+            auto nodeView = registry.view<Components::Node>();
+            for (auto nodeEntity : nodeView) {
+                auto parent = nodeView.get<Components::Node>(nodeEntity).parent;
+                if (registry.valid(parent)) {
+                    children[parent].push_back(nodeEntity);
+                } else {
+                    roots.push_back(nodeEntity);
+                }
+            }
+
+            // Meshes added without a hierarchy.
+            auto meshView =
+                registry.view<Components::Mesh>(entt::exclude<Components::Node>);
+            roots.insert(roots.end(), meshView.begin(), meshView.end());
+
+            for (auto rootEntity : roots) {
+                renderNode(registry, rootEntity, &children);
+            }
         }
 
         ImGui::End();
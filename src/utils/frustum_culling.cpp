@@ -0,0 +1,282 @@
+#include "utils/frustum_culling.hpp"
+#include "utils/benchmark.hpp"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define PRISM_CULLING_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PRISM_CULLING_SSE
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define PRISM_CULLING_NEON
+#endif
+
+namespace Prism::Utils::Culling {
+    namespace {
+        struct PlaneLanes {
+            float normalX, normalY, normalZ, distance;
+            float absNormalX, absNormalY, absNormalZ;
+        };
+
+        std::array<PlaneLanes, 6> getPlaneLanes(const Frustum &frustum) {
+            std::array<PlaneLanes, 6> lanes{};
+            for (size_t i = 0; i < frustum.planes.size(); i++) {
+                const auto &plane = frustum.planes[i];
+                lanes[i] = PlaneLanes{plane.x, plane.y, plane.z, plane.w, std::abs(plane.x), std::abs(plane.y), std::abs(plane.z)};
+            }
+            return lanes;
+        }
+
+        // Box is outside when its projected radius can't reach the inner side of any plane.
+        void cullBoxesScalar(const std::array<PlaneLanes, 6> &planes, const BoxBatch &batch, uint8_t *visibility, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                bool visible = true;
+                for (const auto &plane : planes) {
+                    float distance = plane.normalX * batch.centerX[i] + plane.normalY * batch.centerY[i] + plane.normalZ * batch.centerZ[i] + plane.distance;
+                    float radius = plane.absNormalX * batch.extentX[i] + plane.absNormalY * batch.extentY[i] + plane.absNormalZ * batch.extentZ[i];
+                    visible = visible && distance + radius >= 0.0f;
+                }
+                visibility[i] = visible ? 1 : 0;
+            }
+        }
+
+#if defined(PRISM_CULLING_AVX)
+        constexpr size_t SIMD_WIDTH = 8;
+
+        void cullBoxesSimd(const std::array<PlaneLanes, 6> &planes, const BoxBatch &batch, uint8_t *visibility, size_t count) {
+            for (size_t i = 0; i < count; i += SIMD_WIDTH) {
+                __m256 centerX = _mm256_loadu_ps(batch.centerX.data() + i);
+                __m256 centerY = _mm256_loadu_ps(batch.centerY.data() + i);
+                __m256 centerZ = _mm256_loadu_ps(batch.centerZ.data() + i);
+                __m256 extentX = _mm256_loadu_ps(batch.extentX.data() + i);
+                __m256 extentY = _mm256_loadu_ps(batch.extentY.data() + i);
+                __m256 extentZ = _mm256_loadu_ps(batch.extentZ.data() + i);
+
+                __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+                for (const auto &plane : planes) {
+                    __m256 distance = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.normalX), centerX), _mm256_mul_ps(_mm256_set1_ps(plane.normalY), centerY));
+                    distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(plane.normalZ), centerZ));
+                    distance = _mm256_add_ps(distance, _mm256_set1_ps(plane.distance));
+                    __m256 radius = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.absNormalX), extentX),
+                                                                _mm256_mul_ps(_mm256_set1_ps(plane.absNormalY), extentY)),
+                                                  _mm256_mul_ps(_mm256_set1_ps(plane.absNormalZ), extentZ));
+                    inside = _mm256_and_ps(inside, _mm256_cmp_ps(_mm256_add_ps(distance, radius), _mm256_setzero_ps(), _CMP_GE_OQ));
+                }
+
+                int mask = _mm256_movemask_ps(inside);
+                for (size_t lane = 0; lane < SIMD_WIDTH; lane++) {
+                    visibility[i + lane] = static_cast<uint8_t>((mask >> lane) & 1);
+                }
+            }
+        }
+#elif defined(PRISM_CULLING_SSE)
+        constexpr size_t SIMD_WIDTH = 4;
+
+        void cullBoxesSimd(const std::array<PlaneLanes, 6> &planes, const BoxBatch &batch, uint8_t *visibility, size_t count) {
+            for (size_t i = 0; i < count; i += SIMD_WIDTH) {
+                __m128 centerX = _mm_loadu_ps(batch.centerX.data() + i);
+                __m128 centerY = _mm_loadu_ps(batch.centerY.data() + i);
+                __m128 centerZ = _mm_loadu_ps(batch.centerZ.data() + i);
+                __m128 extentX = _mm_loadu_ps(batch.extentX.data() + i);
+                __m128 extentY = _mm_loadu_ps(batch.extentY.data() + i);
+                __m128 extentZ = _mm_loadu_ps(batch.extentZ.data() + i);
+
+                __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+                for (const auto &plane : planes) {
+                    __m128 distance = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.normalX), centerX), _mm_mul_ps(_mm_set1_ps(plane.normalY), centerY));
+                    distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(plane.normalZ), centerZ));
+                    distance = _mm_add_ps(distance, _mm_set1_ps(plane.distance));
+                    __m128 radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.absNormalX), extentX), _mm_mul_ps(_mm_set1_ps(plane.absNormalY), extentY)),
+                                               _mm_mul_ps(_mm_set1_ps(plane.absNormalZ), extentZ));
+                    inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(distance, radius), _mm_setzero_ps()));
+                }
+
+                int mask = _mm_movemask_ps(inside);
+                for (size_t lane = 0; lane < SIMD_WIDTH; lane++) {
+                    visibility[i + lane] = static_cast<uint8_t>((mask >> lane) & 1);
+                }
+            }
+        }
+#elif defined(PRISM_CULLING_NEON)
+        constexpr size_t SIMD_WIDTH = 4;
+
+        void cullBoxesSimd(const std::array<PlaneLanes, 6> &planes, const BoxBatch &batch, uint8_t *visibility, size_t count) {
+            for (size_t i = 0; i < count; i += SIMD_WIDTH) {
+                float32x4_t centerX = vld1q_f32(batch.centerX.data() + i);
+                float32x4_t centerY = vld1q_f32(batch.centerY.data() + i);
+                float32x4_t centerZ = vld1q_f32(batch.centerZ.data() + i);
+                float32x4_t extentX = vld1q_f32(batch.extentX.data() + i);
+                float32x4_t extentY = vld1q_f32(batch.extentY.data() + i);
+                float32x4_t extentZ = vld1q_f32(batch.extentZ.data() + i);
+
+                uint32x4_t inside = vdupq_n_u32(0xFFFFFFFFu);
+                for (const auto &plane : planes) {
+                    // Same order of operations as the scalar version, so both produce identical results.
+                    float32x4_t distance = vmulq_n_f32(centerX, plane.normalX);
+                    distance = vmlaq_n_f32(distance, centerY, plane.normalY);
+                    distance = vmlaq_n_f32(distance, centerZ, plane.normalZ);
+                    distance = vaddq_f32(distance, vdupq_n_f32(plane.distance));
+
+                    float32x4_t radius = vmulq_n_f32(extentX, plane.absNormalX);
+                    radius = vmlaq_n_f32(radius, extentY, plane.absNormalY);
+                    radius = vmlaq_n_f32(radius, extentZ, plane.absNormalZ);
+
+                    inside = vandq_u32(inside, vcgeq_f32(vaddq_f32(distance, radius), vdupq_n_f32(0.0f)));
+                }
+
+                uint32_t lanes[SIMD_WIDTH];
+                vst1q_u32(lanes, inside);
+                for (size_t lane = 0; lane < SIMD_WIDTH; lane++) {
+                    visibility[i + lane] = static_cast<uint8_t>(lanes[lane] & 1);
+                }
+            }
+        }
+#endif
+    } // namespace
+
+    Frustum ExtractFrustum(const glm::mat4 &viewProjection) {
+        // Gribb-Hartmann - planes are sums & differences of the fourth row with the other rows.
+        const glm::vec4 row0 = glm::vec4(viewProjection[0][0], viewProjection[1][0], viewProjection[2][0], viewProjection[3][0]);
+        const glm::vec4 row1 = glm::vec4(viewProjection[0][1], viewProjection[1][1], viewProjection[2][1], viewProjection[3][1]);
+        const glm::vec4 row2 = glm::vec4(viewProjection[0][2], viewProjection[1][2], viewProjection[2][2], viewProjection[3][2]);
+        const glm::vec4 row3 = glm::vec4(viewProjection[0][3], viewProjection[1][3], viewProjection[2][3], viewProjection[3][3]);
+
+        Frustum frustum{};
+        frustum.planes = {row3 + row0, row3 - row0, row3 + row1, row3 - row1, row3 + row2, row3 - row2};
+
+        for (auto &plane : frustum.planes) {
+            plane /= glm::length(glm::vec3(plane));
+        }
+
+        return frustum;
+    }
+
+    void BoxBatch::Clear() {
+        centerX.clear();
+        centerY.clear();
+        centerZ.clear();
+        extentX.clear();
+        extentY.clear();
+        extentZ.clear();
+    }
+
+    void BoxBatch::Reserve(size_t count) {
+        centerX.reserve(count);
+        centerY.reserve(count);
+        centerZ.reserve(count);
+        extentX.reserve(count);
+        extentY.reserve(count);
+        extentZ.reserve(count);
+    }
+
+    void BoxBatch::PushTransformed(const glm::mat4 &model, const glm::vec3 &min, const glm::vec3 &max) {
+        glm::vec3 center = (min + max) * 0.5f;
+        glm::vec3 extent = (max - min) * 0.5f;
+
+        // Arvo - extent of transformed box is the extent multiplied by absolute values of the rotation & scale part.
+        glm::vec3 worldCenter = glm::vec3(model * glm::vec4(center, 1.0f));
+        glm::vec3 worldExtent = glm::abs(glm::vec3(model[0])) * extent.x + glm::abs(glm::vec3(model[1])) * extent.y + glm::abs(glm::vec3(model[2])) * extent.z;
+
+        Push(worldCenter, worldExtent);
+    }
+
+    void BoxBatch::Push(const glm::vec3 &center, const glm::vec3 &extent) {
+        centerX.push_back(center.x);
+        centerY.push_back(center.y);
+        centerZ.push_back(center.z);
+        extentX.push_back(extent.x);
+        extentY.push_back(extent.y);
+        extentZ.push_back(extent.z);
+    }
+
+    bool IntersectsBox(const Frustum &frustum, const glm::vec3 &center, const glm::vec3 &extent) {
+        for (const auto &plane : frustum.planes) {
+            float distance = glm::dot(glm::vec3(plane), center) + plane.w;
+            float radius = glm::dot(glm::abs(glm::vec3(plane)), extent);
+            if (distance + radius < 0.0f) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void CullBoxes(const Frustum &frustum, const BoxBatch &batch, uint8_t *visibility) {
+        const auto planes = getPlaneLanes(frustum);
+        const size_t count = batch.Size();
+
+#if defined(PRISM_CULLING_AVX) || defined(PRISM_CULLING_SSE) || defined(PRISM_CULLING_NEON)
+        const size_t simdCount = count - count % SIMD_WIDTH;
+        cullBoxesSimd(planes, batch, visibility, simdCount);
+        cullBoxesScalar(planes, batch, visibility, simdCount, count);
+#else
+        cullBoxesScalar(planes, batch, visibility, 0, count);
+#endif
+    }
+
+    void CullBoxesScalar(const Frustum &frustum, const BoxBatch &batch, uint8_t *visibility) {
+        cullBoxesScalar(getPlaneLanes(frustum), batch, visibility, 0, batch.Size());
+    }
+
+    const char *GetSimdBackendName() {
+#if defined(PRISM_CULLING_AVX)
+        return "AVX";
+#elif defined(PRISM_CULLING_SSE)
+        return "SSE";
+#elif defined(PRISM_CULLING_NEON)
+        return "NEON";
+#else
+        return "scalar";
+#endif
+    }
+
+    bool RunCullingBenchmark(size_t entityCount) {
+        constexpr size_t ITERATIONS = 200;
+
+        // Boxes scattered around the camera, so roughly a fifth of them ends up visible.
+        std::mt19937 random(1234);
+        std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+        std::uniform_real_distribution<float> size(0.5f, 5.0f);
+        std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+
+        BoxBatch batch{};
+        batch.Reserve(entityCount);
+        for (size_t i = 0; i < entityCount; i++) {
+            glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(position(random), position(random), position(random)));
+            model = glm::rotate(model, angle(random), glm::normalize(glm::vec3(position(random), position(random), position(random)) + glm::vec3(0.001f)));
+
+            glm::vec3 halfSize(size(random));
+            batch.PushTransformed(model, -halfSize, halfSize);
+        }
+
+        glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 400.0f);
+        Frustum frustum = ExtractFrustum(projection * view);
+
+        std::vector<uint8_t> scalarVisibility(entityCount);
+        std::vector<uint8_t> simdVisibility(entityCount);
+
+        double scalarMs = Benchmark::MeasureMs(ITERATIONS, [&]() { CullBoxesScalar(frustum, batch, scalarVisibility.data()); });
+        double simdMs = Benchmark::MeasureMs(ITERATIONS, [&]() { CullBoxes(frustum, batch, simdVisibility.data()); });
+
+        size_t visibleCount = std::count(simdVisibility.begin(), simdVisibility.end(), uint8_t{1});
+        bool matches = scalarVisibility == simdVisibility;
+
+        std::cout << "[BENCHMARK] Frustum culling of " << entityCount << " boxes, " << ITERATIONS << " iterations" << std::endl;
+        std::cout << "  visible:         " << visibleCount << std::endl;
+        std::cout << "  scalar:          " << scalarMs << " ms" << std::endl;
+        std::cout << "  " << GetSimdBackendName() << ":" << std::string(16 - std::string(GetSimdBackendName()).size(), ' ') << simdMs << " ms ("
+                  << (simdMs > 0.0 ? scalarMs / simdMs : 0.0) << "x)" << std::endl;
+        std::cout << "  results match:   " << (matches ? "yes" : "NO") << std::endl;
+
+        return matches;
+    }
+} // namespace Prism::Utils::Culling
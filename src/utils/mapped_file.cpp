@@ -0,0 +1,128 @@
+#include "utils/mapped_file.hpp"
+
+#include <utility>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Prism::Utils {
+#if defined(_WIN32)
+    std::optional<MappedFile> MappedFile::Open(const std::string &path) {
+        HANDLE fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (fileHandle == INVALID_HANDLE_VALUE) {
+            return std::nullopt;
+        }
+
+        MappedFile file{};
+        file.m_fileHandle = fileHandle;
+
+        LARGE_INTEGER size{};
+        if (!GetFileSizeEx(fileHandle, &size)) {
+            return std::nullopt;
+        }
+
+        // Empty files can't be mapped, they are valid with no data.
+        if (size.QuadPart == 0) {
+            return file;
+        }
+
+        file.m_mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (file.m_mappingHandle == nullptr) {
+            return std::nullopt;
+        }
+
+        void *data = MapViewOfFile(file.m_mappingHandle, FILE_MAP_READ, 0, 0, 0);
+        if (data == nullptr) {
+            return std::nullopt;
+        }
+
+        file.m_data = static_cast<const std::byte *>(data);
+        file.m_size = static_cast<size_t>(size.QuadPart);
+
+        return file;
+    }
+
+    MappedFile::~MappedFile() {
+        if (m_data != nullptr) {
+            UnmapViewOfFile(m_data);
+        }
+        if (m_mappingHandle != nullptr) {
+            CloseHandle(m_mappingHandle);
+        }
+        if (m_fileHandle != nullptr) {
+            CloseHandle(m_fileHandle);
+        }
+    }
+#else
+    std::optional<MappedFile> MappedFile::Open(const std::string &path) {
+        int fileDescriptor = open(path.c_str(), O_RDONLY);
+        if (fileDescriptor < 0) {
+            return std::nullopt;
+        }
+
+        struct stat fileStat{};
+        if (fstat(fileDescriptor, &fileStat) != 0) {
+            close(fileDescriptor);
+            return std::nullopt;
+        }
+
+        MappedFile file{};
+
+        // Empty files can't be mapped, they are valid with no data.
+        if (fileStat.st_size == 0) {
+            close(fileDescriptor);
+            return file;
+        }
+
+        void *data = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+
+        // Mapping stays valid after the descriptor is closed.
+        close(fileDescriptor);
+
+        if (data == MAP_FAILED) {
+            return std::nullopt;
+        }
+
+        // Whole file is usually read front to back - copied into the staging buffer or hashed.
+        madvise(data, static_cast<size_t>(fileStat.st_size), MADV_SEQUENTIAL);
+
+        file.m_data = static_cast<const std::byte *>(data);
+        file.m_size = static_cast<size_t>(fileStat.st_size);
+
+        return file;
+    }
+
+    MappedFile::~MappedFile() {
+        if (m_data != nullptr) {
+            munmap(const_cast<std::byte *>(m_data), m_size);
+        }
+    }
+#endif
+
+    MappedFile::MappedFile(MappedFile &&other) noexcept { swap(*this, other); }
+
+    MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+        if (this != &other) {
+            swap(*this, other);
+        }
+        return *this;
+    }
+
+    void swap(MappedFile &first, MappedFile &second) noexcept {
+        using std::swap;
+        swap(first.m_data, second.m_data);
+        swap(first.m_size, second.m_size);
+#if defined(_WIN32)
+        swap(first.m_fileHandle, second.m_fileHandle);
+        swap(first.m_mappingHandle, second.m_mappingHandle);
+#endif
+    }
+} // namespace Prism::Utils
@@ -0,0 +1,19 @@
+#include "utils/mesh_adjacency.hpp"
+
+namespace Prism::Utils::MeshAdjacency {
+    void BuildAdjacency(size_t vertexCount, const std::vector<uint32_t> &indices, std::vector<uint32_t> &offsets, std::vector<uint32_t> &triangles) {
+        offsets.assign(vertexCount + 1, 0);
+        for (auto index : indices) {
+            offsets[index + 1]++;
+        }
+        for (size_t i = 0; i < vertexCount; i++) {
+            offsets[i + 1] += offsets[i];
+        }
+
+        std::vector<uint32_t> cursors(offsets.begin(), offsets.end() - 1);
+        triangles.resize(indices.size());
+        for (size_t i = 0; i < indices.size(); i++) {
+            triangles[cursors[indices[i]]++] = static_cast<uint32_t>(i / 3);
+        }
+    }
+} // namespace Prism::Utils::MeshAdjacency
@@ -0,0 +1,288 @@
+#include "utils/mesh_optimization.hpp"
+#include "utils/mesh_adjacency.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace Prism::Utils::MeshOptimization {
+    namespace {
+        // Vertex is cached when fewer than cacheSize misses happened since it was transformed. Timestamps start past the
+        // cache size, so zero initialized vertices always miss.
+        struct FifoCache {
+            std::vector<uint32_t> timestamps;
+            uint32_t time;
+            uint32_t cacheSize;
+
+            FifoCache(size_t vertexCount, uint32_t cacheSize) : timestamps(vertexCount, 0), time(cacheSize + 1), cacheSize(cacheSize) {}
+
+            bool Contains(uint32_t vertex) const { return time - timestamps[vertex] <= cacheSize; }
+
+            // Returns true on a miss.
+            bool Access(uint32_t vertex) {
+                if (Contains(vertex)) {
+                    return false;
+                }
+
+                timestamps[vertex] = time++;
+                return true;
+            }
+
+            void Reset() {
+                // Pushing time past every timestamp empties the cache without touching all of them.
+                time += cacheSize + 1;
+            }
+        };
+
+        struct Cluster {
+            size_t begin;
+            size_t end;
+            float sortKey;
+        };
+
+        // Clusters end wherever the cache is effectively flushed - a triangle missing all of its vertices.
+        std::vector<size_t> findHardBoundaries(const std::vector<uint32_t> &indices, size_t vertexCount, uint32_t cacheSize) {
+            std::vector<size_t> boundaries;
+            FifoCache cache(vertexCount, cacheSize);
+
+            for (size_t i = 0; i < indices.size(); i += 3) {
+                int misses = cache.Access(indices[i + 0]) + cache.Access(indices[i + 1]) + cache.Access(indices[i + 2]);
+                if (misses == 3) {
+                    boundaries.push_back(i);
+                }
+            }
+
+            if (boundaries.empty() || boundaries.front() != 0) {
+                boundaries.insert(boundaries.begin(), 0);
+            }
+
+            return boundaries;
+        }
+
+        // Splits every hard cluster as soon as the part so far is as cache efficient as threshold times the whole cluster.
+        std::vector<Cluster> findSoftBoundaries(const std::vector<uint32_t> &indices, size_t vertexCount, const std::vector<size_t> &hardBoundaries,
+                                                float threshold, uint32_t cacheSize) {
+            std::vector<Cluster> clusters;
+            FifoCache cache(vertexCount, cacheSize);
+
+            for (size_t hard = 0; hard < hardBoundaries.size(); hard++) {
+                size_t begin = hardBoundaries[hard];
+                size_t end = hard + 1 < hardBoundaries.size() ? hardBoundaries[hard + 1] : indices.size();
+
+                cache.Reset();
+                size_t clusterMisses = 0;
+                for (size_t i = begin; i < end; i++) {
+                    clusterMisses += cache.Access(indices[i]);
+                }
+                float clusterThreshold = threshold * static_cast<float>(clusterMisses) / static_cast<float>((end - begin) / 3);
+
+                cache.Reset();
+                size_t softBegin = begin;
+                size_t misses = 0;
+                for (size_t i = begin; i < end; i += 3) {
+                    misses += cache.Access(indices[i + 0]) + cache.Access(indices[i + 1]) + cache.Access(indices[i + 2]);
+
+                    float acmr = static_cast<float>(misses) / static_cast<float>((i + 3 - softBegin) / 3);
+                    if (acmr <= clusterThreshold && i + 3 < end) {
+                        clusters.push_back({softBegin, i + 3, 0.0f});
+                        softBegin = i + 3;
+                        misses = 0;
+                        cache.Reset();
+                    }
+                }
+
+                if (softBegin < end) {
+                    clusters.push_back({softBegin, end, 0.0f});
+                }
+            }
+
+            return clusters;
+        }
+    } // namespace
+
+    VertexCacheStatistics AnalyzeVertexCache(const std::vector<uint32_t> &indices, size_t vertexCount, uint32_t cacheSize) {
+        VertexCacheStatistics statistics{};
+        if (indices.empty()) {
+            return statistics;
+        }
+
+        FifoCache cache(vertexCount, cacheSize);
+        std::vector<bool> referenced(vertexCount, false);
+
+        size_t misses = 0;
+        size_t referencedCount = 0;
+        for (auto index : indices) {
+            misses += cache.Access(index);
+            if (!referenced[index]) {
+                referenced[index] = true;
+                referencedCount++;
+            }
+        }
+
+        statistics.acmr = static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+        statistics.atvr = static_cast<float>(misses) / static_cast<float>(referencedCount);
+        return statistics;
+    }
+
+    std::vector<uint32_t> OptimizeVertexCache(const std::vector<uint32_t> &indices, size_t vertexCount, uint32_t cacheSize) {
+        std::vector<uint32_t> result;
+        result.reserve(indices.size());
+        if (indices.empty()) {
+            return result;
+        }
+
+        std::vector<uint32_t> adjacencyOffsets;
+        std::vector<uint32_t> adjacentTriangles;
+        MeshAdjacency::BuildAdjacency(vertexCount, indices, adjacencyOffsets, adjacentTriangles);
+
+        // Triangles not emitted yet, per vertex.
+        std::vector<uint32_t> liveTriangles(vertexCount);
+        for (size_t vertex = 0; vertex < vertexCount; vertex++) {
+            liveTriangles[vertex] = adjacencyOffsets[vertex + 1] - adjacencyOffsets[vertex];
+        }
+
+        std::vector<bool> emitted(indices.size() / 3, false);
+        FifoCache cache(vertexCount, cacheSize);
+
+        // Recently used vertices, to continue from when the fanning vertex runs out of triangles.
+        std::vector<uint32_t> deadEndStack;
+        std::vector<uint32_t> candidates;
+        size_t nextVertexCursor = 0;
+
+        auto skipDeadEnd = [&]() -> int64_t {
+            while (!deadEndStack.empty()) {
+                uint32_t vertex = deadEndStack.back();
+                deadEndStack.pop_back();
+                if (liveTriangles[vertex] > 0) {
+                    return vertex;
+                }
+            }
+
+            for (; nextVertexCursor < vertexCount; nextVertexCursor++) {
+                if (liveTriangles[nextVertexCursor] > 0) {
+                    return static_cast<int64_t>(nextVertexCursor);
+                }
+            }
+
+            return -1;
+        };
+
+        int64_t fanningVertex = indices[0];
+        while (fanningVertex >= 0) {
+            candidates.clear();
+
+            for (uint32_t i = adjacencyOffsets[fanningVertex]; i < adjacencyOffsets[fanningVertex + 1]; i++) {
+                uint32_t triangle = adjacentTriangles[i];
+                if (emitted[triangle]) {
+                    continue;
+                }
+
+                for (size_t corner = 0; corner < 3; corner++) {
+                    uint32_t vertex = indices[triangle * 3 + corner];
+                    result.push_back(vertex);
+                    deadEndStack.push_back(vertex);
+                    candidates.push_back(vertex);
+                    liveTriangles[vertex]--;
+                    cache.Access(vertex);
+                }
+                emitted[triangle] = true;
+            }
+
+            // Prefer the candidate that stays in cache longest, but only if its remaining triangles still fit before it is evicted.
+            int64_t bestVertex = -1;
+            int64_t bestPriority = -1;
+            for (auto vertex : candidates) {
+                if (liveTriangles[vertex] == 0) {
+                    continue;
+                }
+
+                int64_t priority = 0;
+                int64_t age = cache.time - cache.timestamps[vertex];
+                if (age + 2 * static_cast<int64_t>(liveTriangles[vertex]) <= cacheSize) {
+                    priority = age;
+                }
+
+                if (priority > bestPriority) {
+                    bestPriority = priority;
+                    bestVertex = vertex;
+                }
+            }
+
+            fanningVertex = bestVertex >= 0 ? bestVertex : skipDeadEnd();
+        }
+
+        return result;
+    }
+
+    std::vector<uint32_t> OptimizeOverdraw(const std::vector<glm::vec3> &positions, const std::vector<uint32_t> &indices, float threshold,
+                                           uint32_t cacheSize) {
+        if (indices.empty()) {
+            return {};
+        }
+
+        auto hardBoundaries = findHardBoundaries(indices, positions.size(), cacheSize);
+        auto clusters = findSoftBoundaries(indices, positions.size(), hardBoundaries, threshold, cacheSize);
+
+        // Area weighted centroid of the whole mesh.
+        glm::vec3 meshCentroid(0.0f);
+        float meshArea = 0.0f;
+        for (size_t i = 0; i < indices.size(); i += 3) {
+            const auto &p0 = positions[indices[i + 0]];
+            const auto &p1 = positions[indices[i + 1]];
+            const auto &p2 = positions[indices[i + 2]];
+
+            float area = glm::length(glm::cross(p1 - p0, p2 - p0));
+            meshCentroid += (p0 + p1 + p2) * (area / 3.0f);
+            meshArea += area;
+        }
+        meshCentroid /= std::max(meshArea, std::numeric_limits<float>::min());
+
+        // Clusters facing away from the center are likely to occlude the rest of the mesh, so they go first.
+        for (auto &cluster : clusters) {
+            glm::vec3 centroid(0.0f);
+            glm::vec3 normal(0.0f);
+            float area = 0.0f;
+
+            for (size_t i = cluster.begin; i < cluster.end; i += 3) {
+                const auto &p0 = positions[indices[i + 0]];
+                const auto &p1 = positions[indices[i + 1]];
+                const auto &p2 = positions[indices[i + 2]];
+
+                glm::vec3 weightedNormal = glm::cross(p1 - p0, p2 - p0);
+                float triangleArea = glm::length(weightedNormal);
+
+                centroid += (p0 + p1 + p2) * (triangleArea / 3.0f);
+                normal += weightedNormal;
+                area += triangleArea;
+            }
+
+            if (area > 0.0f && glm::length(normal) > 0.0f) {
+                centroid /= area;
+                cluster.sortKey = glm::dot(centroid - meshCentroid, glm::normalize(normal));
+            }
+        }
+
+        std::stable_sort(clusters.begin(), clusters.end(), [](const Cluster &lhs, const Cluster &rhs) { return lhs.sortKey > rhs.sortKey; });
+
+        std::vector<uint32_t> result;
+        result.reserve(indices.size());
+        for (const auto &cluster : clusters) {
+            result.insert(result.end(), indices.begin() + cluster.begin, indices.begin() + cluster.end);
+        }
+
+        return result;
+    }
+
+    std::vector<uint32_t> OptimizeVertexFetch(std::vector<uint32_t> &indices, size_t vertexCount) {
+        std::vector<uint32_t> remap(vertexCount, UNUSED_VERTEX);
+
+        uint32_t nextVertex = 0;
+        for (auto &index : indices) {
+            if (remap[index] == UNUSED_VERTEX) {
+                remap[index] = nextVertex++;
+            }
+            index = remap[index];
+        }
+
+        return remap;
+    }
+} // namespace Prism::Utils::MeshOptimization
@@ -0,0 +1,258 @@
+#include "utils/mesh_simplification.hpp"
+#include "utils/mesh_adjacency.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+
+namespace Prism::Utils::Simplification {
+    namespace {
+        // Symmetric 4x4 matrix of summed, area weighted plane equations.
+        struct Quadric {
+            double a00 = 0.0, a01 = 0.0, a02 = 0.0, a03 = 0.0;
+            double a11 = 0.0, a12 = 0.0, a13 = 0.0;
+            double a22 = 0.0, a23 = 0.0;
+            double a33 = 0.0;
+            double weight = 0.0;
+
+            Quadric &operator+=(const Quadric &other) {
+                a00 += other.a00, a01 += other.a01, a02 += other.a02, a03 += other.a03;
+                a11 += other.a11, a12 += other.a12, a13 += other.a13;
+                a22 += other.a22, a23 += other.a23;
+                a33 += other.a33;
+                weight += other.weight;
+                return *this;
+            }
+        };
+
+        struct Collapse {
+            uint32_t from;
+            uint32_t to;
+            // Squared distance.
+            double cost;
+        };
+
+        Quadric getPlaneQuadric(const glm::dvec3 &normal, double distance, double weight) {
+            Quadric quadric{};
+            quadric.a00 = normal.x * normal.x * weight;
+            quadric.a01 = normal.x * normal.y * weight;
+            quadric.a02 = normal.x * normal.z * weight;
+            quadric.a03 = normal.x * distance * weight;
+            quadric.a11 = normal.y * normal.y * weight;
+            quadric.a12 = normal.y * normal.z * weight;
+            quadric.a13 = normal.y * distance * weight;
+            quadric.a22 = normal.z * normal.z * weight;
+            quadric.a23 = normal.z * distance * weight;
+            quadric.a33 = distance * distance * weight;
+            quadric.weight = weight;
+            return quadric;
+        }
+
+        // Weighted average of squared distances from point to the planes of quadric.
+        double getError(const Quadric &quadric, const glm::vec3 &point) {
+            if (quadric.weight <= 0.0) {
+                return 0.0;
+            }
+
+            double x = point.x, y = point.y, z = point.z;
+            double error = quadric.a00 * x * x + 2.0 * quadric.a01 * x * y + 2.0 * quadric.a02 * x * z + 2.0 * quadric.a03 * x + quadric.a11 * y * y +
+                           2.0 * quadric.a12 * y * z + 2.0 * quadric.a13 * y + quadric.a22 * z * z + 2.0 * quadric.a23 * z + quadric.a33;
+
+            return std::abs(error) / quadric.weight;
+        }
+
+        uint64_t getEdgeKey(uint32_t a, uint32_t b) { return (static_cast<uint64_t>(std::min(a, b)) << 32) | std::max(a, b); }
+
+        std::vector<Quadric> computeQuadrics(const std::vector<glm::vec3> &positions, const std::vector<uint32_t> &indices) {
+            std::vector<Quadric> quadrics(positions.size());
+
+            for (size_t i = 0; i < indices.size(); i += 3) {
+                glm::dvec3 p0 = positions[indices[i + 0]];
+                glm::dvec3 p1 = positions[indices[i + 1]];
+                glm::dvec3 p2 = positions[indices[i + 2]];
+
+                glm::dvec3 normal = glm::cross(p1 - p0, p2 - p0);
+                double length = glm::length(normal);
+                if (length <= 0.0) {
+                    continue;
+                }
+                normal /= length;
+
+                // Twice the triangle area.
+                Quadric quadric = getPlaneQuadric(normal, -glm::dot(normal, p0), length);
+                for (size_t corner = 0; corner < 3; corner++) {
+                    quadrics[indices[i + corner]] += quadric;
+                }
+            }
+
+            return quadrics;
+        }
+
+        // Edges with a single triangle are borders or attribute seams, edges with more are non-manifold. Moving their
+        // vertices would open holes, so they stay where they are.
+        std::vector<bool> findLockedVertices(size_t vertexCount, const std::vector<uint32_t> &indices) {
+            std::unordered_map<uint64_t, uint32_t> edgeTriangleCounts;
+            edgeTriangleCounts.reserve(indices.size());
+
+            for (size_t i = 0; i < indices.size(); i += 3) {
+                for (size_t corner = 0; corner < 3; corner++) {
+                    edgeTriangleCounts[getEdgeKey(indices[i + corner], indices[i + (corner + 1) % 3])]++;
+                }
+            }
+
+            std::vector<bool> locked(vertexCount, false);
+            for (const auto &[edge, count] : edgeTriangleCounts) {
+                if (count != 2) {
+                    locked[static_cast<uint32_t>(edge >> 32)] = true;
+                    locked[static_cast<uint32_t>(edge & 0xFFFFFFFFu)] = true;
+                }
+            }
+
+            return locked;
+        }
+
+        // Checks that no triangle around from turns over once from is moved to to. Returns number of triangles the collapse removes, or -1.
+        int validateCollapse(const std::vector<glm::vec3> &positions, const std::vector<uint32_t> &indices, const std::vector<uint32_t> &offsets,
+                             const std::vector<uint32_t> &triangles, uint32_t from, uint32_t to) {
+            int removedTriangles = 0;
+
+            for (uint32_t i = offsets[from]; i < offsets[from + 1]; i++) {
+                const uint32_t *triangle = &indices[triangles[i] * 3];
+                if (triangle[0] == to || triangle[1] == to || triangle[2] == to) {
+                    removedTriangles++;
+                    continue;
+                }
+
+                glm::vec3 corners[3] = {positions[triangle[0]], positions[triangle[1]], positions[triangle[2]]};
+                glm::vec3 normal = glm::cross(corners[1] - corners[0], corners[2] - corners[0]);
+
+                for (size_t corner = 0; corner < 3; corner++) {
+                    if (triangle[corner] == from) {
+                        corners[corner] = positions[to];
+                    }
+                }
+                glm::vec3 collapsedNormal = glm::cross(corners[1] - corners[0], corners[2] - corners[0]);
+
+                if (glm::dot(normal, collapsedNormal) <= 0.0f) {
+                    return -1;
+                }
+            }
+
+            return removedTriangles;
+        }
+    } // namespace
+
+    std::vector<uint32_t> SimplifyIndices(const std::vector<glm::vec3> &positions, const std::vector<uint32_t> &indices, size_t targetIndexCount,
+                                          float *error) {
+        std::vector<uint32_t> result = indices;
+        double maxCost = 0.0;
+
+        auto quadrics = computeQuadrics(positions, result);
+        auto locked = findLockedVertices(positions.size(), result);
+
+        std::vector<uint32_t> adjacencyOffsets;
+        std::vector<uint32_t> adjacentTriangles;
+        std::vector<Collapse> collapses;
+        std::vector<uint32_t> remap(positions.size());
+        std::vector<bool> touched(positions.size());
+
+        // Every pass collapses an independent set of the cheapest edges, neighbourhoods of moved vertices are frozen until the next pass.
+        while (result.size() > targetIndexCount) {
+            MeshAdjacency::BuildAdjacency(positions.size(), result, adjacencyOffsets, adjacentTriangles);
+
+            collapses.clear();
+            for (size_t i = 0; i < result.size(); i += 3) {
+                for (size_t corner = 0; corner < 3; corner++) {
+                    uint32_t a = result[i + corner];
+                    uint32_t b = result[i + (corner + 1) % 3];
+
+                    // Interior edges are shared by two triangles in opposite directions, so each is visited once.
+                    if (a > b) {
+                        continue;
+                    }
+
+                    Quadric quadric = quadrics[a];
+                    quadric += quadrics[b];
+
+                    Collapse collapse{.from = a, .to = b, .cost = std::numeric_limits<double>::max()};
+                    if (!locked[a]) {
+                        collapse.cost = getError(quadric, positions[b]);
+                    }
+                    if (!locked[b]) {
+                        double cost = getError(quadric, positions[a]);
+                        if (cost < collapse.cost) {
+                            collapse = {.from = b, .to = a, .cost = cost};
+                        }
+                    }
+
+                    if (collapse.cost != std::numeric_limits<double>::max()) {
+                        collapses.push_back(collapse);
+                    }
+                }
+            }
+
+            std::sort(collapses.begin(), collapses.end(), [](const Collapse &lhs, const Collapse &rhs) { return lhs.cost < rhs.cost; });
+
+            for (uint32_t i = 0; i < remap.size(); i++) {
+                remap[i] = i;
+            }
+            std::fill(touched.begin(), touched.end(), false);
+
+            const size_t trianglesToRemove = (result.size() - targetIndexCount + 2) / 3;
+            size_t removedTriangles = 0;
+            size_t appliedCollapses = 0;
+
+            for (const auto &collapse : collapses) {
+                if (removedTriangles >= trianglesToRemove) {
+                    break;
+                }
+
+                if (touched[collapse.from] || touched[collapse.to]) {
+                    continue;
+                }
+
+                int collapseRemovedTriangles = validateCollapse(positions, result, adjacencyOffsets, adjacentTriangles, collapse.from, collapse.to);
+                if (collapseRemovedTriangles < 0) {
+                    continue;
+                }
+
+                remap[collapse.from] = collapse.to;
+                quadrics[collapse.to] += quadrics[collapse.from];
+                maxCost = std::max(maxCost, collapse.cost);
+
+                for (uint32_t j = adjacencyOffsets[collapse.from]; j < adjacencyOffsets[collapse.from + 1]; j++) {
+                    const uint32_t *triangle = &result[adjacentTriangles[j] * 3];
+                    touched[triangle[0]] = touched[triangle[1]] = touched[triangle[2]] = true;
+                }
+
+                removedTriangles += collapseRemovedTriangles;
+                appliedCollapses++;
+            }
+
+            if (appliedCollapses == 0) {
+                break;
+            }
+
+            size_t writeIndex = 0;
+            for (size_t i = 0; i < result.size(); i += 3) {
+                uint32_t a = remap[result[i + 0]];
+                uint32_t b = remap[result[i + 1]];
+                uint32_t c = remap[result[i + 2]];
+
+                if (a != b && b != c && c != a) {
+                    result[writeIndex++] = a;
+                    result[writeIndex++] = b;
+                    result[writeIndex++] = c;
+                }
+            }
+            result.resize(writeIndex);
+        }
+
+        if (error != nullptr) {
+            *error = static_cast<float>(std::sqrt(maxCost));
+        }
+
+        return result;
+    }
+} // namespace Prism::Utils::Simplification
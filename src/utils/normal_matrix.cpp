@@ -0,0 +1,257 @@
+#include "utils/normal_matrix.hpp"
+#include "utils/benchmark.hpp"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// 8 wide AVX wouldn't pay off - matrices have to be transposed into lanes, which is where most of the time goes.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PRISM_NORMAL_MATRIX_SSE
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define PRISM_NORMAL_MATRIX_NEON
+#endif
+
+namespace Prism::Utils::NormalMatrices {
+    namespace {
+        // Columns of the inverse transpose are cross products of the other two columns divided by the determinant.
+        void computeNormalMatricesScalar(const glm::mat4 *models, NormalMatrix *normalMatrices, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                const glm::vec3 column0 = glm::vec3(models[i][0]);
+                const glm::vec3 column1 = glm::vec3(models[i][1]);
+                const glm::vec3 column2 = glm::vec3(models[i][2]);
+
+                const glm::vec3 cross12 = glm::cross(column1, column2);
+                const glm::vec3 cross20 = glm::cross(column2, column0);
+                const glm::vec3 cross01 = glm::cross(column0, column1);
+
+                const float determinant = glm::dot(column0, cross12);
+                const float inverseDeterminant = determinant != 0.0f ? 1.0f / determinant : 1.0f;
+
+                normalMatrices[i][0] = glm::vec4(cross12 * inverseDeterminant, 0.0f);
+                normalMatrices[i][1] = glm::vec4(cross20 * inverseDeterminant, 0.0f);
+                normalMatrices[i][2] = glm::vec4(cross01 * inverseDeterminant, 0.0f);
+            }
+        }
+
+#if defined(PRISM_NORMAL_MATRIX_SSE)
+        constexpr size_t SIMD_WIDTH = 4;
+
+        struct Lanes {
+            __m128 x, y, z;
+        };
+
+        // Same column of 4 consecutive matrices, one matrix per lane.
+        Lanes loadColumn(const glm::mat4 *models, int column) {
+            __m128 row0 = _mm_loadu_ps(&models[0][column][0]);
+            __m128 row1 = _mm_loadu_ps(&models[1][column][0]);
+            __m128 row2 = _mm_loadu_ps(&models[2][column][0]);
+            __m128 row3 = _mm_loadu_ps(&models[3][column][0]);
+            _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+            return {row0, row1, row2};
+        }
+
+        void storeColumn(NormalMatrix *normalMatrices, int column, const Lanes &lanes) {
+            __m128 row0 = lanes.x;
+            __m128 row1 = lanes.y;
+            __m128 row2 = lanes.z;
+            __m128 row3 = _mm_setzero_ps();
+            _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+            _mm_storeu_ps(&normalMatrices[0][column][0], row0);
+            _mm_storeu_ps(&normalMatrices[1][column][0], row1);
+            _mm_storeu_ps(&normalMatrices[2][column][0], row2);
+            _mm_storeu_ps(&normalMatrices[3][column][0], row3);
+        }
+
+        Lanes cross(const Lanes &lhs, const Lanes &rhs) {
+            return {_mm_sub_ps(_mm_mul_ps(lhs.y, rhs.z), _mm_mul_ps(lhs.z, rhs.y)), _mm_sub_ps(_mm_mul_ps(lhs.z, rhs.x), _mm_mul_ps(lhs.x, rhs.z)),
+                    _mm_sub_ps(_mm_mul_ps(lhs.x, rhs.y), _mm_mul_ps(lhs.y, rhs.x))};
+        }
+
+        Lanes scale(const Lanes &lanes, __m128 factor) { return {_mm_mul_ps(lanes.x, factor), _mm_mul_ps(lanes.y, factor), _mm_mul_ps(lanes.z, factor)}; }
+
+        void computeNormalMatricesSimd(const glm::mat4 *models, NormalMatrix *normalMatrices, size_t count) {
+            const __m128 one = _mm_set1_ps(1.0f);
+
+            for (size_t i = 0; i < count; i += SIMD_WIDTH) {
+                Lanes column0 = loadColumn(models + i, 0);
+                Lanes column1 = loadColumn(models + i, 1);
+                Lanes column2 = loadColumn(models + i, 2);
+
+                Lanes cross12 = cross(column1, column2);
+                Lanes cross20 = cross(column2, column0);
+                Lanes cross01 = cross(column0, column1);
+
+                __m128 determinant =
+                    _mm_add_ps(_mm_add_ps(_mm_mul_ps(column0.x, cross12.x), _mm_mul_ps(column0.y, cross12.y)), _mm_mul_ps(column0.z, cross12.z));
+
+                // Lanes with zero determinant are divided by one instead.
+                __m128 singular = _mm_cmpeq_ps(determinant, _mm_setzero_ps());
+                determinant = _mm_or_ps(_mm_andnot_ps(singular, determinant), _mm_and_ps(singular, one));
+                __m128 inverseDeterminant = _mm_div_ps(one, determinant);
+
+                storeColumn(normalMatrices + i, 0, scale(cross12, inverseDeterminant));
+                storeColumn(normalMatrices + i, 1, scale(cross20, inverseDeterminant));
+                storeColumn(normalMatrices + i, 2, scale(cross01, inverseDeterminant));
+            }
+        }
+#elif defined(PRISM_NORMAL_MATRIX_NEON)
+        constexpr size_t SIMD_WIDTH = 4;
+
+        struct Lanes {
+            float32x4_t x, y, z;
+        };
+
+        // Structure load de-interleaves x, y, z & w of 4 consecutive columns, whose stride is a whole matrix here - so they're gathered first.
+        Lanes loadColumn(const glm::mat4 *models, int column) {
+            float gathered[16];
+            for (int matrix = 0; matrix < 4; matrix++) {
+                vst1q_f32(gathered + matrix * 4, vld1q_f32(&models[matrix][column][0]));
+            }
+
+            float32x4x4_t lanes = vld4q_f32(gathered);
+            return {lanes.val[0], lanes.val[1], lanes.val[2]};
+        }
+
+        void storeColumn(NormalMatrix *normalMatrices, int column, const Lanes &lanes) {
+            float32x4x4_t interleaved = {lanes.x, lanes.y, lanes.z, vdupq_n_f32(0.0f)};
+
+            float scattered[16];
+            vst4q_f32(scattered, interleaved);
+            for (int matrix = 0; matrix < 4; matrix++) {
+                vst1q_f32(&normalMatrices[matrix][column][0], vld1q_f32(scattered + matrix * 4));
+            }
+        }
+
+        Lanes cross(const Lanes &lhs, const Lanes &rhs) {
+            return {vmlsq_f32(vmulq_f32(lhs.y, rhs.z), lhs.z, rhs.y), vmlsq_f32(vmulq_f32(lhs.z, rhs.x), lhs.x, rhs.z),
+                    vmlsq_f32(vmulq_f32(lhs.x, rhs.y), lhs.y, rhs.x)};
+        }
+
+        Lanes scale(const Lanes &lanes, float32x4_t factor) { return {vmulq_f32(lanes.x, factor), vmulq_f32(lanes.y, factor), vmulq_f32(lanes.z, factor)}; }
+
+        void computeNormalMatricesSimd(const glm::mat4 *models, NormalMatrix *normalMatrices, size_t count) {
+            const float32x4_t one = vdupq_n_f32(1.0f);
+
+            for (size_t i = 0; i < count; i += SIMD_WIDTH) {
+                Lanes column0 = loadColumn(models + i, 0);
+                Lanes column1 = loadColumn(models + i, 1);
+                Lanes column2 = loadColumn(models + i, 2);
+
+                Lanes cross12 = cross(column1, column2);
+                Lanes cross20 = cross(column2, column0);
+                Lanes cross01 = cross(column0, column1);
+
+                float32x4_t determinant = vmulq_f32(column0.x, cross12.x);
+                determinant = vmlaq_f32(determinant, column0.y, cross12.y);
+                determinant = vmlaq_f32(determinant, column0.z, cross12.z);
+
+                // Lanes with zero determinant are divided by one instead.
+                determinant = vbslq_f32(vceqq_f32(determinant, vdupq_n_f32(0.0f)), one, determinant);
+
+                // Reciprocal estimate refined by two Newton-Raphson steps, close enough to a division for normals.
+                float32x4_t inverseDeterminant = vrecpeq_f32(determinant);
+                inverseDeterminant = vmulq_f32(vrecpsq_f32(determinant, inverseDeterminant), inverseDeterminant);
+                inverseDeterminant = vmulq_f32(vrecpsq_f32(determinant, inverseDeterminant), inverseDeterminant);
+
+                storeColumn(normalMatrices + i, 0, scale(cross12, inverseDeterminant));
+                storeColumn(normalMatrices + i, 1, scale(cross20, inverseDeterminant));
+                storeColumn(normalMatrices + i, 2, scale(cross01, inverseDeterminant));
+            }
+        }
+#endif
+
+        float getLargestDifference(const std::vector<NormalMatrix> &lhs, const std::vector<NormalMatrix> &rhs) {
+            float difference = 0.0f;
+            for (size_t i = 0; i < lhs.size(); i++) {
+                for (int column = 0; column < 3; column++) {
+                    glm::vec4 columnDifference = glm::abs(lhs[i][column] - rhs[i][column]);
+                    difference = std::max({difference, columnDifference.x, columnDifference.y, columnDifference.z, columnDifference.w});
+                }
+            }
+            return difference;
+        }
+    } // namespace
+
+    NormalMatrix ComputeNormalMatrix(const glm::mat4 &model) {
+        NormalMatrix normalMatrix{};
+        computeNormalMatricesScalar(&model, &normalMatrix, 0, 1);
+        return normalMatrix;
+    }
+
+    void ComputeNormalMatrices(const glm::mat4 *models, NormalMatrix *normalMatrices, size_t count) {
+#if defined(PRISM_NORMAL_MATRIX_SSE) || defined(PRISM_NORMAL_MATRIX_NEON)
+        const size_t simdCount = count - count % SIMD_WIDTH;
+        computeNormalMatricesSimd(models, normalMatrices, simdCount);
+        computeNormalMatricesScalar(models, normalMatrices, simdCount, count);
+#else
+        computeNormalMatricesScalar(models, normalMatrices, 0, count);
+#endif
+    }
+
+    void ComputeNormalMatricesScalar(const glm::mat4 *models, NormalMatrix *normalMatrices, size_t count) {
+        computeNormalMatricesScalar(models, normalMatrices, 0, count);
+    }
+
+    const char *GetSimdBackendName() {
+#if defined(PRISM_NORMAL_MATRIX_SSE)
+        return "SSE";
+#elif defined(PRISM_NORMAL_MATRIX_NEON)
+        return "NEON";
+#else
+        return "scalar";
+#endif
+    }
+
+    bool RunNormalMatrixBenchmark(size_t entityCount) {
+        constexpr size_t ITERATIONS = 200;
+        // Relative to unit scale, transforms are generated with scales between 0.5 and 2.
+        constexpr float TOLERANCE = 1e-4f;
+
+        std::mt19937 random(1234);
+        std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+        std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+        std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+
+        std::vector<glm::mat4> models(entityCount);
+        for (auto &model : models) {
+            model = glm::translate(glm::mat4(1.0f), glm::vec3(position(random), position(random), position(random)));
+            model = glm::rotate(model, angle(random), glm::normalize(glm::vec3(position(random), position(random), position(random)) + glm::vec3(0.001f)));
+            model = glm::scale(model, glm::vec3(scale(random), scale(random), scale(random)));
+        }
+
+        std::vector<NormalMatrix> inverseNormalMatrices(entityCount);
+        std::vector<NormalMatrix> scalarNormalMatrices(entityCount);
+        std::vector<NormalMatrix> simdNormalMatrices(entityCount);
+
+        double inverseMs = Benchmark::MeasureMs(ITERATIONS, [&]() {
+            for (size_t i = 0; i < entityCount; i++) {
+                glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(models[i])));
+                inverseNormalMatrices[i] = NormalMatrix(glm::vec4(normalMatrix[0], 0.0f), glm::vec4(normalMatrix[1], 0.0f), glm::vec4(normalMatrix[2], 0.0f));
+            }
+        });
+        double scalarMs = Benchmark::MeasureMs(ITERATIONS, [&]() { ComputeNormalMatricesScalar(models.data(), scalarNormalMatrices.data(), entityCount); });
+        double simdMs = Benchmark::MeasureMs(ITERATIONS, [&]() { ComputeNormalMatrices(models.data(), simdNormalMatrices.data(), entityCount); });
+
+        float scalarDifference = getLargestDifference(inverseNormalMatrices, scalarNormalMatrices);
+        float simdDifference = getLargestDifference(inverseNormalMatrices, simdNormalMatrices);
+        bool matches = scalarDifference <= TOLERANCE && simdDifference <= TOLERANCE;
+
+        std::cout << "[BENCHMARK] Normal matrices of " << entityCount << " transforms, " << ITERATIONS << " iterations" << std::endl;
+        std::cout << "  inverse:         " << inverseMs << " ms" << std::endl;
+        std::cout << "  scalar:          " << scalarMs << " ms (" << (scalarMs > 0.0 ? inverseMs / scalarMs : 0.0) << "x)" << std::endl;
+        std::cout << "  " << GetSimdBackendName() << ":" << std::string(16 - std::string(GetSimdBackendName()).size(), ' ') << simdMs << " ms ("
+                  << (simdMs > 0.0 ? inverseMs / simdMs : 0.0) << "x)" << std::endl;
+        std::cout << "  max difference:  " << std::max(scalarDifference, simdDifference) << std::endl;
+        std::cout << "  results match:   " << (matches ? "yes" : "NO") << std::endl;
+
+        return matches;
+    }
+} // namespace Prism::Utils::NormalMatrices
@@ -0,0 +1,193 @@
+#include "utils/profiler.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Prism::Utils::Profiler {
+    namespace {
+        // 64k zones per thread is enough for a few thousand frames of the main loop.
+        constexpr uint32_t EVENTS_PER_THREAD = 1u << 16;
+
+        struct ZoneEvent {
+            const char *name;
+            uint64_t startNs;
+            uint64_t endNs;
+        };
+
+        // Written only by the owning thread, read by the exporting one.
+        struct ThreadBuffer {
+            std::unique_ptr<ZoneEvent[]> events = std::make_unique<ZoneEvent[]>(EVENTS_PER_THREAD);
+            std::atomic<uint32_t> count = 0;
+            std::atomic<uint32_t> generation = 0;
+
+            uint32_t threadId = 0;
+            std::string threadName; // Guarded by registry mutex.
+        };
+
+        // Buffers are never released, so events of finished threads are still exported.
+        struct BufferRegistry {
+            std::mutex mutex;
+            std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+        };
+
+        std::atomic<bool> s_capturing = false;
+        std::atomic<uint32_t> s_captureGeneration = 0;
+        std::atomic<uint64_t> s_captureStartNs = 0;
+        std::atomic<uint64_t> s_droppedEvents = 0;
+
+        BufferRegistry &getRegistry() {
+            static BufferRegistry registry;
+            return registry;
+        }
+
+        ThreadBuffer *registerThreadBuffer() {
+            auto &registry = getRegistry();
+            std::lock_guard lock(registry.mutex);
+
+            auto buffer = std::make_unique<ThreadBuffer>();
+            buffer->threadId = static_cast<uint32_t>(registry.buffers.size());
+            buffer->threadName = "Thread " + std::to_string(buffer->threadId);
+
+            registry.buffers.push_back(std::move(buffer));
+            return registry.buffers.back().get();
+        }
+
+        ThreadBuffer &getThreadBuffer() {
+            thread_local ThreadBuffer *buffer = registerThreadBuffer();
+            return *buffer;
+        }
+
+        uint64_t nowNs() {
+            return static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+        void recordZone(const char *name, uint64_t startNs, uint64_t endNs) {
+            auto &buffer = getThreadBuffer();
+
+            // Lazily drop events of the previous capture - only the owning thread ever resets its buffer.
+            uint32_t generation = s_captureGeneration.load(std::memory_order_relaxed);
+            if (buffer.generation.load(std::memory_order_relaxed) != generation) {
+                buffer.count.store(0, std::memory_order_relaxed);
+                buffer.generation.store(generation, std::memory_order_release);
+            }
+
+            uint32_t index = buffer.count.load(std::memory_order_relaxed);
+            if (index >= EVENTS_PER_THREAD) {
+                s_droppedEvents.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            buffer.events[index] = ZoneEvent{.name = name, .startNs = startNs, .endNs = endNs};
+            buffer.count.store(index + 1, std::memory_order_release);
+        }
+
+        void writeEscaped(std::ofstream &file, const char *text) {
+            for (const char *c = text; *c != '\0'; c++) {
+                if (*c == '"' || *c == '\\') {
+                    file << '\\';
+                }
+                file << *c;
+            }
+        }
+    } // namespace
+
+    void BeginCapture() {
+        s_droppedEvents.store(0, std::memory_order_relaxed);
+        s_captureStartNs.store(nowNs(), std::memory_order_relaxed);
+        s_captureGeneration.fetch_add(1, std::memory_order_relaxed);
+        s_capturing.store(true, std::memory_order_release);
+    }
+
+    void EndCapture() { s_capturing.store(false, std::memory_order_release); }
+
+    bool IsCapturing() { return s_capturing.load(std::memory_order_relaxed); }
+
+    uint64_t GetDroppedEventCount() { return s_droppedEvents.load(std::memory_order_relaxed); }
+
+    void SetThreadName(const char *name) {
+        auto &buffer = getThreadBuffer();
+
+        std::lock_guard lock(getRegistry().mutex);
+        buffer.threadName = name;
+    }
+
+    bool WriteChromeTrace(const std::string &path) {
+        std::ofstream file(path, std::ios::trunc);
+        if (!file.good()) {
+            return false;
+        }
+
+        const uint32_t generation = s_captureGeneration.load(std::memory_order_relaxed);
+        const uint64_t captureStartNs = s_captureStartNs.load(std::memory_order_relaxed);
+
+        file << std::fixed << std::setprecision(3);
+        file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+        bool first = true;
+        auto separator = [&]() {
+            if (!first) {
+                file << ",\n";
+            }
+            first = false;
+        };
+
+        auto &registry = getRegistry();
+        std::lock_guard lock(registry.mutex);
+
+        for (const auto &buffer : registry.buffers) {
+            separator();
+            file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadId << ",\"args\":{\"name\":\"";
+            writeEscaped(file, buffer->threadName.c_str());
+            file << "\"}}";
+
+            if (buffer->generation.load(std::memory_order_acquire) != generation) {
+                continue;
+            }
+
+            uint32_t count = buffer->count.load(std::memory_order_acquire);
+            for (uint32_t i = 0; i < count; i++) {
+                const auto &event = buffer->events[i];
+                if (event.startNs < captureStartNs) {
+                    continue;
+                }
+
+                // Chrome trace format expects microseconds.
+                double timestampUs = static_cast<double>(event.startNs - captureStartNs) / 1000.0;
+                double durationUs = static_cast<double>(event.endNs - event.startNs) / 1000.0;
+
+                separator();
+                file << "{\"name\":\"";
+                writeEscaped(file, event.name);
+                file << "\",\"cat\":\"cpu\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadId << ",\"ts\":" << timestampUs
+                     << ",\"dur\":" << durationUs << "}";
+            }
+        }
+
+        file << "]}\n";
+
+        return file.good();
+    }
+
+    ScopedZone::ScopedZone(const char *name) {
+        if (!s_capturing.load(std::memory_order_relaxed)) {
+            return;
+        }
+
+        m_name = name;
+        m_startNs = nowNs();
+    }
+
+    ScopedZone::~ScopedZone() {
+        if (m_name == nullptr) {
+            return;
+        }
+
+        recordZone(m_name, m_startNs, nowNs());
+    }
+} // namespace Prism::Utils::Profiler
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+namespace Prism::Utils::Benchmark {
+    // Average wall time of a single call in milliseconds, over iterations back to back calls.
+    template <typename Function> double MeasureMs(size_t iterations, Function &&function) {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; i++) {
+            function();
+        }
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count() / static_cast<double>(iterations);
+    }
+} // namespace Prism::Utils::Benchmark
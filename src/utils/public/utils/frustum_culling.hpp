@@ -0,0 +1,54 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Batch frustum culling of axis aligned boxes. Boxes are stored as structure of arrays, so a single SIMD
+// register holds the same component of 4 (SSE, NEON) or 8 (AVX) consecutive boxes.
+
+namespace Prism::Utils::Culling {
+    // Planes point inwards, point p is inside when dot(plane.xyz, p) + plane.w >= 0.
+    struct Frustum {
+        std::array<glm::vec4, 6> planes = {};
+    };
+
+    // Expects OpenGL clip space depth range, which is what glm::perspective produces.
+    Frustum ExtractFrustum(const glm::mat4 &viewProjection);
+
+    struct BoxBatch {
+        std::vector<float> centerX = {};
+        std::vector<float> centerY = {};
+        std::vector<float> centerZ = {};
+        std::vector<float> extentX = {};
+        std::vector<float> extentY = {};
+        std::vector<float> extentZ = {};
+
+        void Clear();
+        void Reserve(size_t count);
+
+        // Transforms object space box into a world space box enclosing it.
+        void PushTransformed(const glm::mat4 &model, const glm::vec3 &min, const glm::vec3 &max);
+        void Push(const glm::vec3 &center, const glm::vec3 &extent);
+
+        size_t Size() const { return centerX.size(); }
+    };
+
+    // Single box test, for hierarchical culling where boxes aren't known up front.
+    bool IntersectsBox(const Frustum &frustum, const glm::vec3 &center, const glm::vec3 &extent);
+
+    // Writes 1 into visibility of boxes intersecting the frustum and 0 for the rest. Visibility has to hold batch.Size() elements.
+    void CullBoxes(const Frustum &frustum, const BoxBatch &batch, uint8_t *visibility);
+
+    // Reference implementation, used for remainders of SIMD batches and benchmarking.
+    void CullBoxesScalar(const Frustum &frustum, const BoxBatch &batch, uint8_t *visibility);
+
+    // Name of instruction set CullBoxes was compiled for.
+    const char *GetSimdBackendName();
+
+    // Culls entityCount random boxes with both implementations and prints timings. Returns false when results differ.
+    bool RunCullingBenchmark(size_t entityCount);
+} // namespace Prism::Utils::Culling
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string>
+
+// Read-only memory mapping of a whole file. Pages are read in by the OS on first access, so only parts that are touched
+// cost any IO and nothing is copied into a user space buffer.
+
+namespace Prism::Utils {
+    class MappedFile {
+      public:
+        // Returns nullopt when the file doesn't exist or can't be mapped.
+        static std::optional<MappedFile> Open(const std::string &path);
+
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        MappedFile(MappedFile &&other) noexcept;
+        MappedFile &operator=(MappedFile &&other) noexcept;
+
+        std::span<const std::byte> GetData() const { return {m_data, m_size}; }
+
+        friend void swap(MappedFile &first, MappedFile &second) noexcept;
+
+      private:
+        const std::byte *m_data = nullptr;
+        size_t m_size = 0;
+
+#if defined(_WIN32)
+        void *m_fileHandle = nullptr;
+        void *m_mappingHandle = nullptr;
+#endif
+    };
+} // namespace Prism::Utils
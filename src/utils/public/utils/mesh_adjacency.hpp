@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Vertex to triangle adjacency of indexed triangle lists, shared by mesh simplification and optimization.
+
+namespace Prism::Utils::MeshAdjacency {
+    // Triangles around every vertex, stored as offsets into a single list - triangles of vertex v are
+    // triangles[offsets[v]] up to triangles[offsets[v + 1]]. Both vectors are reused, so they can be kept between calls.
+    void BuildAdjacency(size_t vertexCount, const std::vector<uint32_t> &indices, std::vector<uint32_t> &offsets, std::vector<uint32_t> &triangles);
+} // namespace Prism::Utils::MeshAdjacency
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Reorders indexed triangle lists for the GPU - triangles for post-transform vertex cache reuse and lower overdraw, vertices
+// for sequential fetches. None of the passes changes what is rendered.
+
+namespace Prism::Utils::MeshOptimization {
+    // Most GPUs behave close to a FIFO cache of this size.
+    constexpr uint32_t DEFAULT_CACHE_SIZE = 16;
+
+    // Vertices that are invalid after OptimizeVertexFetch, because no index references them.
+    constexpr uint32_t UNUSED_VERTEX = UINT32_MAX;
+
+    struct VertexCacheStatistics {
+        // Average cache miss ratio - transformed vertices per triangle, 0.5 is the limit for large regular meshes.
+        float acmr = 0.0f;
+        // Average transform to vertex ratio - transformed vertices per referenced vertex, 1.0 is ideal.
+        float atvr = 0.0f;
+    };
+
+    VertexCacheStatistics AnalyzeVertexCache(const std::vector<uint32_t> &indices, size_t vertexCount, uint32_t cacheSize = DEFAULT_CACHE_SIZE);
+
+    // Tipsify (Sander et al. 2007), linear time triangle reordering for a FIFO cache of cacheSize.
+    std::vector<uint32_t> OptimizeVertexCache(const std::vector<uint32_t> &indices, size_t vertexCount, uint32_t cacheSize = DEFAULT_CACHE_SIZE);
+
+    // Splits cache optimized indices into clusters and draws those facing outwards first. Clusters are split further as long as
+    // ACMR stays within threshold times the original, so 1.05 trades at most 5% of cache efficiency for less overdraw.
+    std::vector<uint32_t> OptimizeOverdraw(const std::vector<glm::vec3> &positions, const std::vector<uint32_t> &indices, float threshold = 1.05f,
+                                           uint32_t cacheSize = DEFAULT_CACHE_SIZE);
+
+    // Numbers vertices in order of their first use and rewrites indices accordingly. Returns new index of every old vertex.
+    std::vector<uint32_t> OptimizeVertexFetch(std::vector<uint32_t> &indices, size_t vertexCount);
+} // namespace Prism::Utils::MeshOptimization
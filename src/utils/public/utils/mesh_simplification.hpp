@@ -0,0 +1,17 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Quadric error metric simplification of indexed triangle lists. Edges are collapsed onto one of their vertices, so
+// simplified index lists keep referencing the original vertex buffer and every level of detail can share it.
+
+namespace Prism::Utils::Simplification {
+    // Reduces indices towards targetIndexCount. Border & seam vertices are never moved, so the result can stop above the target.
+    // Error receives the largest distance, in units of positions, a collapse moved the surface by.
+    std::vector<uint32_t> SimplifyIndices(const std::vector<glm::vec3> &positions, const std::vector<uint32_t> &indices, size_t targetIndexCount,
+                                          float *error = nullptr);
+} // namespace Prism::Utils::Simplification
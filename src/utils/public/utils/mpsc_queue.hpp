@@ -0,0 +1,60 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+#include <vector>
+
+// Unbounded lock-free multi producer, single consumer queue. Producers push onto an intrusive stack with a CAS, the consumer takes
+// the whole stack with one exchange - nodes are never popped one by one, so there is no ABA problem.
+
+namespace Prism::Utils {
+    template <typename T> class MpscQueue {
+      public:
+        MpscQueue() = default;
+
+        ~MpscQueue() {
+            Node *node = m_head.exchange(nullptr, std::memory_order_acquire);
+            while (node != nullptr) {
+                delete std::exchange(node, node->next);
+            }
+        }
+
+        MpscQueue(const MpscQueue &) = delete;
+        MpscQueue &operator=(const MpscQueue &) = delete;
+
+        MpscQueue(MpscQueue &&) = delete;
+        MpscQueue &operator=(MpscQueue &&) = delete;
+
+        // Safe to call from any number of threads.
+        void Push(T value) {
+            Node *node = new Node{std::move(value), m_head.load(std::memory_order_relaxed)};
+            while (!m_head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {
+            }
+        }
+
+        // Only from the consumer thread. Items come out in the order they were pushed.
+        std::vector<T> PopAll() {
+            Node *node = m_head.exchange(nullptr, std::memory_order_acquire);
+
+            std::vector<T> items;
+            while (node != nullptr) {
+                items.push_back(std::move(node->value));
+                delete std::exchange(node, node->next);
+            }
+
+            std::reverse(items.begin(), items.end());
+            return items;
+        }
+
+        bool IsEmpty() const { return m_head.load(std::memory_order_relaxed) == nullptr; }
+
+      private:
+        struct Node {
+            T value;
+            Node *next = nullptr;
+        };
+
+        std::atomic<Node *> m_head = nullptr;
+    };
+} // namespace Prism::Utils
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+
+// Normal matrices of model matrices, computed on the CPU once per instance instead of inverting the model matrix for
+// every vertex. Batches are computed 4 matrices at a time with SSE or NEON, one matrix element per SIMD lane.
+
+namespace Prism::Utils::NormalMatrices {
+    // Inverse transpose of the upper 3x3 of model matrix. Columns are padded to 4 floats, which is the std430 layout of a mat3.
+    using NormalMatrix = glm::mat3x4;
+
+    // Singular matrices map normals with their cofactor matrix instead, which keeps the direction of whatever survives.
+    NormalMatrix ComputeNormalMatrix(const glm::mat4 &model);
+
+    void ComputeNormalMatrices(const glm::mat4 *models, NormalMatrix *normalMatrices, size_t count);
+
+    // Same cross product formula one matrix at a time. ComputeNormalMatrices uses it for the last count % 4 matrices, or for all
+    // of them when neither SSE nor NEON is available.
+    void ComputeNormalMatricesScalar(const glm::mat4 *models, NormalMatrix *normalMatrices, size_t count);
+
+    // "SSE", "NEON" or "scalar" - whichever path ComputeNormalMatrices uses for its batches of 4 in this build.
+    const char *GetSimdBackendName();
+
+    // Computes normal matrices of entityCount random transforms with both implementations and compares them against inverting
+    // every matrix, the way basic.vert used to per vertex. Returns false when results differ.
+    bool RunNormalMatrixBenchmark(size_t entityCount);
+} // namespace Prism::Utils::NormalMatrices
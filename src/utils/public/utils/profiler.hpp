@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// Scoped CPU profiler. Zones are recorded into per-thread buffers (single writer, no locks on the hot path)
+// and can be exported in Chrome trace-event format - open the file in chrome://tracing or ui.perfetto.dev.
+//
+// When PRISM_PROFILER_ENABLED is not defined every macro expands to nothing.
+
+namespace Prism::Utils::Profiler {
+    // Starts a new capture, events recorded by previous one are discarded.
+    void BeginCapture();
+
+    void EndCapture();
+
+    bool IsCapturing();
+
+    // Writes all events recorded during the last capture. Should be called after EndCapture.
+    bool WriteChromeTrace(const std::string &path);
+
+    // Name displayed for the calling thread in the trace viewer.
+    void SetThreadName(const char *name);
+
+    // Zones recorded by the last capture after the buffer of their thread was full, they are missing from the trace.
+    uint64_t GetDroppedEventCount();
+
+    // Name has to outlive the capture - string literals are expected.
+    class ScopedZone {
+      public:
+        explicit ScopedZone(const char *name);
+        ~ScopedZone();
+
+        ScopedZone(const ScopedZone &) = delete;
+        ScopedZone &operator=(const ScopedZone &) = delete;
+
+        ScopedZone(ScopedZone &&) = delete;
+        ScopedZone &operator=(ScopedZone &&) = delete;
+
+      private:
+        const char *m_name = nullptr;
+        uint64_t m_startNs = 0;
+    };
+} // namespace Prism::Utils::Profiler
+
+#ifdef PRISM_PROFILER_ENABLED
+#define PRISM_PROFILE_CONCAT_IMPL(a, b) a##b
+#define PRISM_PROFILE_CONCAT(a, b) PRISM_PROFILE_CONCAT_IMPL(a, b)
+
+#define PRISM_PROFILE_SCOPE(name) ::Prism::Utils::Profiler::ScopedZone PRISM_PROFILE_CONCAT(prismProfileZone, __LINE__)(name)
+#define PRISM_PROFILE_THREAD_NAME(name) ::Prism::Utils::Profiler::SetThreadName(name)
+#else
+#define PRISM_PROFILE_SCOPE(name)
+#define PRISM_PROFILE_THREAD_NAME(name)
+#endif
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+
+// Conversions between floats and the normalized integer & half float formats vertex attributes are fetched in.
+// Rounding matches what Vulkan does when it converts attributes back to floats.
+
+namespace Prism::Utils::Quantization {
+    // Value in [0, 1], read back by VK_FORMAT_*_UNORM attributes.
+    uint16_t QuantizeUnorm16(float value);
+    float DequantizeUnorm16(uint16_t value);
+
+    // Value in [-1, 1], read back by VK_FORMAT_*_SNORM attributes.
+    int16_t QuantizeSnorm16(float value);
+    float DequantizeSnorm16(int16_t value);
+
+    // IEEE 754 half float, read back by VK_FORMAT_*_SFLOAT attributes with 16 bit components.
+    uint16_t QuantizeHalf(float value);
+    float DequantizeHalf(uint16_t value);
+
+    // Maps unit vector onto an octahedron unfolded into [-1, 1]^2 (Cigolle et al. 2014), two components keep
+    // error of a normal nearly uniform over the whole sphere.
+    glm::vec2 EncodeOctahedral(const glm::vec3 &normal);
+    glm::vec3 DecodeOctahedral(const glm::vec2 &encoded);
+} // namespace Prism::Utils::Quantization
@@ -8,6 +8,8 @@ namespace Prism::Utils::Vulkan::Common {
     struct QueueFamilyIndices {
         std::optional<uint32_t> graphicsFamily;
         std::optional<uint32_t> presentFamily;
+        // Optional family that can only transfer, usually backed by DMA engines that copy without taking time from rendering.
+        std::optional<uint32_t> transferFamily;
 
         bool isComplete() const { return graphicsFamily.has_value() && presentFamily.has_value(); }
     };
@@ -15,4 +17,11 @@ namespace Prism::Utils::Vulkan::Common {
     QueueFamilyIndices findQueueFamilies(VkSurfaceKHR surface, VkPhysicalDevice device);
 
     VkShaderModule loadShaderModule(VkDevice device, const char *spvPath);
+
+    // Starts at 0, throws when it can't be created.
+    VkSemaphore createTimelineSemaphore(VkDevice device);
+
+    // Alignment for ranges of a shared host visible buffer, valid both as uniform & storage offsets. Ranges start at a non coherent
+    // atom too, so flushing one never touches memory of its neighbours.
+    VkDeviceSize getBufferOffsetAlignment(VkPhysicalDevice physicalDevice);
 } // namespace Prism::Utils::Vulkan::Common
\ No newline at end of file
@@ -0,0 +1,52 @@
+#include "utils/vertex_quantization.hpp"
+
+#include <glm/gtc/packing.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace Prism::Utils::Quantization {
+    namespace {
+        // Keeps the sign of zero components positive, so both halves of folded octahedron map consistently.
+        glm::vec2 signNotZero(const glm::vec2 &value) { return {value.x >= 0.0f ? 1.0f : -1.0f, value.y >= 0.0f ? 1.0f : -1.0f}; }
+    } // namespace
+
+    uint16_t QuantizeUnorm16(float value) { return static_cast<uint16_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 65535.0f)); }
+
+    float DequantizeUnorm16(uint16_t value) { return static_cast<float>(value) / 65535.0f; }
+
+    int16_t QuantizeSnorm16(float value) { return static_cast<int16_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * 32767.0f)); }
+
+    // Both -32768 and -32767 are -1.0.
+    float DequantizeSnorm16(int16_t value) { return std::max(static_cast<float>(value) / 32767.0f, -1.0f); }
+
+    uint16_t QuantizeHalf(float value) { return glm::packHalf1x16(value); }
+
+    float DequantizeHalf(uint16_t value) { return glm::unpackHalf1x16(value); }
+
+    glm::vec2 EncodeOctahedral(const glm::vec3 &normal) {
+        float length = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+        if (length <= 0.0f) {
+            return glm::vec2(0.0f);
+        }
+
+        glm::vec2 encoded = glm::vec2(normal) / length;
+        if (normal.z < 0.0f) {
+            // Lower hemisphere is folded over the diagonals.
+            encoded = (1.0f - glm::abs(glm::vec2(encoded.y, encoded.x))) * signNotZero(encoded);
+        }
+
+        return encoded;
+    }
+
+    glm::vec3 DecodeOctahedral(const glm::vec2 &encoded) {
+        glm::vec3 normal(encoded, 1.0f - std::abs(encoded.x) - std::abs(encoded.y));
+        if (normal.z < 0.0f) {
+            glm::vec2 unfolded = (1.0f - glm::abs(glm::vec2(normal.y, normal.x))) * signNotZero(glm::vec2(normal));
+            normal.x = unfolded.x;
+            normal.y = unfolded.y;
+        }
+
+        return glm::normalize(normal);
+    }
+} // namespace Prism::Utils::Quantization
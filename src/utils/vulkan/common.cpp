@@ -1,5 +1,6 @@
 #include "utils/vulkan/common.hpp"
 
+#include <algorithm>
 #include <fstream>
 
 namespace Prism::Utils::Vulkan::Common {
@@ -35,11 +36,18 @@ namespace Prism::Utils::Vulkan::Common {
                 indices.graphicsFamily = i;
             }
 
-            VkBool32 presentSupport = false;
-            vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface, &presentSupport);
-
-            if (presentSupport) {
-                indices.presentFamily = i;
+            // Without a surface (headless mode) nothing is presented, so graphics queue takes that role.
+            if (surface == VK_NULL_HANDLE) {
+                if (indices.graphicsFamily.has_value()) {
+                    indices.presentFamily = indices.graphicsFamily;
+                }
+            } else {
+                VkBool32 presentSupport = false;
+                vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface, &presentSupport);
+
+                if (presentSupport) {
+                    indices.presentFamily = i;
+                }
             }
 
             if (indices.isComplete()) {
@@ -49,6 +57,14 @@ namespace Prism::Utils::Vulkan::Common {
             i++;
         }
 
+        for (uint32_t family = 0; family < queueFamilyCount; family++) {
+            const auto flags = queueFamilies[family].queueFlags;
+            if ((flags & VK_QUEUE_TRANSFER_BIT) && !(flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT))) {
+                indices.transferFamily = family;
+                break;
+            }
+        }
+
         return indices;
     }
 
@@ -71,4 +87,30 @@ namespace Prism::Utils::Vulkan::Common {
         return module;
     }
 
-} // namespace Prism::Utils::Vulkan::Common
\ No newline at end of file
+    VkSemaphore createTimelineSemaphore(VkDevice device) {
+        VkSemaphoreTypeCreateInfo typeInfo{};
+        typeInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+        typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+        typeInfo.initialValue = 0;
+
+        VkSemaphoreCreateInfo semaphoreInfo{};
+        semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        semaphoreInfo.pNext = &typeInfo;
+
+        VkSemaphore semaphore = VK_NULL_HANDLE;
+        if (vkCreateSemaphore(device, &semaphoreInfo, nullptr, &semaphore) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create timeline semaphore!");
+        }
+
+        return semaphore;
+    }
+
+    VkDeviceSize getBufferOffsetAlignment(VkPhysicalDevice physicalDevice) {
+        VkPhysicalDeviceProperties properties;
+        vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+        // All limits are powers of two, so the largest one is a multiple of the others.
+        return std::max({properties.limits.minUniformBufferOffsetAlignment, properties.limits.minStorageBufferOffsetAlignment,
+                         properties.limits.nonCoherentAtomSize});
+    }
+} // namespace Prism::Utils::Vulkan::Common